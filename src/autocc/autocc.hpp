@@ -10,5 +10,19 @@
 #include "line.hpp"
 #include "generator.hpp"
 #include "operator.hpp"
+#include "spincases.hpp"
+
+namespace aquarius
+{
+namespace autocc
+{
+
+/*
+ * Check hand-written RHF and UHF diagrams against their spin-orbital forms
+ */
+int main(int argc, char **argv);
+
+}
+}
 
 #endif
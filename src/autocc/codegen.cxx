@@ -0,0 +1,362 @@
+#include "autocc.hpp"
+
+/*
+ * Stand-alone driver for autocc:
+ *
+ *   autocc generate <file>
+ *
+ *     Read spin-orbital tensor statements written as in the CC tasks, e.g.
+ *
+ *       Z(3)["abcijk"] += 0.5*WABEF["abef"]*T(3)["efcijk"];
+ *
+ *     and write the same code with every statement expanded into its
+ *     spin-integrated SymmetryBlockedTensor contractions, using the same
+ *     expansion as SpinorbitalTensor::mult and ::sum at run time. Virtual
+ *     indices are a-h and occupied indices i-p; the first half of the indices
+ *     of each tensor are upper and the second half lower, with the virtual
+ *     indices first in each half. Alpha indices are written in upper case.
+ *     Anything which is not such a statement is copied unchanged.
+ *
+ *   autocc check <file> [line]
+ *
+ *     Check hand-written RHF and UHF diagrams against their spin-orbital
+ *     forms (see autocc.cxx).
+ */
+
+using namespace aquarius;
+using namespace aquarius::autocc;
+
+namespace
+{
+
+const string VIRTUAL = "abcdefgh";
+const string OCCUPIED = "ijklmnop";
+
+/*
+ * Orbital space of an index: 0 for virtual and 1 for occupied, matching the
+ * {vrt,occ} spaces of the operators
+ */
+int space(char c)
+{
+    if (contains(VIRTUAL, c)) return 0;
+    if (contains(OCCUPIED, c)) return 1;
+    throw runtime_error(string("unknown index ") + c);
+}
+
+struct Operand
+{
+    string name;
+    string idx;
+    vector<int> nout, nin;
+
+    Operand(const string& name, const string& idx)
+    : name(name), idx(idx), nout(2, 0), nin(2, 0)
+    {
+        if (idx.size()%2 != 0)
+            throw runtime_error(name + " must have as many upper as lower indices");
+
+        int n = idx.size()/2;
+        for (int i = 0;i < idx.size();i++)
+        {
+            int s = space(idx[i]);
+            if (i%n > 0 && s < space(idx[i-1]))
+                throw runtime_error(name + " must list virtual indices before occupied ones");
+            (i < n ? nout : nin)[s]++;
+        }
+    }
+};
+
+/*
+ * Read a factor such as 2, 0.5, -1/4, or (1.0/36.0), where a missing
+ * magnitude (as in a bare "-") is 1
+ */
+Fraction parseFactor(string s)
+{
+    s.erase(std::remove_if(s.begin(), s.end(),
+                           [](char c) { return isspace(c) || c == '(' || c == ')'; }), s.end());
+    if (s.empty()) return Fraction(1);
+
+    Fraction f(1);
+    if (s[0] == '-')
+    {
+        f = Fraction(-1);
+        s = s.substr(1);
+    }
+
+    auto decimal = [&](const string& d)
+    {
+        if (d.empty()) return Fraction(1);
+
+        size_t dot = d.find('.');
+        if (dot == string::npos) return Fraction(std::stoi(d));
+
+        string digits = d.substr(0, dot) + d.substr(dot+1);
+        int den = 1;
+        for (int i = dot+1;i < d.size();i++) den *= 10;
+        return Fraction(std::stoi(digits), den);
+    };
+
+    size_t slash = s.find('/');
+    if (slash == string::npos) return f*decimal(s);
+    return f*decimal(s.substr(0, slash))/decimal(s.substr(slash+1));
+}
+
+string printFactor(const Fraction& f)
+{
+    if (f == 1) return "";
+
+    double d = f;
+    if (d*1024 == floor(d*1024))
+    {
+        ostringstream oss;
+        oss << d << "*";
+        return oss.str();
+    }
+
+    ostringstream oss;
+    oss << f;
+    string s = oss.str();
+    size_t slash = s.find('/');
+    return "(" + s.substr(0, slash) + ".0/" + s.substr(slash+1) + ".0)*";
+}
+
+/*
+ * Spin cases of a spin-conserving operand, as stored by SpinorbitalTensor
+ */
+vector<pair<vector<int>,vector<int>>> spinCases(const Operand& op)
+{
+    vector<pair<vector<int>,vector<int>>> cases;
+
+    for (int ao0 = 0;ao0 <= op.nout[0];ao0++)
+    for (int ao1 = 0;ao1 <= op.nout[1];ao1++)
+    for (int ai0 = 0;ai0 <= op.nin[0];ai0++)
+    for (int ai1 = 0;ai1 <= op.nin[1];ai1++)
+    {
+        if (ao0+ao1 != ai0+ai1) continue;
+        cases.emplace_back(vector<int>{ao0,ao1}, vector<int>{ai0,ai1});
+    }
+
+    return cases;
+}
+
+string caseName(const Operand& op, const vector<int>& alpha_out, const vector<int>& alpha_in)
+{
+    ostringstream oss;
+    oss << op.name << "({" << alpha_out[0] << "," << alpha_out[1] << "},{"
+                           << alpha_in[0] << "," << alpha_in[1] << "})";
+    return oss.str();
+}
+
+/*
+ * Labels for the lines of a term: external lines keep the label of their
+ * position in C, and internal lines get the next unused label of their
+ * space; alpha lines are in upper case
+ */
+class Labeller
+{
+    protected:
+        map<int,char> labels;
+        string used;
+
+    public:
+        Labeller(const vector<Line>& out_C, const vector<Line>& in_C, const string& idx_C)
+        : used(idx_C)
+        {
+            vector<Line> lines = out_C;
+            lines.insert(lines.end(), in_C.begin(), in_C.end());
+            for (int i = 0;i < lines.size();i++)
+                labels[lines[i].asInt()] = (lines[i].isAlpha() ? (char)std::toupper(idx_C[i]) : idx_C[i]);
+        }
+
+        string operator()(const vector<Line>& out, const vector<Line>& in)
+        {
+            vector<Line> lines = out;
+            lines.insert(lines.end(), in.begin(), in.end());
+
+            string s;
+            for (auto& l : lines)
+            {
+                if (labels.find(l.asInt()) == labels.end())
+                {
+                    const string& avail = (l.getType() == 0 ? VIRTUAL : OCCUPIED);
+                    size_t i = avail.find_first_not_of(used);
+                    if (i == string::npos) throw runtime_error("too many internal indices");
+                    used += avail[i];
+                    labels[l.asInt()] = (l.isAlpha() ? (char)std::toupper(avail[i]) : avail[i]);
+                }
+                s += labels[l.asInt()];
+            }
+            return s;
+        }
+};
+
+vector<int> countAlpha(const vector<Line>& out, const vector<Line>& in, bool upper)
+{
+    vector<int> n(2, 0);
+    for (auto& l : (upper ? out : in)) if (l.isAlpha()) n[l.getType()]++;
+    return n;
+}
+
+bool conservesSpin(const vector<Line>& out, const vector<Line>& in)
+{
+    int spin = 0;
+    for (auto& l : out) spin += (l.isAlpha() ? 1 : -1);
+    for (auto& l : in) spin -= (l.isAlpha() ? 1 : -1);
+    return spin == 0;
+}
+
+/*
+ * Write the spin-integrated form of C op= factor*A[*B]
+ */
+void expand(ostream& os, const string& indent, const Operand& C, const string& op,
+            const Fraction& factor, const vector<Operand>& AB)
+{
+    for (auto& sc : spinCases(C))
+    {
+        Diagram d = (AB.size() == 1 ?
+            expandSum(AB[0].nout, AB[0].nin, AB[0].idx,
+                      C.nout, C.nin, C.idx, sc.first, sc.second) :
+            expandMult(AB[0].nout, AB[0].nin, AB[0].idx,
+                       AB[1].nout, AB[1].nin, AB[1].idx,
+                       C.nout, C.nin, C.idx, sc.first, sc.second));
+
+        /*
+         * Combine terms which give the same contraction
+         */
+        vector<pair<string,Fraction>> terms;
+        string lhs;
+
+        for (auto& t : d.getTerms())
+        {
+            map<string,const Fragment*> frags;
+            for (auto& f : t.getFragments()) frags[f.getOp()] = &f;
+
+            const Fragment& fC = *frags[AB.size() == 1 ? "B" : "C"];
+            Labeller label(fC.getIndicesOut(), fC.getIndicesIn(), C.idx);
+            lhs = caseName(C, sc.first, sc.second) + "[\"" +
+                  label(fC.getIndicesOut(), fC.getIndicesIn()) + "\"]";
+
+            string rhs;
+            bool ok = true;
+            for (int i = 0;i < AB.size();i++)
+            {
+                const Fragment& f = *frags[string(1, 'A'+i)];
+                const vector<Line>& out = f.getIndicesOut();
+                const vector<Line>& in = f.getIndicesIn();
+                if (!conservesSpin(out, in)) ok = false;
+                rhs += (i > 0 ? "*" : "") +
+                       caseName(AB[i], countAlpha(out, in, true), countAlpha(out, in, false)) +
+                       "[\"" + label(out, in) + "\"]";
+            }
+            if (!ok) continue;
+
+            Fraction f = factor*t.getFactor();
+            auto it = std::find_if(terms.begin(), terms.end(),
+                              [&](const pair<string,Fraction>& p) { return p.first == rhs; });
+            if (it == terms.end()) terms.emplace_back(rhs, f);
+            else it->second += f;
+        }
+
+        bool first = (op == "=");
+
+        if (first && (terms.empty() || std::all_of(terms.begin(), terms.end(),
+                                              [](const pair<string,Fraction>& p) { return p.second == 0; })))
+        {
+            os << indent << caseName(C, sc.first, sc.second) << " = (U)0.0;" << endl;
+            continue;
+        }
+
+        for (auto& t : terms)
+        {
+            if (t.second == 0) continue;
+
+            string assign = (first ? " = " : t.second < 0 ? " -= " : " += ");
+            Fraction f = (!first && t.second < 0 ? -t.second : t.second);
+
+            os << indent << lhs << assign << printFactor(f) << t.first << ";" << endl;
+            first = false;
+        }
+    }
+}
+
+int generate(const string& file)
+{
+    ifstream ifs(file);
+    if (!ifs) throw runtime_error("could not open " + file);
+
+    regex statement(R"(^(\s*)(\w+(?:\(\d+\))?)\s*\[\s*"(\w*)"\s*\]\s*(=|\+=|-=)\s*(.*);\s*$)");
+    regex operand(R"((\w+(?:\(\d+\))?)\s*\[\s*"(\w*)"\s*\])");
+
+    string line;
+    while (getline(ifs, line))
+    {
+        smatch m;
+        if (!regex_match(line, m, statement))
+        {
+            cout << line << endl;
+            continue;
+        }
+
+        string indent = m[1];
+        Operand C(m[2], m[3]);
+        string op = m[4];
+        string rhs = m[5];
+
+        vector<Operand> AB;
+        string prefix;
+        for (auto it = std::sregex_iterator(rhs.begin(), rhs.end(), operand);
+             it != std::sregex_iterator();++it)
+        {
+            if (AB.empty()) prefix = rhs.substr(0, it->position());
+            AB.emplace_back((*it)[1], (*it)[2]);
+        }
+
+        if (AB.empty() || AB.size() > 2)
+        {
+            cout << line << endl;
+            continue;
+        }
+
+        size_t star = prefix.find_last_of('*');
+        Fraction factor = parseFactor(star == string::npos ? prefix : prefix.substr(0, star));
+        if (op == "-=")
+        {
+            factor = -factor;
+            op = "+=";
+        }
+
+        cout << indent << "/* " << line.substr(indent.size()) << " */" << endl;
+        expand(cout, indent, C, op, factor, AB);
+    }
+
+    return 0;
+}
+
+}
+
+int main(int argc, char **argv)
+{
+    string usage = string("usage: ") + argv[0] + " generate <file> | check <file> [line]";
+
+    if (argc < 3)
+    {
+        cerr << usage << endl;
+        return 1;
+    }
+
+    string mode = argv[1];
+
+    try
+    {
+        if (mode == "generate") return generate(argv[2]);
+        if (mode == "check") return aquarius::autocc::main(argc-1, argv+1);
+    }
+    catch (exception& e)
+    {
+        cerr << argv[0] << ": " << e.what() << endl;
+        return 1;
+    }
+
+    cerr << usage << endl;
+    return 1;
+}
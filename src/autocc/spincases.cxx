@@ -0,0 +1,405 @@
+#include "autocc.hpp"
+
+namespace aquarius
+{
+namespace autocc
+{
+
+Diagram expandMult(const vector<int>& nout_A, const vector<int>& nin_A, const string& idx_A,
+                   const vector<int>& nout_B, const vector<int>& nin_B, const string& idx_B,
+                   const vector<int>& nout_C, const vector<int>& nin_C, const string& idx_C,
+                   const vector<int>& alpha_out_C, const vector<int>& alpha_in_C)
+{
+    int nouttot_C = aquarius::sum(nout_C);
+
+    string ext;
+    vector<Line> lines_C_out(aquarius::sum(nout_C));
+    vector<Line> lines_C_in(aquarius::sum(nin_C));
+    for (int i = 0, s = 0;s < nout_C.size();s++)
+    {
+        for (int a = 0;a <         alpha_out_C[s];a++,i++)
+        {
+            if (!contains(ext, idx_C[i])) ext += idx_C[i];
+            lines_C_out[i] = Line(idx_C[i], s, Line::VIRTUAL, Line::ALPHA);
+        }
+        for (int b = 0;b < nout_C[s]-alpha_out_C[s];b++,i++)
+        {
+            if (!contains(ext, idx_C[i])) ext += idx_C[i];
+            lines_C_out[i] = Line(idx_C[i], s, Line::VIRTUAL, Line::BETA);
+        }
+    }
+    for (int i = 0,s = 0;s < nout_C.size();s++)
+    {
+        for (int a = 0;a <        alpha_in_C[s];a++,i++)
+        {
+            if (!contains(ext, idx_C[i+nouttot_C])) ext += idx_C[i+nouttot_C];
+            lines_C_in[i] = Line(idx_C[i+nouttot_C], s, Line::VIRTUAL, Line::ALPHA);
+        }
+        for (int b = 0;b < nin_C[s]-alpha_in_C[s];b++,i++)
+        {
+            if (!contains(ext, idx_C[i+nouttot_C])) ext += idx_C[i+nouttot_C];
+            lines_C_in[i] = Line(idx_C[i+nouttot_C], s, Line::VIRTUAL, Line::BETA);
+        }
+    }
+
+    int nouttot_A = aquarius::sum(nout_A);
+
+    string sum;
+    vector<Line> lines_A_out(aquarius::sum(nout_A));
+    vector<Line> lines_A_in(aquarius::sum(nin_A));
+    vector<Line> lines_AandC_out, lines_AandC_in;
+    for (int i = 0, s = 0;s < nout_A.size();s++)
+    {
+        for (int a = 0;a < nout_A[s];a++,i++)
+        {
+            if (contains(ext, idx_A[i]))
+            {
+                int j;for (j = 0;idx_C[j] != idx_A[i];j++);
+                if (j < nouttot_C)
+                {
+                    lines_A_out[i] = lines_C_out[j];
+                    lines_AandC_out += lines_C_out[j];
+                }
+                else
+                {
+                    lines_A_out[i] = lines_C_in[j-nouttot_C];
+                    lines_AandC_out += lines_C_in[j-nouttot_C];
+                }
+            }
+            else
+            {
+                if (!contains(sum, idx_A[i])) sum += idx_A[i];
+                lines_A_out[i] = Line(idx_A[i], s, Line::VIRTUAL, Line::BETA);
+            }
+        }
+    }
+    for (int i = 0, s = 0;s < nout_A.size();s++)
+    {
+        for (int a = 0;a < nin_A[s];a++,i++)
+        {
+            if (contains(ext, idx_A[i+nouttot_A]))
+            {
+                int j; for (j = 0;idx_C[j] != idx_A[i+nouttot_A];j++);
+                if (j < nouttot_C)
+                {
+                    lines_A_in[i] = lines_C_out[j];
+                    lines_AandC_in += lines_C_out[j];
+                }
+                else
+                {
+                    lines_A_in[i] = lines_C_in[j-nouttot_C];
+                    lines_AandC_in += lines_C_in[j-nouttot_C];
+                }
+            }
+            else
+            {
+                if (!contains(sum, idx_A[i+nouttot_A])) sum += idx_A[i+nouttot_A];
+                lines_A_in[i] = Line(idx_A[i+nouttot_A], s, Line::VIRTUAL, Line::BETA);
+            }
+        }
+    }
+
+    int nouttot_B = aquarius::sum(nout_B);
+
+    vector<Line> lines_B_out(aquarius::sum(nout_B));
+    vector<Line> lines_B_in(aquarius::sum(nin_B));
+    vector<Line> lines_BandC_out, lines_BandC_in;
+    for (int i = 0, s = 0;s < nout_B.size();s++)
+    {
+        for (int a = 0;a < nout_B[s];a++,i++)
+        {
+            if (contains(ext, idx_B[i]))
+            {
+                int j; for (j = 0;idx_C[j] != idx_B[i];j++);
+                if (j < nouttot_C)
+                {
+                    lines_B_out[i] = lines_C_out[j];
+                    lines_BandC_out += lines_C_out[j];
+                }
+                else
+                {
+                    lines_B_out[i] = lines_C_in[j-nouttot_C];
+                    lines_BandC_out += lines_C_in[j-nouttot_C];
+                }
+            }
+            else
+            {
+                if (!contains(sum, idx_B[i])) sum += idx_B[i];
+                lines_B_out[i] = Line(idx_B[i], s, Line::VIRTUAL, Line::BETA);
+            }
+        }
+    }
+    for (int i = 0, s = 0;s < nout_B.size();s++)
+    {
+        for (int a = 0;a < nin_B[s];a++,i++)
+        {
+            if (contains(ext, idx_B[i+nouttot_B]))
+            {
+                int j; for (j = 0;idx_C[j] != idx_B[i+nouttot_B];j++);
+                if (j < nouttot_C)
+                {
+                    lines_B_in[i] = lines_C_out[j];
+                    lines_BandC_in += lines_C_out[j];
+                }
+                else
+                {
+                    lines_B_in[i] = lines_C_in[j-nouttot_C];
+                    lines_BandC_in += lines_C_in[j-nouttot_C];
+                }
+            }
+            else
+            {
+                if (!contains(sum, idx_B[i+nouttot_B])) sum += idx_B[i+nouttot_B];
+                lines_B_in[i] = Line(idx_B[i+nouttot_B], s, Line::VIRTUAL, Line::BETA);
+            }
+        }
+    }
+
+    vector<Line> lines_CnotAB_out = lines_C_out;
+    unique(lines_AandC_out);
+    unique(lines_BandC_out);
+    unique(lines_CnotAB_out);
+    exclude(lines_CnotAB_out, lines_AandC_out);
+    exclude(lines_CnotAB_out, lines_BandC_out);
+
+    vector<Line> lines_CnotAB_in = lines_C_in;
+    unique(lines_AandC_in);
+    unique(lines_BandC_in);
+    unique(lines_CnotAB_in);
+    exclude(lines_CnotAB_in, lines_AandC_in);
+    exclude(lines_CnotAB_in, lines_BandC_in);
+
+    Diagram d = Diagram(Diagram::SPINORBITAL,
+                        {Term(Diagram::SPINORBITAL)*
+                         Fragment("A", lines_A_out, lines_A_in)*
+                         Fragment("B", lines_B_out, lines_B_in)});
+
+    for (int s = 0;s < max(max(nout_A.size(),nout_B.size()),nout_C.size());s++)
+    {
+        vector<vector<Line>> assym(3);
+
+        for (vector<Line>::iterator i = lines_AandC_out.begin();i != lines_AandC_out.end();++i)
+            if (i->getType() == s) assym[0].push_back(*i);
+        for (vector<Line>::iterator i = lines_BandC_out.begin();i != lines_BandC_out.end();++i)
+            if (i->getType() == s) assym[1].push_back(*i);
+        for (vector<Line>::iterator i = lines_CnotAB_out.begin();i != lines_CnotAB_out.end();++i)
+            if (i->getType() == s) assym[2].push_back(*i);
+
+        if (assym[2].empty()) assym.erase(assym.begin()+2);
+        if (assym[1].empty()) assym.erase(assym.begin()+1);
+        if (assym[0].empty()) assym.erase(assym.begin()+0);
+        if (!assym.empty()) d.antisymmetrize(assym);
+    }
+
+    for (int s = 0;s < max(max(nout_A.size(),nout_B.size()),nout_C.size());s++)
+    {
+        vector<vector<Line>> assym(3);
+
+        for (vector<Line>::iterator i = lines_AandC_in.begin();i != lines_AandC_in.end();++i)
+            if (i->getType() == s) assym[0].push_back(*i);
+        for (vector<Line>::iterator i = lines_BandC_in.begin();i != lines_BandC_in.end();++i)
+            if (i->getType() == s) assym[1].push_back(*i);
+        for (vector<Line>::iterator i = lines_CnotAB_in.begin();i != lines_CnotAB_in.end();++i)
+            if (i->getType() == s) assym[2].push_back(*i);
+
+        if (assym[2].empty()) assym.erase(assym.begin()+2);
+        if (assym[1].empty()) assym.erase(assym.begin()+1);
+        if (assym[0].empty()) assym.erase(assym.begin()+0);
+        if (!assym.empty()) d.antisymmetrize(assym);
+    }
+
+    d.convert(Diagram::UHF);
+
+    /*
+     * Remove terms which are antisymmetrizations of same-spin groups
+     */
+    for (int s = 0;s < max(max(nout_A.size(),nout_B.size()),nout_C.size());s++)
+    {
+        for (int spin = 0;spin < 2;spin++)
+        {
+            vector<Term> terms = d.getTerms();
+            for (vector<Term>::iterator t1 = terms.begin();t1 != terms.end();++t1)
+            {
+                for (vector<Term>::iterator t2 = t1+1;t2 != terms.end();++t2)
+                {
+                    if (Term(*t1).fixorder(filtered(t1->indices(), and1(isSpin(spin),isType(s)))) ==
+                        Term(*t2).fixorder(filtered(t2->indices(), and1(isSpin(spin),isType(s)))))
+                    {
+                        d -= *t1;
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
+    d *= Term(Diagram::UHF)*Fragment("C", lines_C_out, lines_C_in);
+    d.fixorder(true);
+
+    return d;
+}
+
+Diagram expandSum(const vector<int>& nout_A, const vector<int>& nin_A, const string& idx_A,
+                  const vector<int>& nout_B, const vector<int>& nin_B, const string& idx_B,
+                  const vector<int>& alpha_out_B, const vector<int>& alpha_in_B)
+{
+    int nouttot_B = aquarius::sum(nout_B);
+
+    string ext;
+    vector<Line> lines_B_out(aquarius::sum(nout_B));
+    vector<Line> lines_B_in(aquarius::sum(nin_B));
+    for (int i = 0, s = 0;s < nout_B.size();s++)
+    {
+        for (int a = 0;a <         alpha_out_B[s];a++,i++)
+        {
+            if (!contains(ext, idx_B[i])) ext += idx_B[i];
+            lines_B_out[i] = Line(idx_B[i], s, Line::VIRTUAL, Line::ALPHA);
+        }
+        for (int b = 0;b < nout_B[s]-alpha_out_B[s];b++,i++)
+        {
+            if (!contains(ext, idx_B[i])) ext += idx_B[i];
+            lines_B_out[i] = Line(idx_B[i], s, Line::VIRTUAL, Line::BETA);
+        }
+    }
+    for (int i = 0,s = 0;s < nout_B.size();s++)
+    {
+        for (int a = 0;a <        alpha_in_B[s];a++,i++)
+        {
+            if (!contains(ext, idx_B[i+nouttot_B])) ext += idx_B[i+nouttot_B];
+            lines_B_in[i] = Line(idx_B[i+nouttot_B], s, Line::VIRTUAL, Line::ALPHA);
+        }
+        for (int b = 0;b < nin_B[s]-alpha_in_B[s];b++,i++)
+        {
+            if (!contains(ext, idx_B[i+nouttot_B])) ext += idx_B[i+nouttot_B];
+            lines_B_in[i] = Line(idx_B[i+nouttot_B], s, Line::VIRTUAL, Line::BETA);
+        }
+    }
+
+    int nouttot_A = aquarius::sum(nout_A);
+
+    string sum;
+    vector<Line> lines_A_out(aquarius::sum(nout_A));
+    vector<Line> lines_A_in(aquarius::sum(nin_A));
+    vector<Line> lines_AandB_out, lines_AandB_in;
+    for (int i = 0, s = 0;s < nout_A.size();s++)
+    {
+        for (int a = 0;a < nout_A[s];a++,i++)
+        {
+            if (contains(ext, idx_A[i]))
+            {
+                int j; for (j = 0;idx_B[j] != idx_A[i];j++);
+                if (j < nouttot_B)
+                {
+                    lines_A_out[i] = lines_B_out[j];
+                    lines_AandB_out += lines_B_out[j];
+                }
+                else
+                {
+                    lines_A_out[i] = lines_B_in[j-nouttot_B];
+                    lines_AandB_out += lines_B_in[j-nouttot_B];
+                }
+            }
+            else
+            {
+                if (!contains(sum, idx_A[i])) sum += idx_A[i];
+                lines_A_out[i] = Line(idx_A[i], s, Line::VIRTUAL, Line::BETA);
+            }
+        }
+    }
+    for (int i = 0, s = 0;s < nout_A.size();s++)
+    {
+        for (int a = 0;a < nin_A[s];a++,i++)
+        {
+            if (contains(ext, idx_A[i+nouttot_A]))
+            {
+                int j; for (j = 0;idx_B[j] != idx_A[i+nouttot_A];j++);
+                if (j < nouttot_B)
+                {
+                    lines_A_in[i] = lines_B_out[j];
+                    lines_AandB_in += lines_B_out[j];
+                }
+                else
+                {
+                    lines_A_in[i] = lines_B_in[j-nouttot_B];
+                    lines_AandB_in += lines_B_in[j-nouttot_B];
+                }
+            }
+            else
+            {
+                if (!contains(sum, idx_A[i+nouttot_A])) sum += idx_A[i+nouttot_A];
+                lines_A_in[i] = Line(idx_A[i+nouttot_A], s, Line::VIRTUAL, Line::BETA);
+            }
+        }
+    }
+
+    vector<Line> lines_BnotA_out = lines_B_out;
+    unique(lines_AandB_out);
+    unique(lines_BnotA_out);
+    exclude(lines_BnotA_out, lines_AandB_out);
+
+    vector<Line> lines_BnotA_in = lines_B_in;
+    unique(lines_AandB_in);
+    unique(lines_BnotA_in);
+    exclude(lines_BnotA_in, lines_AandB_in);
+
+    Diagram d = Diagram(Diagram::SPINORBITAL,
+                        {Term(Diagram::SPINORBITAL)*
+                         Fragment("A", lines_A_out, lines_A_in)});
+
+    for (int s = 0;s < max(nout_A.size(),nout_B.size());s++)
+    {
+        vector<vector<Line>> assym(2);
+
+        for (vector<Line>::iterator i = lines_AandB_out.begin();i != lines_AandB_out.end();++i)
+            if (i->getType() == s) assym[0].push_back(*i);
+        for (vector<Line>::iterator i = lines_BnotA_out.begin();i != lines_BnotA_out.end();++i)
+            if (i->getType() == s) assym[1].push_back(*i);
+
+        if (!assym[0].empty() && !assym[1].empty()) d.antisymmetrize(assym);
+    }
+
+    for (int s = 0;s < max(nout_A.size(),nout_B.size());s++)
+    {
+        vector<vector<Line>> assym(2);
+
+        for (vector<Line>::iterator i = lines_AandB_in.begin();i != lines_AandB_in.end();++i)
+            if (i->getType() == s) assym[0].push_back(*i);
+        for (vector<Line>::iterator i = lines_BnotA_in.begin();i != lines_BnotA_in.end();++i)
+            if (i->getType() == s) assym[1].push_back(*i);
+
+        if (!assym[0].empty() && !assym[1].empty()) d.antisymmetrize(assym);
+    }
+
+    d.convert(Diagram::UHF);
+
+    /*
+     * Remove terms which are antisymmetrizations of same-spin groups
+     */
+    for (int s = 0;s < max(nout_A.size(),nout_B.size());s++)
+    {
+        for (int spin = 0;spin < 2;spin++)
+        {
+            vector<Term> terms = d.getTerms();
+            for (vector<Term>::iterator t1 = terms.begin();t1 != terms.end();++t1)
+            {
+                for (vector<Term>::iterator t2 = t1+1;t2 != terms.end();++t2)
+                {
+                    if (Term(*t1).fixorder(filtered(t1->indices(), and1(isSpin(spin),isType(s)))) ==
+                        Term(*t2).fixorder(filtered(t2->indices(), and1(isSpin(spin),isType(s)))))
+                    {
+                        d -= *t1;
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
+    d *= Term(Diagram::UHF)*Fragment("B", lines_B_out, lines_B_in);
+    d.fixorder(true);
+
+    return d;
+}
+
+}
+}
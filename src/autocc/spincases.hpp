@@ -0,0 +1,36 @@
+#ifndef _AQUARIUS_AUTOCC_SPINCASES_HPP_
+#define _AQUARIUS_AUTOCC_SPINCASES_HPP_
+
+#include "util/global.hpp"
+
+#include "diagram.hpp"
+
+namespace aquarius
+{
+namespace autocc
+{
+
+/*
+ * Spin-integrated terms of the spin-orbital contraction C = A*B which
+ * contribute to the spin case of C with alpha_out_C and alpha_in_C alpha
+ * indices in each orbital space. nout and nin give the number of upper and
+ * lower indices of each operand in each space, and the lines are labelled
+ * by the characters of idx_A, idx_B, and idx_C. The fragments of each term
+ * are named "A", "B", and "C".
+ */
+Diagram expandMult(const vector<int>& nout_A, const vector<int>& nin_A, const string& idx_A,
+                   const vector<int>& nout_B, const vector<int>& nin_B, const string& idx_B,
+                   const vector<int>& nout_C, const vector<int>& nin_C, const string& idx_C,
+                   const vector<int>& alpha_out_C, const vector<int>& alpha_in_C);
+
+/*
+ * Spin-integrated terms of the spin-orbital sum B = A, as above
+ */
+Diagram expandSum(const vector<int>& nout_A, const vector<int>& nin_A, const string& idx_A,
+                  const vector<int>& nout_B, const vector<int>& nin_B, const string& idx_B,
+                  const vector<int>& alpha_out_B, const vector<int>& alpha_in_B);
+
+}
+}
+
+#endif
@@ -0,0 +1,447 @@
+#include "activeccsdt.hpp"
+
+using namespace aquarius::op;
+using namespace aquarius::input;
+using namespace aquarius::tensor;
+using namespace aquarius::task;
+using namespace aquarius::time;
+using namespace aquarius::symmetry;
+
+namespace aquarius
+{
+namespace cc
+{
+
+template <typename U>
+ActiveCCSDT<U>::ActiveCCSDT(const string& name, Config& config)
+: Iterative<U>(name, config), diis(config.get("diis"), 3, 3), guess(config.get<string>("guess"))
+{
+    if (config.exists("occupied")) nactocc = config.get<vector<int>>("occupied");
+    if (config.exists("virtual")) nactvrt = config.get<vector<int>>("virtual");
+
+    vector<Requirement> reqs;
+    reqs.emplace_back("moints", "H");
+    if (guess == "ccsd") reqs.emplace_back("ccsd.T", "Tccsd");
+    if (guess == "file")
+    {
+        reqs.emplace_back("occspace", "occ");
+        reqs.emplace_back("vrtspace", "vrt");
+        reqs.emplace_back("ovi", "S");
+    }
+    this->addProduct("double", "mp2", reqs);
+    this->addProduct("double", "energy", reqs);
+    this->addProduct("double", "convergence", reqs);
+}
+
+template <typename U>
+void ActiveCCSDT<U>::partition(const Arena& arena, const TwoElectronOperator<U>& H,
+                               const Denominator<U>& D)
+{
+    int nirrep = H.occ.group.getNumIrreps();
+
+    if ((!nactocc.empty() && nactocc.size() != nirrep) ||
+        (!nactvrt.empty() && nactvrt.size() != nirrep))
+        throw runtime_error("the number of active orbitals must be given for each irrep");
+
+    /*
+     * D holds e(i) for the occupied and -e(a) for the virtual orbitals, so
+     * either way the active orbitals are those with the largest values.
+     * Without a list, every orbital of that kind is active.
+     */
+    auto mark = [nirrep](const vector<vector<U>>& d, const vector<int>& nact)
+    {
+        vector<vector<bool>> act(nirrep);
+        for (int h = 0;h < nirrep;h++)
+        {
+            int n = d[h].size();
+
+            if (nact.empty())
+            {
+                act[h].assign(n, true);
+                continue;
+            }
+
+            if (nact[h] < 0 || nact[h] > n)
+                throw runtime_error("invalid number of active orbitals in irrep " + to_string(h+1));
+
+            vector<pair<real_type_t<U>,int>> order;
+            for (int p = 0;p < n;p++) order.emplace_back(real(d[h][p]), p);
+            std::sort(order.begin(), order.end(), std::greater<pair<real_type_t<U>,int>>());
+
+            act[h].assign(n, false);
+            for (int p = 0;p < nact[h];p++) act[h][order[p].second] = true;
+        }
+        return act;
+    };
+
+    this->puttmp("vrtpart", new SpacePartition<U>(arena, H.vrt, mark(D.getDA(), nactvrt),
+                                                                mark(D.getDa(), nactvrt)));
+    this->puttmp("occpart", new SpacePartition<U>(arena, H.occ, mark(D.getDI(), nactocc),
+                                                                mark(D.getDi(), nactocc)));
+}
+
+template <typename U>
+bool ActiveCCSDT<U>::run(task::TaskDAG& dag, const Arena& arena)
+{
+    const auto& H = this->template get<TwoElectronOperator<U>>("H");
+
+    const Space& occ = H.occ;
+    const Space& vrt = H.vrt;
+    const PointGroup& group = occ.group;
+
+    auto& D = this->puttmp("D", new Denominator<U>(H));
+
+    partition(arena, H, D);
+
+    if (nactocc.empty()) Logger::log(arena) << "Active occupied orbitals: all" << endl;
+    else                 Logger::log(arena) << "Active occupied orbitals: " << nactocc << endl;
+    if (nactvrt.empty()) Logger::log(arena) << "Active virtual orbitals:  all" << endl;
+    else                 Logger::log(arena) << "Active virtual orbitals:  " << nactvrt << endl;
+
+    vector<const SpacePartition<U>*> parts{&this->template gettmp<SpacePartition<U>>("vrtpart"),
+                                           &this->template gettmp<SpacePartition<U>>("occpart")};
+
+    /*
+     * Split the Hamiltonian once
+     */
+    auto split = [&](const string& name, const SpinorbitalTensor<U>& A) -> ActiveSpaceTensor<U>&
+    {
+        auto& B = this->puttmp(name, new ActiveSpaceTensor<U>(name, arena, group, parts,
+                                                              A.getNumOut(), A.getNumIn()));
+        B.slice(A);
+        return B;
+    };
+
+    auto&   fAI = split(  "fAI",   H.getAI());
+            split(  "fME",   H.getIA());
+    auto&   fAE = split(  "fAE",   H.getAB());
+            split(  "fMI",   H.getIJ());
+    auto& VABIJ = split("VABIJ", H.getABIJ());
+            split("VMNEF", H.getIJAB());
+            split("VAMEF", H.getAIBC());
+            split("VABEJ", H.getABCI());
+    auto& VABEF = split("VABEF", H.getABCD());
+    auto& VMNIJ = split("VMNIJ", H.getIJKL());
+    auto& VMNEJ = split("VMNEJ", H.getIJAK());
+    auto& VAMIJ = split("VAMIJ", H.getAIJK());
+    auto& VAMEI = split("VAMEI", H.getAIBJ());
+
+    /*
+     * Only the triples blocks with at least one active virtual (upper) and
+     * one active occupied (lower) index are stored
+     */
+    auto amplitudes = [&](const string& name, int n) -> ActiveSpaceTensor<U>&
+    {
+        if (n < 3) return this->puttmp(name, new ActiveSpaceTensor<U>(name, arena, group, parts, {n,0}, {0,n}));
+        return this->puttmp(name, new ActiveSpaceTensor<U>(name, arena, group, parts, {n,0}, {0,n},
+                                                           {1,0}, {0,1}));
+    };
+
+    auto& T1 = amplitudes("T1", 1);
+    auto& T2 = amplitudes("T2", 2);
+    auto& T3 = amplitudes("T3", 3);
+               amplitudes("Z1", 1);
+               amplitudes("Z2", 2);
+               amplitudes("Z3", 3);
+
+    auto& Tau = this->puttmp("Tau", new ActiveSpaceTensor<U>("Tau", VABIJ));
+
+    this->puttmp(  "FAE", new ActiveSpaceTensor<U>(    "F(ae)",   fAE));
+    this->puttmp(  "FMI", new ActiveSpaceTensor<U>(    "F(mi)",   this->template gettmp<ActiveSpaceTensor<U>>("fMI")));
+    this->puttmp(  "FME", new ActiveSpaceTensor<U>(    "F(me)",   this->template gettmp<ActiveSpaceTensor<U>>("fME")));
+    this->puttmp("WMNIJ", new ActiveSpaceTensor<U>( "W(mn,ij)", VMNIJ));
+    this->puttmp("WMNEJ", new ActiveSpaceTensor<U>( "W(mn,ej)", VMNEJ));
+    this->puttmp("WAMIJ", new ActiveSpaceTensor<U>( "W(am,ij)", VAMIJ));
+    this->puttmp("WAMEI", new ActiveSpaceTensor<U>( "W(am,ei)", VAMEI));
+    this->puttmp("WABEF", new ActiveSpaceTensor<U>( "W(ab,ef)", VABEF));
+    this->puttmp("WABEJ", new ActiveSpaceTensor<U>("W~(ab,ej)", this->template gettmp<ActiveSpaceTensor<U>>("VABEJ")));
+    this->puttmp("WAMEF", new ActiveSpaceTensor<U>( "W(am,ef)", this->template gettmp<ActiveSpaceTensor<U>>("VAMEF")));
+
+    vector<const vector<vector<U>>*> da{&D.getDA(), &D.getDI()};
+    vector<const vector<vector<U>>*> db{&D.getDa(), &D.getDi()};
+
+    T1 = fAI;
+    T2 = VABIJ;
+    T3 = (U)0.0;
+
+    T1.weight(da, db);
+    T2.weight(da, db);
+
+    Tau["abij"]  = T2["abij"];
+    Tau["abij"] += 0.5*T1["ai"]*T1["bj"];
+
+    double mp2 = real(scalar(fAI*T1)) + 0.25*real(scalar(VABIJ*Tau));
+    Logger::log(arena) << "MP2 energy = " << setprecision(15) << mp2 << endl;
+    this->put("mp2", new U(mp2));
+
+    if (guess == "ccsd")
+    {
+        auto& Tccsd = this->template get<ExcitationOperator<U,2>>("Tccsd");
+        T1.slice(Tccsd(1));
+        T2.slice(Tccsd(2));
+    }
+    else if (guess == "file")
+    {
+        /*
+         * Only the singles and doubles are read, so that the full triples
+         * are never formed
+         */
+        ExcitationOperator<U,2> Tguess("T", arena, occ, vrt);
+        Tguess(0) = (U)0.0;
+        Tguess(1) = H.getAI();
+        Tguess(2) = H.getABIJ();
+        Tguess.weight(D);
+
+        readAmplitudeGuess(this->config.template get<string>("guess_file"),
+                           this->template get<MOSpace<U>>("occ"),
+                           this->template get<MOSpace<U>>("vrt"),
+                           this->template get<SymmetryBlockedTensor<U>>("S"), Tguess);
+
+        T1.slice(Tguess(1));
+        T2.slice(Tguess(2));
+    }
+
+    CTF_Timer_epoch ep(this->name.c_str());
+    ep.begin();
+    Iterative<U>::run(dag, arena);
+    ep.end();
+
+    this->put("energy", new U(this->energy()));
+    this->put("convergence", new U(this->conv()));
+
+    return true;
+}
+
+template <typename U>
+void ActiveCCSDT<U>::iterate(const Arena& arena)
+{
+    const auto&   fAI = this->template gettmp<ActiveSpaceTensor<U>>(  "fAI");
+    const auto&   fME = this->template gettmp<ActiveSpaceTensor<U>>(  "fME");
+    const auto&   fAE = this->template gettmp<ActiveSpaceTensor<U>>(  "fAE");
+    const auto&   fMI = this->template gettmp<ActiveSpaceTensor<U>>(  "fMI");
+    const auto& VABIJ = this->template gettmp<ActiveSpaceTensor<U>>("VABIJ");
+    const auto& VMNEF = this->template gettmp<ActiveSpaceTensor<U>>("VMNEF");
+    const auto& VAMEF = this->template gettmp<ActiveSpaceTensor<U>>("VAMEF");
+    const auto& VABEJ = this->template gettmp<ActiveSpaceTensor<U>>("VABEJ");
+    const auto& VABEF = this->template gettmp<ActiveSpaceTensor<U>>("VABEF");
+    const auto& VMNIJ = this->template gettmp<ActiveSpaceTensor<U>>("VMNIJ");
+    const auto& VMNEJ = this->template gettmp<ActiveSpaceTensor<U>>("VMNEJ");
+    const auto& VAMIJ = this->template gettmp<ActiveSpaceTensor<U>>("VAMIJ");
+    const auto& VAMEI = this->template gettmp<ActiveSpaceTensor<U>>("VAMEI");
+
+    auto& D   = this->template gettmp<Denominator      <U>>(  "D");
+    auto& T1  = this->template gettmp<ActiveSpaceTensor<U>>( "T1");
+    auto& T2  = this->template gettmp<ActiveSpaceTensor<U>>( "T2");
+    auto& T3  = this->template gettmp<ActiveSpaceTensor<U>>( "T3");
+    auto& Z1  = this->template gettmp<ActiveSpaceTensor<U>>( "Z1");
+    auto& Z2  = this->template gettmp<ActiveSpaceTensor<U>>( "Z2");
+    auto& Z3  = this->template gettmp<ActiveSpaceTensor<U>>( "Z3");
+    auto& Tau = this->template gettmp<ActiveSpaceTensor<U>>("Tau");
+
+    auto&   FME = this->template gettmp<ActiveSpaceTensor<U>>(  "FME");
+    auto&   FAE = this->template gettmp<ActiveSpaceTensor<U>>(  "FAE");
+    auto&   FMI = this->template gettmp<ActiveSpaceTensor<U>>(  "FMI");
+    auto& WMNIJ = this->template gettmp<ActiveSpaceTensor<U>>("WMNIJ");
+    auto& WMNEJ = this->template gettmp<ActiveSpaceTensor<U>>("WMNEJ");
+    auto& WAMIJ = this->template gettmp<ActiveSpaceTensor<U>>("WAMIJ");
+    auto& WAMEI = this->template gettmp<ActiveSpaceTensor<U>>("WAMEI");
+    auto& WABEF = this->template gettmp<ActiveSpaceTensor<U>>("WABEF");
+    auto& WABEJ = this->template gettmp<ActiveSpaceTensor<U>>("WABEJ");
+    auto& WAMEF = this->template gettmp<ActiveSpaceTensor<U>>("WAMEF");
+
+    Tau["abij"]  = T2["abij"];
+    Tau["abij"] += 0.5*T1["ai"]*T1["bj"];
+
+    /**************************************************************************
+     *
+     * Intermediates for CCSD
+     */
+      FME[  "me"]  =       fME[  "me"];
+      FME[  "me"] +=     VMNEF["mnef"]*T1[  "fn"];
+
+      FMI[  "mi"]  =       fMI[  "mi"];
+      FMI[  "mi"] += 0.5*VMNEF["mnef"]*T2["efin"];
+      FMI[  "mi"] +=       FME[  "me"]*T1[  "ei"];
+      FMI[  "mi"] +=     VMNEJ["nmfi"]*T1[  "fn"];
+
+      FAE[  "ae"]  =       fAE[  "ae"];
+      FAE[  "ae"] -= 0.5*VMNEF["mnef"]*T2["afmn"];
+      FAE[  "ae"] -=       FME[  "me"]*T1[  "am"];
+      FAE[  "ae"] +=     VAMEF["amef"]*T1[  "fm"];
+
+    WMNIJ["mnij"]  =     VMNIJ["mnij"];
+    WMNIJ["mnij"] += 0.5*VMNEF["mnef"]* Tau["efij"];
+    WMNIJ["mnij"] +=     VMNEJ["mnej"]*T1[  "ei"];
+
+    WMNEJ["mnej"]  =     VMNEJ["mnej"];
+    WMNEJ["mnej"] +=     VMNEF["mnef"]*T1[  "fj"];
+
+    WAMIJ["amij"]  =     VAMIJ["amij"];
+    WAMIJ["amij"] += 0.5*VAMEF["amef"]* Tau["efij"];
+    WAMIJ["amij"] +=     VAMEI["amej"]*T1[  "ei"];
+
+    WAMEI["amei"]  =     VAMEI["amei"];
+    WAMEI["amei"] += 0.5*VMNEF["mnef"]*T2["afni"];
+    WAMEI["amei"] +=     VAMEF["amef"]*T1[  "fi"];
+    WAMEI["amei"] -=     WMNEJ["nmei"]*T1[  "an"];
+    /*
+     *************************************************************************/
+
+    /**************************************************************************
+     *
+     * CCSD Iteration
+     */
+    Z1[  "ai"]  =       fAI[  "ai"];
+    Z1[  "ai"] +=       fAE[  "ae"]*T1[  "ei"];
+    Z1[  "ai"] -=       FMI[  "mi"]*T1[  "am"];
+    Z1[  "ai"] -=     VAMEI["amei"]*T1[  "em"];
+    Z1[  "ai"] +=       FME[  "me"]*T2["aeim"];
+    Z1[  "ai"] += 0.5*VAMEF["amef"]* Tau["efim"];
+    Z1[  "ai"] -= 0.5*WMNEJ["mnei"]*T2["eamn"];
+
+    Z2["abij"]  =     VABIJ["abij"];
+    Z2["abij"] +=     VABEJ["abej"]*T1[  "ei"];
+    Z2["abij"] -=     WAMIJ["amij"]*T1[  "bm"];
+    Z2["abij"] +=       FAE[  "af"]*T2["fbij"];
+    Z2["abij"] -=       FMI[  "ni"]*T2["abnj"];
+    Z2["abij"] += 0.5*VABEF["abef"]* Tau["efij"];
+    Z2["abij"] += 0.5*WMNIJ["mnij"]* Tau["abmn"];
+    Z2["abij"] +=     WAMEI["amei"]*T2["ebjm"];
+    /*
+     *************************************************************************/
+
+    /**************************************************************************
+     *
+     * Intermediates for CCSDT
+     */
+    WAMIJ["amij"] +=     WMNEJ["nmej"]*T2[  "aein"];
+    WAMIJ["amij"] -=     WMNIJ["nmij"]*T1[    "an"];
+    WAMIJ["amij"] +=       FME[  "me"]*T2[  "aeij"];
+    WAMIJ["amij"] += 0.5*VMNEF["mnef"]*T3["aefijn"];
+
+    WAMEI["amei"] += 0.5*VMNEF["mnef"]*T2[  "afni"];
+    WAMEI["amei"] += 0.5*WMNEJ["nmei"]*T1[    "an"];
+
+    WABEJ["abej"]  =     VABEJ["abej"];
+    WABEJ["abej"] +=     VAMEF["amef"]*T2[  "fbmj"];
+    WABEJ["abej"] += 0.5*WMNEJ["mnej"]*T2[  "abmn"];
+    WABEJ["abej"] +=     VABEF["abef"]*T1[    "fj"];
+    WABEJ["abej"] -=     WAMEI["amej"]*T1[    "bm"];
+    WABEJ["abej"] -= 0.5*VMNEF["mnef"]*T3["afbmnj"];
+
+    WAMEI["amei"] -= 0.5*WMNEJ["nmei"]*T1[    "an"];
+
+    WABEF["abef"]  =     VABEF["abef"];
+    WABEF["abef"] -=     VAMEF["amef"]*T1[    "bm"];
+    WABEF["abef"] += 0.5*VMNEF["mnef"]* Tau[  "abmn"];
+
+    WAMEF["amef"]  =     VAMEF["amef"];
+    WAMEF["amef"] -=     VMNEF["nmef"]*T1[    "an"];
+    /*
+     *************************************************************************/
+
+    /**************************************************************************
+     *
+     * CCSDT Iteration
+     *
+     * Z3 only has the blocks that T3 has, so only those are ever computed
+     */
+    Z1[    "ai"] += 0.25*VMNEF["mnef"]*T3["aefimn"];
+
+    Z2[  "abij"] +=  0.5*WAMEF["bmef"]*T3["aefijm"];
+    Z2[  "abij"] -=  0.5*WMNEJ["mnej"]*T3["abeinm"];
+    Z2[  "abij"] +=        FME[  "me"]*T3["abeijm"];
+
+    Z3["abcijk"]  =      WABEJ["bcek"]*T2[  "aeij"];
+    Z3["abcijk"] -=      WAMIJ["bmjk"]*T2[  "acim"];
+    Z3["abcijk"] +=        FAE[  "ce"]*T3["abeijk"];
+    Z3["abcijk"] -=        FMI[  "mk"]*T3["abcijm"];
+    Z3["abcijk"] +=  0.5*WABEF["abef"]*T3["efcijk"];
+    Z3["abcijk"] +=  0.5*WMNIJ["mnij"]*T3["abcmnk"];
+    Z3["abcijk"] +=      WAMEI["amei"]*T3["ebcjmk"];
+    /*
+     **************************************************************************/
+
+    vector<const vector<vector<U>>*> da{&D.getDA(), &D.getDI()};
+    vector<const vector<vector<U>>*> db{&D.getDa(), &D.getDi()};
+
+    Z1.weight(da, db);
+    Z2.weight(da, db);
+    Z3.weight(da, db);
+    T1 += Z1;
+    T2 += Z2;
+    T3 += Z3;
+
+    Tau["abij"]  = T2["abij"];
+    Tau["abij"] += 0.5*T1["ai"]*T1["bj"];
+    this->energy() = real(scalar(fAI*T1)) + 0.25*real(scalar(VABIJ*Tau));
+    this->conv() = max(Z1.norm(00), max(Z2.norm(00), Z3.norm(00)));
+
+    diis.extrapolate(ptr_vector<ActiveSpaceTensor<U>>{&T1, &T2, &T3},
+                     ptr_vector<ActiveSpaceTensor<U>>{&Z1, &Z2, &Z3});
+}
+
+template <typename U>
+void ActiveCCSDT<U>::writeCheckpoint(Checkpoint& chk)
+{
+    this->template gettmp<ActiveSpaceTensor<U>>("T1").write(chk);
+    this->template gettmp<ActiveSpaceTensor<U>>("T2").write(chk);
+    this->template gettmp<ActiveSpaceTensor<U>>("T3").write(chk);
+    diis.write(chk);
+}
+
+template <typename U>
+void ActiveCCSDT<U>::readCheckpoint(const Arena& arena, Checkpoint& chk)
+{
+    auto& T1 = this->template gettmp<ActiveSpaceTensor<U>>("T1");
+    auto& T2 = this->template gettmp<ActiveSpaceTensor<U>>("T2");
+    auto& T3 = this->template gettmp<ActiveSpaceTensor<U>>("T3");
+    auto& Z1 = this->template gettmp<ActiveSpaceTensor<U>>("Z1");
+    auto& Z2 = this->template gettmp<ActiveSpaceTensor<U>>("Z2");
+    auto& Z3 = this->template gettmp<ActiveSpaceTensor<U>>("Z3");
+
+    T1.read(chk);
+    T2.read(chk);
+    T3.read(chk);
+    diis.read(chk, ptr_vector<ActiveSpaceTensor<U>>{&T1, &T2, &T3},
+                   ptr_vector<ActiveSpaceTensor<U>>{&Z1, &Z2, &Z3});
+}
+
+}
+}
+
+static const char* spec = R"!(
+
+convergence?
+    double 1e-9,
+max_iterations?
+    int 50,
+conv_type?
+    enum { MAXE, RMSE, MAE },
+guess?
+    enum { mp2, ccsd, file },
+guess_file?
+    string guess,
+# number of active occupied orbitals in each irrep, e.g. "[2,0,1,1]"
+# (all occupied orbitals if not given)
+occupied?
+    string,
+# number of active virtual orbitals in each irrep (all if not given)
+virtual?
+    string,
+diis?
+{
+    damping?
+        double 0.0,
+    start?
+        int 1,
+    order?
+        int 5,
+    jacobi?
+        bool false
+}
+
+)!";
+
+INSTANTIATE_SPECIALIZATIONS(aquarius::cc::ActiveCCSDT);
+REGISTER_TASK(aquarius::cc::ActiveCCSDT<double>,"activeccsdt",spec);
@@ -0,0 +1,60 @@
+#ifndef _AQUARIUS_CC_ACTIVECCSDT_HPP_
+#define _AQUARIUS_CC_ACTIVECCSDT_HPP_
+
+#include "util/global.hpp"
+
+#include "task/task.hpp"
+#include "time/time.hpp"
+#include "util/iterative.hpp"
+#include "operator/2eoperator.hpp"
+#include "operator/excitationoperator.hpp"
+#include "convergence/diis.hpp"
+#include "tensor/active_tensor.hpp"
+
+#include "ccsd.hpp"
+
+namespace aquarius
+{
+namespace cc
+{
+
+/*
+ * Active-space CCSDt: CCSDT with the triples restricted to those with at
+ * least one active occupied and one active virtual index. The active
+ * orbitals are the highest occupied and lowest virtual orbitals of each
+ * irrep, with the number in each irrep given by the occupied and virtual
+ * lists in the input (all orbitals if a list is not given). All quantities
+ * are kept over the occupied and virtual spaces split into their active and
+ * inactive parts, so that only the allowed blocks of the triples are ever
+ * stored or contracted.
+ */
+template <typename U>
+class ActiveCCSDT : public Iterative<U>
+{
+    protected:
+        convergence::DIIS<tensor::ActiveSpaceTensor<U>> diis;
+        string guess;
+        vector<int> nactocc;
+        vector<int> nactvrt;
+
+        bool isRestartable() const { return true; }
+
+        void writeCheckpoint(task::Checkpoint& chk);
+
+        void readCheckpoint(const Arena& arena, task::Checkpoint& chk);
+
+        void partition(const Arena& arena, const op::TwoElectronOperator<U>& H,
+                       const op::Denominator<U>& D);
+
+    public:
+        ActiveCCSDT(const string& name, input::Config& config);
+
+        bool run(task::TaskDAG& dag, const Arena& arena);
+
+        void iterate(const Arena& arena);
+};
+
+}
+}
+
+#endif
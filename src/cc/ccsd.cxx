@@ -13,17 +13,53 @@ namespace cc
 
 template <typename U>
 CCSD<U>::CCSD(const string& name, Config& config)
-: Iterative<U>(name, config), diis(config.get("diis"))
+: Iterative<U>(name, config), diis(config.get("diis")),
+  guess(config.get<string>("guess")),
+  single(config.get<bool>("mixed_precision")),
+  single_conv(config.get<double>("single_precision_convergence")),
+  single_last(numeric_limits<double>::max())
 {
     vector<Requirement> reqs;
     reqs.push_back(Requirement("moints", "H"));
+    if (guess == "ccsd") reqs.emplace_back("ccsd.T", "Tccsd");
+    if (guess == "file" || config.exists("save_guess"))
+    {
+        reqs.emplace_back("occspace", "occ");
+        reqs.emplace_back("vrtspace", "vrt");
+    }
+    if (guess == "file") reqs.emplace_back("ovi", "S");
+    if (guess == "file" && !config.exists("guess_file")) reqs.emplace_back("Tguess", "guess");
     this->addProduct(Product("double", "mp2", reqs));
     this->addProduct(Product("double", "energy", reqs));
     this->addProduct(Product("double", "convergence", reqs));
     this->addProduct(Product("double", "S2", reqs));
     this->addProduct(Product("double", "multiplicity", reqs));
+    this->addProduct(Product("double", "iterations", reqs));
     this->addProduct(Product("ccsd.T", "T", reqs));
     this->addProduct(Product("ccsd.Hbar", "Hbar", reqs));
+    if (config.exists("save_guess")) this->addProduct(Product("Tguess", "saved_guess", reqs));
+}
+
+template <typename U>
+template <typename V>
+void CCSD<U>::allocate(const TwoElectronOperator<V>& H, const string& prefix)
+{
+    const Space& occ = H.occ;
+    const Space& vrt = H.vrt;
+
+    this->puttmp(prefix+  "Z", new ExcitationOperator<V,2>("Z", H.arena, occ, vrt));
+    this->puttmp(prefix+"Tau", new SpinorbitalTensor <V  >("Tau", H.getABIJ()));
+    this->puttmp(prefix+  "D", new Denominator       <V  >(H));
+
+    this->puttmp(prefix+  "FAE", new SpinorbitalTensor<V>(    "F(ae)",   H.getAB()));
+    this->puttmp(prefix+  "FMI", new SpinorbitalTensor<V>(    "F(mi)",   H.getIJ()));
+    this->puttmp(prefix+  "FME", new SpinorbitalTensor<V>(    "F(me)",   H.getIA()));
+    this->puttmp(prefix+"WMNIJ", new SpinorbitalTensor<V>( "W(mn,ij)", H.getIJKL()));
+    this->puttmp(prefix+"WMNEJ", new SpinorbitalTensor<V>( "W(mn,ej)", H.getIJAK()));
+    this->puttmp(prefix+"WAMIJ", new SpinorbitalTensor<V>("W~(am,ij)", H.getAIJK()));
+    this->puttmp(prefix+"WAMEI", new SpinorbitalTensor<V>("W~(am,ei)", H.getAIBJ()));
+
+    this->template gettmp<ExcitationOperator<V,2>>(prefix+"Z")(0) = (V)0.0;
 }
 
 template <typename U>
@@ -34,40 +70,106 @@ bool CCSD<U>::run(TaskDAG& dag, const Arena& arena)
     const Space& occ = H.occ;
     const Space& vrt = H.vrt;
 
-    auto& T   = this->put   (  "T", new ExcitationOperator<U,2>("T", arena, occ, vrt));
-    auto& Z   = this->puttmp(  "Z", new ExcitationOperator<U,2>("Z", arena, occ, vrt));
-    auto& Tau = this->puttmp("Tau", new SpinorbitalTensor <U  >("Tau", H.getABIJ()));
-    auto& D   = this->puttmp(  "D", new Denominator       <U  >(H));
+    unique_ptr<ExcitationOperator<U,2>> T(new ExcitationOperator<U,2>("T", arena, occ, vrt));
 
-    this->puttmp(  "FAE", new SpinorbitalTensor<U>(    "F(ae)",   H.getAB()));
-    this->puttmp(  "FMI", new SpinorbitalTensor<U>(    "F(mi)",   H.getIJ()));
-    this->puttmp(  "FME", new SpinorbitalTensor<U>(    "F(me)",   H.getIA()));
-    this->puttmp("WMNIJ", new SpinorbitalTensor<U>( "W(mn,ij)", H.getIJKL()));
-    this->puttmp("WMNEJ", new SpinorbitalTensor<U>( "W(mn,ej)", H.getIJAK()));
-    this->puttmp("WAMIJ", new SpinorbitalTensor<U>("W~(am,ij)", H.getAIJK()));
-    this->puttmp("WAMEI", new SpinorbitalTensor<U>("W~(am,ei)", H.getAIBJ()));
+    {
+        Denominator<U> D(H);
+        SpinorbitalTensor<U> Tau("Tau", H.getABIJ());
 
-    Z(0) = (U)0.0;
-    T(0) = (U)0.0;
-    T(1) = H.getAI();
-    T(2) = H.getABIJ();
+        (*T)(0) = (U)0.0;
+        (*T)(1) = H.getAI();
+        (*T)(2) = H.getABIJ();
 
-    T.weight(D);
+        T->weight(D);
 
-    Tau["abij"]  = T(2)["abij"];
-    Tau["abij"] += 0.5*T(1)["ai"]*T(1)["bj"];
+        Tau["abij"]  = (*T)(2)["abij"];
+        Tau["abij"] += 0.5*(*T)(1)["ai"]*(*T)(1)["bj"];
+
+        double mp2 = real(scalar(H.getAI()*(*T)(1))) + 0.25*real(scalar(H.getABIJ()*Tau));
+        Logger::log(arena) << "MP2 energy = " << setprecision(15) << mp2 << endl;
+        this->put("mp2", new U(mp2));
+    }
+
+    if (guess == "ccsd")
+    {
+        auto& Tccsd = this->template get<ExcitationOperator<U,2>>("Tccsd");
+        (*T)(1) = Tccsd(1);
+        (*T)(2) = Tccsd(2);
+    }
+    else if (guess == "file")
+    {
+        /*
+         * Without guess_file, read the file saved by the task hooked up to
+         * "guess", e.g. "using guess from other.ccsd:saved_guess"
+         */
+        string file = (this->config.exists("guess_file") ? this->config.template get<string>("guess_file")
+                                                         : this->template get<string>("guess"));
+        readAmplitudeGuess(file,
+                           this->template get<MOSpace<U>>("occ"),
+                           this->template get<MOSpace<U>>("vrt"),
+                           this->template get<SymmetryBlockedTensor<U>>("S"), *T);
+    }
 
-    double mp2 = real(scalar(H.getAI()*T(1))) + 0.25*real(scalar(H.getABIJ()*Tau));
-    Logger::log(arena) << "MP2 energy = " << setprecision(15) << mp2 << endl;
-    this->put("mp2", new U(mp2));
+    /*
+     * In mixed-precision mode the early iterations work on single-precision
+     * copies of H and T, and of all the intermediates, which halves the
+     * memory traffic of every contraction. The double-precision amplitudes
+     * and intermediates only exist once the residual drops below
+     * single_precision_convergence (or stops improving), when T is promoted
+     * back (see promote()).
+     */
+    #ifdef ENABLE_SINGLE_PRECISION
+    if (single)
+    {
+        auto& Hs = this->puttmp("single.H", new TwoElectronOperator<float>("H", arena, occ, vrt));
+        auto& Ts = this->puttmp("single.T", new ExcitationOperator<float,2>("T", arena, occ, vrt));
+        this->puttmp("single.DIIS", new convergence::DIIS<ExcitationOperator<float,2>>(this->config.get("diis")));
+
+        Hs.convert(H);
+        Ts.convert(*T);
+        T.reset();
+        allocate(Hs, "single.");
+    }
+    else
+    #else
+    if (single)
+    {
+        this->warn(arena) << "Single-precision support not compiled in (see "
+                             "--enable-single-precision), iterating in full precision" << endl;
+        single = false;
+    }
+    #endif
+    {
+        this->put("T", T.release());
+        allocate(H, "");
+    }
 
     CTF_Timer_epoch ep(this->name.c_str());
     ep.begin();
     Iterative<U>::run(dag, arena);
+
+    /*
+     * Only reached if max_iterations ran out in single precision; the
+     * energy must still come from a full-precision iteration
+     */
+    if (single)
+    {
+        promote(arena);
+        iterate(arena);
+    }
     ep.end();
 
     this->put("energy", new U(this->energy()));
     this->put("convergence", new U(this->conv()));
+    this->put("iterations", new U(this->iter()-1));
+
+    if (this->config.exists("save_guess"))
+    {
+        writeAmplitudeGuess(this->config.template get<string>("save_guess"),
+                            this->template get<MOSpace<U>>("occ"),
+                            this->template get<MOSpace<U>>("vrt"), this->template get<ExcitationOperator<U,2>>("T"));
+        this->put("saved_guess", new string(this->config.template get<string>("save_guess")));
+    }
 
     /*
     if (isUsed("S2") || isUsed("multiplicity"))
@@ -82,47 +184,174 @@ bool CCSD<U>::run(TaskDAG& dag, const Arena& arena)
 
     if (this->isUsed("Hbar"))
     {
-        this->put("Hbar", new STTwoElectronOperator<U>("Hbar", H, T, true));
+        bool implicit = this->config.template get<bool>("implicit_hbar");
+
+        auto& T = this->template get<ExcitationOperator<U,2>>("T");
+
+        this->put("Hbar", new STTwoElectronOperator<U>("Hbar", H, T, true, implicit));
+
+        /*
+         * An implicit Hbar shares the bare <ab||ef> integrals with H
+         */
+        if (implicit)
+        {
+            Product& Hbar = this->getProduct("Hbar");
+            for (Requirement& r : Hbar.getRequirements())
+            {
+                if (r.getName() == "H") Hbar.retain(r.get());
+            }
+        }
     }
 
     return true;
 }
 
 template <typename U>
-void CCSD<U>::iterate(const Arena& arena)
+void CCSD<U>::promote(const Arena& arena)
 {
+    #ifdef ENABLE_SINGLE_PRECISION
     const auto& H = this->template get<TwoElectronOperator<U>>("H");
 
-    const SpinorbitalTensor<U>&   fAI =   H.getAI();
-    const SpinorbitalTensor<U>&   fME =   H.getIA();
-    const SpinorbitalTensor<U>&   fAE =   H.getAB();
-    const SpinorbitalTensor<U>&   fMI =   H.getIJ();
-    const SpinorbitalTensor<U>& VABIJ = H.getABIJ();
-    const SpinorbitalTensor<U>& VMNEF = H.getIJAB();
-    const SpinorbitalTensor<U>& VAMEF = H.getAIBC();
-    const SpinorbitalTensor<U>& VABEJ = H.getABCI();
-    const SpinorbitalTensor<U>& VABEF = H.getABCD();
-    const SpinorbitalTensor<U>& VMNIJ = H.getIJKL();
-    const SpinorbitalTensor<U>& VMNEJ = H.getIJAK();
-    const SpinorbitalTensor<U>& VAMIJ = H.getAIJK();
-    const SpinorbitalTensor<U>& VAMEI = H.getAIBJ();
-
-    auto& T   = this->template get   <ExcitationOperator<U,2>>(  "T");
-    auto& D   = this->template gettmp<Denominator       <U  >>(  "D");
-    auto& Z   = this->template gettmp<ExcitationOperator<U,2>>(  "Z");
-    auto& Tau = this->template gettmp<SpinorbitalTensor <U  >>("Tau");
-
-    auto&   FME = this->template gettmp<SpinorbitalTensor<U>>(  "FME");
-    auto&   FAE = this->template gettmp<SpinorbitalTensor<U>>(  "FAE");
-    auto&   FMI = this->template gettmp<SpinorbitalTensor<U>>(  "FMI");
-    auto& WMNIJ = this->template gettmp<SpinorbitalTensor<U>>("WMNIJ");
-    auto& WMNEJ = this->template gettmp<SpinorbitalTensor<U>>("WMNEJ");
-    auto& WAMIJ = this->template gettmp<SpinorbitalTensor<U>>("WAMIJ");
-    auto& WAMEI = this->template gettmp<SpinorbitalTensor<U>>("WAMEI");
+    auto& T = this->put("T", new ExcitationOperator<U,2>("T", arena, H.occ, H.vrt));
+
+    T.convert(this->template gettmp<ExcitationOperator<float,2>>("single.T"));
+
+    for (const string& name : {"H", "T", "DIIS", "Z", "Tau", "D", "FAE", "FMI",
+                               "FME", "WMNIJ", "WMNEJ", "WAMIJ", "WAMEI"})
+    {
+        this->freetmp("single."+name);
+    }
+
+    allocate(H, "");
+
+    this->log(arena) << "Switching to full precision" << endl;
+    #endif
+
+    single = false;
+}
+
+template <typename U>
+void CCSD<U>::writeCheckpoint(Checkpoint& chk)
+{
+    chk.writeAll(single);
+
+    #ifdef ENABLE_SINGLE_PRECISION
+    if (single)
+    {
+        chk.writeAll(single_last);
+        this->template gettmp<ExcitationOperator<float,2>>("single.T").write(chk);
+        this->template gettmp<convergence::DIIS<ExcitationOperator<float,2>>>("single.DIIS").write(chk);
+        return;
+    }
+    #endif
+
+    this->template get<ExcitationOperator<U,2>>("T").write(chk);
+    diis.write(chk);
+}
+
+template <typename U>
+void CCSD<U>::readCheckpoint(const Arena& arena, Checkpoint& chk)
+{
+    bool was_single;
+    chk.readAll(was_single);
+
+    #ifdef ENABLE_SINGLE_PRECISION
+    if (was_single && single)
+    {
+        auto& T = this->template gettmp<ExcitationOperator<float,2>>("single.T");
+        auto& Z = this->template gettmp<ExcitationOperator<float,2>>("single.Z");
+
+        chk.readAll(single_last);
+        T.read(chk);
+        this->template gettmp<convergence::DIIS<ExcitationOperator<float,2>>>("single.DIIS").read(chk, T, Z);
+        return;
+    }
+    #endif
+
+    if (was_single)
+        throw runtime_error("CCSD checkpoint was written in single precision");
+
+    /*
+     * The checkpoint was written after switching to full precision
+     */
+    if (single) promote(arena);
+
+    auto& T = this->template get   <ExcitationOperator<U,2>>("T");
+    auto& Z = this->template gettmp<ExcitationOperator<U,2>>("Z");
+
+    T.read(chk);
+    diis.read(chk, T, Z);
+}
+
+template <typename U>
+void CCSD<U>::iterate(const Arena& arena)
+{
+    #ifdef ENABLE_SINGLE_PRECISION
+    if (single)
+    {
+        iterate(arena, this->template gettmp<TwoElectronOperator<float>>("single.H"),
+                       this->template gettmp<ExcitationOperator<float,2>>("single.T"),
+                       this->template gettmp<convergence::DIIS<ExcitationOperator<float,2>>>("single.DIIS"),
+                       "single.");
+
+        if (this->conv() >= single_conv && this->conv() < single_last && !this->isConverged())
+        {
+            single_last = this->conv();
+            return;
+        }
+
+        /*
+         * Follow up with a full-precision iteration straight away, so that
+         * a single-precision iteration can never end the calculation (e.g.
+         * when convergence is looser than single_precision_convergence)
+         */
+        promote(arena);
+    }
+    #endif
+
+    iterate(arena, this->template get<TwoElectronOperator<U>>("H"),
+                   this->template get<ExcitationOperator<U,2>>("T"),
+                   diis, "");
+}
+
+template <typename U>
+template <typename V>
+void CCSD<U>::iterate(const Arena& arena, const TwoElectronOperator<V>& H,
+                      ExcitationOperator<V,2>& T,
+                      convergence::DIIS<ExcitationOperator<V,2>>& diis,
+                      const string& prefix)
+{
+    const SpinorbitalTensor<V>&   fAI =   H.getAI();
+    const SpinorbitalTensor<V>&   fME =   H.getIA();
+    const SpinorbitalTensor<V>&   fAE =   H.getAB();
+    const SpinorbitalTensor<V>&   fMI =   H.getIJ();
+    const SpinorbitalTensor<V>& VABIJ = H.getABIJ();
+    const SpinorbitalTensor<V>& VMNEF = H.getIJAB();
+    const SpinorbitalTensor<V>& VAMEF = H.getAIBC();
+    const SpinorbitalTensor<V>& VABEJ = H.getABCI();
+    const SpinorbitalTensor<V>& VABEF = H.getABCD();
+    const SpinorbitalTensor<V>& VMNIJ = H.getIJKL();
+    const SpinorbitalTensor<V>& VMNEJ = H.getIJAK();
+    const SpinorbitalTensor<V>& VAMIJ = H.getAIJK();
+    const SpinorbitalTensor<V>& VAMEI = H.getAIBJ();
+
+    auto& D   = this->template gettmp<Denominator       <V  >>(prefix+  "D");
+    auto& Z   = this->template gettmp<ExcitationOperator<V,2>>(prefix+  "Z");
+    auto& Tau = this->template gettmp<SpinorbitalTensor <V  >>(prefix+"Tau");
+
+    auto&   FME = this->template gettmp<SpinorbitalTensor<V>>(prefix+  "FME");
+    auto&   FAE = this->template gettmp<SpinorbitalTensor<V>>(prefix+  "FAE");
+    auto&   FMI = this->template gettmp<SpinorbitalTensor<V>>(prefix+  "FMI");
+    auto& WMNIJ = this->template gettmp<SpinorbitalTensor<V>>(prefix+"WMNIJ");
+    auto& WMNEJ = this->template gettmp<SpinorbitalTensor<V>>(prefix+"WMNEJ");
+    auto& WAMIJ = this->template gettmp<SpinorbitalTensor<V>>(prefix+"WAMIJ");
+    auto& WAMEI = this->template gettmp<SpinorbitalTensor<V>>(prefix+"WAMEI");
 
     Tau["abij"]  = T(2)["abij"];
     Tau["abij"] += 0.5*T(1)["ai"]*T(1)["bj"];
 
+    PROFILE_SECTION(ccsd_intermediates)
+
     /**************************************************************************
      *
      * Intermediates for CCSD
@@ -158,6 +387,10 @@ void CCSD<U>::iterate(const Arena& arena)
     /*
      *************************************************************************/
 
+    PROFILE_STOP
+
+    PROFILE_SECTION(ccsd_residual)
+
     /**************************************************************************
      *
      * CCSD Iteration
@@ -181,6 +414,8 @@ void CCSD<U>::iterate(const Arena& arena)
     /*
      *************************************************************************/
 
+    PROFILE_STOP
+
     Z.weight(D);
     T += Z;
 
@@ -189,7 +424,9 @@ void CCSD<U>::iterate(const Arena& arena)
     this->energy() = real(scalar(H.getAI()*T(1))) + 0.25*real(scalar(H.getABIJ()*Tau));
     this->conv() = Z.norm(00);
 
+    PROFILE_SECTION(ccsd_diis)
     diis.extrapolate(T, Z);
+    PROFILE_STOP
 }
 
 /*
@@ -272,6 +509,18 @@ max_iterations?
     int 50,
 conv_type?
     enum { MAXE, RMSE, MAE },
+guess?
+    enum { mp2, ccsd, file },
+guess_file?
+    string,
+save_guess?
+    string,
+mixed_precision?
+    bool false,
+single_precision_convergence?
+    double 1e-5,
+implicit_hbar?
+    bool false,
 diis?
 {
     damping?
@@ -6,6 +6,7 @@
 #include "time/time.hpp"
 #include "task/task.hpp"
 #include "util/iterative.hpp"
+#include "operator/space.hpp"
 #include "operator/2eoperator.hpp"
 #include "operator/excitationoperator.hpp"
 #include "operator/st2eoperator.hpp"
@@ -17,11 +18,209 @@ namespace aquarius
 namespace cc
 {
 
+/*
+ * Save the amplitudes of T together with the orbitals they refer to, for
+ * use as a guess by readAmplitudeGuess (e.g. at the next point of a scan)
+ */
+template <typename U, int N>
+void writeAmplitudeGuess(const string& file, const op::MOSpace<U>& occ, const op::MOSpace<U>& vrt,
+                         const op::ExcitationOperator<U,N>& T)
+{
+    task::Checkpoint chk(occ.arena, file, task::Checkpoint::WRITE);
+
+    chk.writeAll(N);
+    occ.Calpha.write(chk);
+    occ.Cbeta.write(chk);
+    vrt.Calpha.write(chk);
+    vrt.Cbeta.write(chk);
+
+    for (int i = 0;i <= N;i++) T(i).write(chk);
+}
+
+/*
+ * Write into P the signed permutation which takes the orbitals C0 of the
+ * guess onto the current orbitals C, found from their overlap C0^T S C. Each
+ * current orbital is matched to the old orbital of the same irrep with which
+ * it has the largest overlap, taking its sign; orbitals which have rotated
+ * too far to be matched one-to-one are an error. P(new,old) is stored if
+ * newold is true, P(old,new) otherwise.
+ */
+template <typename U>
+void matchOrbitals(const tensor::SymmetryBlockedTensor<U>& S,
+                   const tensor::SymmetryBlockedTensor<U>& C0,
+                   const tensor::SymmetryBlockedTensor<U>& C,
+                   tensor::SymmetryBlockedTensor<U>& P, bool newold)
+{
+    const Arena& arena = C.arena;
+    const symmetry::PointGroup& group = C.getGroup();
+
+    const vector<int>& nao = C.getLengths()[0];
+    const vector<int>& nmo = C.getLengths()[1];
+
+    tensor::SymmetryBlockedTensor<U> SC("SC", arena, group, 2, {nao,nmo}, {NS,NS}, false);
+    tensor::SymmetryBlockedTensor<U>  M( "M", arena, group, 2, {nmo,nmo}, {NS,NS}, false);
+
+    SC["pi"] = S["pq"]*C["qi"];
+    M["ji"] = C0["pj"]*SC["pi"];
+
+    for (int h = 0;h < group.getNumIrreps();h++)
+    {
+        int n = nmo[h];
+
+        vector<U> overlap;
+        M.getAllData({h,h}, overlap);
+
+        vector<bool> used(n, false);
+        vector<tkv_pair<U>> pairs;
+
+        for (int i = 0;i < n;i++)
+        {
+            int j = 0;
+            for (int k = 1;k < n;k++)
+            {
+                if (aquarius::abs(overlap[i*n+k]) > aquarius::abs(overlap[i*n+j])) j = k;
+            }
+
+            if (used[j] || aquarius::abs(overlap[i*n+j]) < 0.5)
+                throw runtime_error("Orbitals of the amplitude guess cannot be matched to the current orbitals");
+            used[j] = true;
+
+            U sign = (overlap[i*n+j] < 0 ? -1 : 1);
+            if (arena.rank == 0) pairs.emplace_back(newold ? j*n+i : i*n+j, sign);
+        }
+
+        P.writeRemoteData({h,h}, pairs);
+    }
+}
+
+/*
+ * Transform the n-fold excitation amplitudes T by Pv(new,old) on each
+ * virtual index and Po(old,new) on each occupied index. The indices are
+ * moved one at a time into a separate space of the intermediates, so that
+ * only indices which have already been transformed are antisymmetrized
+ * together; adding the k'th index to that group then produces each term
+ * k times.
+ */
+template <typename U>
+void permuteAmplitudes(const op::Space& occ, const op::Space& vrt,
+                       const tensor::SpinorbitalTensor<U>& Pv,
+                       const tensor::SpinorbitalTensor<U>& Po,
+                       int n, tensor::SpinorbitalTensor<U>& T)
+{
+    assert(n > 0 && n <= 4);
+
+    const Arena& arena = T.arena;
+    const symmetry::PointGroup& group = occ.group;
+
+    string v = string("abcd").substr(0, n);
+    string o = string("ijkl").substr(0, n);
+
+    unique_ptr<tensor::SpinorbitalTensor<U>> Y;
+
+    for (int k = 1;k <= n;k++)
+    {
+        unique_ptr<tensor::SpinorbitalTensor<U>> X(new tensor::SpinorbitalTensor<U>("X", arena, group,
+            {vrt, vrt, occ, occ}, {k, n-k, 0, 0}, {0, 0, 0, n}));
+
+        string from = v;
+        from[k-1] = 'e';
+
+        (*X)[v+o] = (1.0/k)*Pv[string(1,v[k-1])+"e"]*(Y ? *Y : T)[from+o];
+        Y = move(X);
+    }
+
+    for (int k = 1;k <= n;k++)
+    {
+        string from = o;
+        from[k-1] = 'm';
+
+        if (k == n)
+        {
+            T[v+o] = (1.0/k)*Po[string("m")+o[k-1]]*(*Y)[v+from];
+            break;
+        }
+
+        unique_ptr<tensor::SpinorbitalTensor<U>> X(new tensor::SpinorbitalTensor<U>("X", arena, group,
+            {vrt, vrt, occ, occ}, {n, 0, 0, 0}, {0, 0, k, n-k}));
+
+        (*X)[v+o] = (1.0/k)*Po[string("m")+o[k-1]]*(*Y)[v+from];
+        Y = move(X);
+    }
+}
+
+/*
+ * Read amplitudes saved by writeAmplitudeGuess (e.g. at a nearby geometry)
+ * into T as an initial guess. The orbitals saved with them are matched to
+ * the current ones by overlap, so that swapped orbitals and changes of
+ * phase between the two calculations are undone. Lower-rank amplitudes are
+ * promoted, leaving the higher excitations in T untouched, and any
+ * higher-rank amplitudes in the file are ignored.
+ */
+template <typename U, int N>
+void readAmplitudeGuess(const string& file, const op::MOSpace<U>& occ, const op::MOSpace<U>& vrt,
+                        const tensor::SymmetryBlockedTensor<U>& S, op::ExcitationOperator<U,N>& T)
+{
+    const Arena& arena = occ.arena;
+    const symmetry::PointGroup& group = occ.group;
+
+    task::Checkpoint chk(arena, file, task::Checkpoint::READ);
+
+    int n;
+    chk.readAll(n);
+
+    tensor::SymmetryBlockedTensor<U> CI("CI", occ.Calpha);
+    tensor::SymmetryBlockedTensor<U> Ci("Ci", occ.Cbeta);
+    tensor::SymmetryBlockedTensor<U> CA("CA", vrt.Calpha);
+    tensor::SymmetryBlockedTensor<U> Ca("Ca", vrt.Cbeta);
+
+    CI.read(chk);
+    Ci.read(chk);
+    CA.read(chk);
+    Ca.read(chk);
+
+    tensor::SpinorbitalTensor<U> Pv("Pv", arena, group, {vrt, occ}, {1,0}, {1,0});
+    tensor::SpinorbitalTensor<U> Po("Po", arena, group, {vrt, occ}, {0,1}, {0,1});
+
+    matchOrbitals(S, CA, vrt.Calpha, Pv({1,0},{1,0}), true);
+    matchOrbitals(S, Ca, vrt.Cbeta,  Pv({0,0},{0,0}), true);
+    matchOrbitals(S, CI, occ.Calpha, Po({0,1},{0,1}), false);
+    matchOrbitals(S, Ci, occ.Cbeta,  Po({0,0},{0,0}), false);
+
+    for (int i = 0;i <= min(n,N);i++)
+    {
+        T(i).read(chk);
+        if (i > 0) permuteAmplitudes(occ, vrt, Pv, Po, i, T(i));
+    }
+
+    task::Logger::log(arena) << "Read initial amplitudes from " << file << endl;
+}
+
 template <typename U>
 class CCSD : public Iterative<U>
 {
     protected:
         convergence::DIIS<op::ExcitationOperator<U,2>> diis;
+        string guess;
+        bool single;
+        double single_conv;
+        double single_last;
+
+        template <typename V>
+        void allocate(const op::TwoElectronOperator<V>& H, const string& prefix);
+
+        template <typename V>
+        void iterate(const Arena& arena, const op::TwoElectronOperator<V>& H,
+                     op::ExcitationOperator<V,2>& T,
+                     convergence::DIIS<op::ExcitationOperator<V,2>>& diis,
+                     const string& prefix);
+
+        void promote(const Arena& arena);
+
+        bool isRestartable() const { return true; }
+
+        void writeCheckpoint(task::Checkpoint& chk);
+
+        void readCheckpoint(const Arena& arena, task::Checkpoint& chk);
 
     public:
         CCSD(const string& name, input::Config& config);
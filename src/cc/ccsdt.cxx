@@ -18,6 +18,13 @@ CCSDT<U>::CCSDT(const string& name, Config& config)
     vector<Requirement> reqs;
     reqs.emplace_back("moints", "H");
     if (guess == "ccsd") reqs.emplace_back("ccsd.T", "Tccsd");
+    if (guess == "file" || config.exists("save_guess"))
+    {
+        reqs.emplace_back("occspace", "occ");
+        reqs.emplace_back("vrtspace", "vrt");
+    }
+    if (guess == "file") reqs.emplace_back("ovi", "S");
+    if (guess == "file" && !config.exists("guess_file")) reqs.emplace_back("Tguess", "guess");
     this->addProduct("double", "mp2", reqs);
     this->addProduct("double", "energy", reqs);
     this->addProduct("double", "convergence", reqs);
@@ -25,6 +32,7 @@ CCSDT<U>::CCSDT(const string& name, Config& config)
     this->addProduct("double", "multiplicity", reqs);
     this->addProduct("ccsdt.T", "T", reqs);
     this->addProduct("ccsdt.Hbar", "Hbar", reqs);
+    if (config.exists("save_guess")) this->addProduct("Tguess", "saved_guess", reqs);
 }
 
 template <typename U>
@@ -72,6 +80,19 @@ bool CCSDT<U>::run(task::TaskDAG& dag, const Arena& arena)
         T(1) = Tccsd(1);
         T(2) = Tccsd(2);
     }
+    else if (guess == "file")
+    {
+        /*
+         * Without guess_file, read the file saved by the task hooked up to
+         * "guess", e.g. "using guess from other.ccsd:saved_guess"
+         */
+        string file = (this->config.exists("guess_file") ? this->config.template get<string>("guess_file")
+                                                         : this->template get<string>("guess"));
+        readAmplitudeGuess(file,
+                           this->template get<MOSpace<U>>("occ"),
+                           this->template get<MOSpace<U>>("vrt"),
+                           this->template get<SymmetryBlockedTensor<U>>("S"), T);
+    }
 
     CTF_Timer_epoch ep(this->name.c_str());
     ep.begin();
@@ -81,6 +102,14 @@ bool CCSDT<U>::run(task::TaskDAG& dag, const Arena& arena)
     this->put("energy", new U(this->energy()));
     this->put("convergence", new U(this->conv()));
 
+    if (this->config.exists("save_guess"))
+    {
+        writeAmplitudeGuess(this->config.template get<string>("save_guess"),
+                            this->template get<MOSpace<U>>("occ"),
+                            this->template get<MOSpace<U>>("vrt"), T);
+        this->put("saved_guess", new string(this->config.template get<string>("save_guess")));
+    }
+
     /*
     if (isUsed("S2") || isUsed("multiplicity"))
     {
@@ -236,13 +265,7 @@ void CCSDT<U>::iterate(const Arena& arena)
     Z(2)[  "abij"] -=  0.5*WMNEJ["mnej"]*T(3)["abeinm"];
     Z(2)[  "abij"] +=        FME[  "me"]*T(3)["abeijm"];
 
-    Z(3)["abcijk"]  =      WABEJ["bcek"]*T(2)[  "aeij"];
-    Z(3)["abcijk"] -=      WAMIJ["bmjk"]*T(2)[  "acim"];
-    Z(3)["abcijk"] +=        FAE[  "ce"]*T(3)["abeijk"];
-    Z(3)["abcijk"] -=        FMI[  "mk"]*T(3)["abcijm"];
-    Z(3)["abcijk"] +=  0.5*WABEF["abef"]*T(3)["efcijk"];
-    Z(3)["abcijk"] +=  0.5*WMNIJ["mnij"]*T(3)["abcmnk"];
-    Z(3)["abcijk"] +=      WAMEI["amei"]*T(3)["ebcjmk"];
+    #include "cc/ccsdt_t3.inc"
     /*
      **************************************************************************/
 
@@ -257,6 +280,23 @@ void CCSDT<U>::iterate(const Arena& arena)
     diis.extrapolate(T, Z);
 }
 
+template <typename U>
+void CCSDT<U>::writeCheckpoint(Checkpoint& chk)
+{
+    this->template get<ExcitationOperator<U,3>>("T").write(chk);
+    diis.write(chk);
+}
+
+template <typename U>
+void CCSDT<U>::readCheckpoint(const Arena& arena, Checkpoint& chk)
+{
+    auto& T = this->template get   <ExcitationOperator<U,3>>("T");
+    auto& Z = this->template gettmp<ExcitationOperator<U,3>>("Z");
+
+    T.read(chk);
+    diis.read(chk, T, Z);
+}
+
 /*
 template <typename U>
 double CCSDT<U>::getProjectedS2() const
@@ -283,7 +323,11 @@ max_iterations?
 conv_type?
     enum { MAXE, RMSE, MAE },
 guess?
-    enum { mp2, ccsd },
+    enum { mp2, ccsd, file },
+guess_file?
+    string,
+save_guess?
+    string,
 diis?
 {
     damping?
@@ -24,6 +24,12 @@ class CCSDT : public Iterative<U>
         convergence::DIIS<op::ExcitationOperator<U,3>> diis;
         string guess;
 
+        bool isRestartable() const { return true; }
+
+        void writeCheckpoint(task::Checkpoint& chk);
+
+        void readCheckpoint(const Arena& arena, task::Checkpoint& chk);
+
     public:
         CCSDT(const string& name, input::Config& config);
 
@@ -21,6 +21,8 @@ class CCSDT_Q_N : public task::Task
         CCSDT_Q_N(const string& name, input::Config& config);
 
         bool run(task::TaskDAG& dag, const Arena& arena);
+
+        int64_t getMemoryEstimate(const Arena& arena);
 };
 
 }
@@ -71,7 +71,12 @@ bool CCSDT_Q_N_opt<U>::run(task::TaskDAG& dag, const Arena& arena)
     DeexcitationOperator<U,4> L_1("L^(1)", arena, occ, vrt);
     DeexcitationOperator<U,4> L_2("L^(2)", arena, occ, vrt);
 
-    ExcitationOperator<U,4> Z("Z", arena, occ, vrt);
+    /*
+     * The quadruples part of T^(4) is only needed for E(6), so once that is
+     * taken it holds the quadruples part of each [[H,T^(m)],T^(n)] term
+     * instead, and Z only needs up to triples
+     */
+    ExcitationOperator<U,3> Z("Z", arena, occ, vrt);
 
     SpinorbitalTensor<U> WABCEJK_1(WABCEJK);
     SpinorbitalTensor<U> WABMIJK_1(WABMIJK);
@@ -615,15 +620,15 @@ bool CCSDT_Q_N_opt<U>::run(task::TaskDAG& dag, const Arena& arena)
      *
      **************************************************************************/
 
-    Z(4)["abcdijkl"]  =   WABCEJK_1["abcejk"]*T_3(2)[    "edil"];
-    Z(4)["abcdijkl"] -=   WABMIJK_1["abmijk"]*T_3(2)[    "cdml"];
-    Z(4)["abcdijkl"] +=       FAE_3[    "ae"]*T_1(4)["ebcdijkl"];
-    Z(4)["abcdijkl"] -=       FMI_3[    "mi"]*T_1(4)["abcdmjkl"];
-    Z(4)["abcdijkl"] += 0.5*WABEF_3[  "abef"]*T_1(4)["efcdijkl"];
-    Z(4)["abcdijkl"] += 0.5*WMNIJ_3[  "mnij"]*T_1(4)["abcdmnkl"];
-    Z(4)["abcdijkl"] +=     WAMEI_3[  "amei"]*T_1(4)["ebcdjmkl"];
+    T_4(4)["abcdijkl"]  =   WABCEJK_1["abcejk"]*T_3(2)[    "edil"];
+    T_4(4)["abcdijkl"] -=   WABMIJK_1["abmijk"]*T_3(2)[    "cdml"];
+    T_4(4)["abcdijkl"] +=       FAE_3[    "ae"]*T_1(4)["ebcdijkl"];
+    T_4(4)["abcdijkl"] -=       FMI_3[    "mi"]*T_1(4)["abcdmjkl"];
+    T_4(4)["abcdijkl"] += 0.5*WABEF_3[  "abef"]*T_1(4)["efcdijkl"];
+    T_4(4)["abcdijkl"] += 0.5*WMNIJ_3[  "mnij"]*T_1(4)["abcdmnkl"];
+    T_4(4)["abcdijkl"] +=     WAMEI_3[  "amei"]*T_1(4)["ebcdjmkl"];
 
-    U E1113 = (1.0/576.0)*scalar(L_1(4)["mnopefgh"]*Z(4)["efghmnop"]);
+    U E1113 = (1.0/576.0)*scalar(L_1(4)["mnopefgh"]*T_4(4)["efghmnop"]);
 
     /***************************************************************************
      *               _
@@ -669,21 +674,21 @@ bool CCSDT_Q_N_opt<U>::run(task::TaskDAG& dag, const Arena& arena)
 
       WABEJ_2[    "abej"] -=           FME[    "me"]*T_2(2)[    "abmj"];
 
-         Z(4)["abcdijkl"]  =     WABCEJK_2["abcejk"]*T_2(2)[    "edil"];
-         Z(4)["abcdijkl"] -=     WABMIJK_2["abmijk"]*T_2(2)[    "cdml"];
-         Z(4)["abcdijkl"] +=       WABEJ_2[  "abej"]*T_2(3)[  "ecdikl"];
-         Z(4)["abcdijkl"] -=       WAMIJ_2[  "amij"]*T_2(3)[  "bcdmkl"];
-         Z(4)["abcdijkl"] += 0.5*WAMNIJK_2["amnijk"]*T_2(3)[  "bcdmnl"];
-         Z(4)["abcdijkl"] -=     WABMEJI_2["abmeji"]*T_2(3)[  "ecdmkl"];
-         Z(4)["abcdijkl"] +=         FAE_2[    "ae"]*T_2(4)["ebcdijkl"];
-         Z(4)["abcdijkl"] -=         FMI_2[    "mi"]*T_2(4)["abcdmjkl"];
-         Z(4)["abcdijkl"] +=   0.5*WABEF_2[  "abef"]*T_2(4)["efcdijkl"];
-         Z(4)["abcdijkl"] +=   0.5*WMNIJ_2[  "mnij"]*T_2(4)["abcdmnkl"];
-         Z(4)["abcdijkl"] +=       WAMEI_2[  "amei"]*T_2(4)["ebcdjmkl"];
+       T_4(4)["abcdijkl"]  =     WABCEJK_2["abcejk"]*T_2(2)[    "edil"];
+       T_4(4)["abcdijkl"] -=     WABMIJK_2["abmijk"]*T_2(2)[    "cdml"];
+       T_4(4)["abcdijkl"] +=       WABEJ_2[  "abej"]*T_2(3)[  "ecdikl"];
+       T_4(4)["abcdijkl"] -=       WAMIJ_2[  "amij"]*T_2(3)[  "bcdmkl"];
+       T_4(4)["abcdijkl"] += 0.5*WAMNIJK_2["amnijk"]*T_2(3)[  "bcdmnl"];
+       T_4(4)["abcdijkl"] -=     WABMEJI_2["abmeji"]*T_2(3)[  "ecdmkl"];
+       T_4(4)["abcdijkl"] +=         FAE_2[    "ae"]*T_2(4)["ebcdijkl"];
+       T_4(4)["abcdijkl"] -=         FMI_2[    "mi"]*T_2(4)["abcdmjkl"];
+       T_4(4)["abcdijkl"] +=   0.5*WABEF_2[  "abef"]*T_2(4)["efcdijkl"];
+       T_4(4)["abcdijkl"] +=   0.5*WMNIJ_2[  "mnij"]*T_2(4)["abcdmnkl"];
+       T_4(4)["abcdijkl"] +=       WAMEI_2[  "amei"]*T_2(4)["ebcdjmkl"];
 
     U E0122 = (1.0/  4.0)*scalar(  L(2)[    "mnef"]*Z(2)[    "efmn"])+
               (1.0/ 36.0)*scalar(  L(3)[  "mnoefg"]*Z(3)[  "efgmno"]);
-    U E1122 = (1.0/576.0)*scalar(L_1(4)["mnopefgh"]*Z(4)["efghmnop"]);
+    U E1122 = (1.0/576.0)*scalar(L_1(4)["mnopefgh"]*T_4(4)["efghmnop"]);
 
     this->log(arena) << printos("\n");
     this->log(arena) << printos("CCSDT(Q-2): %18.15f\n", E2);
@@ -735,6 +740,17 @@ bool CCSDT_Q_N_opt<U>::run(task::TaskDAG& dag, const Arena& arena)
     return true;
 }
 
+template <typename U>
+int64_t CCSDT_Q_N_opt<U>::getMemoryEstimate(const Arena& arena)
+{
+    const auto& H = this->template get<TwoElectronOperator<U>>("H");
+
+    /*
+     * Four orders of T and two of L
+     */
+    return 6*ExcitationOperator<U,4>::estimateSize(arena, H.occ, H.vrt);
+}
+
 }
 }
 
@@ -21,6 +21,8 @@ class CCSDT_Q_N_opt : public task::Task
         CCSDT_Q_N_opt(const string& name, input::Config& config);
 
         bool run(task::TaskDAG& dag, const Arena& arena);
+
+        int64_t getMemoryEstimate(const Arena& arena);
 };
 
 }
@@ -19,6 +19,13 @@ CCSDTQ<U>::CCSDTQ(const string& name, Config& config)
     reqs.push_back(Requirement("moints", "H"));
     if      (guess ==  "ccsd") reqs.emplace_back( "ccsd.T",  "Tccsd");
     else if (guess == "ccsdt") reqs.emplace_back("ccsdt.T", "Tccsdt");
+    if (guess == "file" || config.exists("save_guess"))
+    {
+        reqs.emplace_back("occspace", "occ");
+        reqs.emplace_back("vrtspace", "vrt");
+    }
+    if (guess == "file") reqs.emplace_back("ovi", "S");
+    if (guess == "file" && !config.exists("guess_file")) reqs.emplace_back("Tguess", "guess");
     this->addProduct(Product("double", "mp2", reqs));
     this->addProduct(Product("double", "energy", reqs));
     this->addProduct(Product("double", "convergence", reqs));
@@ -26,6 +33,7 @@ CCSDTQ<U>::CCSDTQ(const string& name, Config& config)
     this->addProduct(Product("double", "multiplicity", reqs));
     this->addProduct(Product("ccsdtq.T", "T", reqs));
     this->addProduct(Product("ccsdtq.Hbar", "Hbar", reqs));
+    if (config.exists("save_guess")) this->addProduct(Product("Tguess", "saved_guess", reqs));
 }
 
 template <typename U>
@@ -98,6 +106,19 @@ bool CCSDTQ<U>::run(task::TaskDAG& dag, const Arena& arena)
         T(2) = Tccsdt(2);
         T(3) = Tccsdt(3);
     }
+    else if (guess == "file")
+    {
+        /*
+         * Without guess_file, read the file saved by the task hooked up to
+         * "guess", e.g. "using guess from other.ccsd:saved_guess"
+         */
+        string file = (this->config.exists("guess_file") ? this->config.template get<string>("guess_file")
+                                                         : this->template get<string>("guess"));
+        readAmplitudeGuess(file,
+                           this->template get<MOSpace<U>>("occ"),
+                           this->template get<MOSpace<U>>("vrt"),
+                           this->template get<SymmetryBlockedTensor<U>>("S"), T);
+    }
 
     CTF_Timer_epoch ep(this->name.c_str());
     ep.begin();
@@ -107,6 +128,14 @@ bool CCSDTQ<U>::run(task::TaskDAG& dag, const Arena& arena)
     this->put("energy", new U(this->energy()));
     this->put("convergence", new U(this->conv()));
 
+    if (this->config.exists("save_guess"))
+    {
+        writeAmplitudeGuess(this->config.template get<string>("save_guess"),
+                            this->template get<MOSpace<U>>("occ"),
+                            this->template get<MOSpace<U>>("vrt"), T);
+        this->put("saved_guess", new string(this->config.template get<string>("save_guess")));
+    }
+
     /*
     if (isUsed("S2") || isUsed("multiplicity"))
     {
@@ -126,6 +155,18 @@ bool CCSDTQ<U>::run(task::TaskDAG& dag, const Arena& arena)
     return true;
 }
 
+template <typename U>
+int64_t CCSDTQ<U>::getMemoryEstimate(const Arena& arena)
+{
+    const auto& H = this->template get<TwoElectronOperator<U>>("H");
+
+    /*
+     * T and Z plus the DIIS history of amplitudes and residuals
+     */
+    int order = this->config.template get<int>("diis.order");
+    return (2+2*order)*ExcitationOperator<U,4>::estimateSize(arena, H.occ, H.vrt);
+}
+
 template <typename U>
 void CCSDTQ<U>::iterate(const Arena& arena)
 {
@@ -334,6 +375,23 @@ void CCSDTQ<U>::iterate(const Arena& arena)
     diis.extrapolate(T, Z);
 }
 
+template <typename U>
+void CCSDTQ<U>::writeCheckpoint(Checkpoint& chk)
+{
+    this->template get<ExcitationOperator<U,4>>("T").write(chk);
+    diis.write(chk);
+}
+
+template <typename U>
+void CCSDTQ<U>::readCheckpoint(const Arena& arena, Checkpoint& chk)
+{
+    auto& T = this->template get   <ExcitationOperator<U,4>>("T");
+    auto& Z = this->template gettmp<ExcitationOperator<U,4>>("Z");
+
+    T.read(chk);
+    diis.read(chk, T, Z);
+}
+
 /*
 template <typename U>
 double CCSDTQ<U>::getProjectedS2() const
@@ -360,7 +418,11 @@ max_iterations?
 conv_type?
     enum { MAXE, RMSE, MAE },
 guess?
-    enum { mp2, ccsd, ccsdt },
+    enum { mp2, ccsd, ccsdt, file },
+guess_file?
+    string,
+save_guess?
+    string,
 diis?
 {
     damping?
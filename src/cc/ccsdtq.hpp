@@ -24,11 +24,19 @@ class CCSDTQ : public Iterative<U>
         convergence::DIIS<op::ExcitationOperator<U,4>> diis;
         string guess;
 
+        bool isRestartable() const { return true; }
+
+        void writeCheckpoint(task::Checkpoint& chk);
+
+        void readCheckpoint(const Arena& arena, task::Checkpoint& chk);
+
     public:
         CCSDTQ(const string& name, input::Config& config);
 
         bool run(task::TaskDAG& dag, const Arena& arena);
 
+        int64_t getMemoryEstimate(const Arena& arena);
+
         void iterate(const Arena& arena);
 
         /*
@@ -316,7 +316,6 @@ void EOMEECCSD<U>::iterate(const Arena& arena)
     const SpinorbitalTensor<U>& WMNEF = H.getIJAB();
     const SpinorbitalTensor<U>& WAMEF = H.getAIBC();
     const SpinorbitalTensor<U>& WABEJ = H.getABCI();
-    const SpinorbitalTensor<U>& WABEF = H.getABCD();
     const SpinorbitalTensor<U>& WMNIJ = H.getIJKL();
     const SpinorbitalTensor<U>& WMNEJ = H.getIJAK();
     const SpinorbitalTensor<U>& WAMIJ = H.getAIJK();
@@ -367,7 +366,7 @@ void EOMEECCSD<U>::iterate(const Arena& arena)
         Z(2)["abij"] +=       XAE[  "ae"]*T(2)["ebij"];
         Z(2)["abij"] -=       XMI[  "mi"]*T(2)["abmj"];
         Z(2)["abij"] += 0.5*WMNIJ["mnij"]*R(2)["abmn"];
-        Z(2)["abij"] += 0.5*WABEF["abef"]*R(2)["efij"];
+        H.contractABCD(0.5, R(2), Z(2));
         Z(2)["abij"] -=     WAMEI["amei"]*R(2)["ebmj"];
     }
 
@@ -0,0 +1,382 @@
+#include "gradient.hpp"
+
+#include "integrals/derivatives.hpp"
+#include "integrals/ovi.hpp"
+#include "integrals/kei.hpp"
+#include "integrals/nai.hpp"
+#include "integrals/os.hpp"
+
+using namespace aquarius::op;
+using namespace aquarius::input;
+using namespace aquarius::tensor;
+using namespace aquarius::task;
+using namespace aquarius::symmetry;
+using namespace aquarius::integrals;
+
+namespace aquarius
+{
+namespace cc
+{
+
+/*
+ * Contract the x, y, and z derivatives of the integrals over shells a and b
+ * with the AO matrix P
+ */
+static void contract1e(const vector<double>& ints, const Shell& a, const Shell& b,
+                       const vector<int>& aoa, const vector<int>& aob,
+                       const vector<double>& P, int nao, double* g)
+{
+    size_t nint = ints.size()/3;
+    int fsa = a.getNFunc(), ma = a.getNContr();
+    int fsb = b.getNFunc(), mb = b.getNContr();
+
+    for (int xyz = 0;xyz < 3;xyz++)
+    {
+        const double* d = ints.data()+xyz*nint;
+
+        double sum = 0;
+        size_t m = 0;
+        for (int j = 0;j < fsb;j++)
+        {
+            for (int i = 0;i < fsa;i++)
+            {
+                for (int f = 0;f < mb;f++)
+                {
+                    for (int e = 0;e < ma;e++)
+                    {
+                        sum += P[aoa[i*ma+e]+(size_t)nao*aob[j*mb+f]]*d[m++];
+                    }
+                }
+            }
+        }
+
+        g[xyz] = sum;
+    }
+}
+
+Gradient::Gradient(const string& name, Config& config)
+: Task(name, config)
+{
+    vector<Requirement> reqs;
+    reqs.emplace_back("molecule", "molecule");
+    reqs.emplace_back("Da", "Da");
+    reqs.emplace_back("Db", "Db");
+    reqs.emplace_back("Fa", "Fa");
+    reqs.emplace_back("Fb", "Fb");
+    addProduct("gradient", "gradient", reqs);
+}
+
+bool Gradient::run(TaskDAG& dag, const Arena& arena)
+{
+    const auto& molecule = get<Molecule>("molecule");
+    const PointGroup& group = molecule.getGroup();
+
+    if (group.getOrder() != 1)
+        throw runtime_error("The native gradient requires C1 symmetry (use subgroup = C1)");
+
+    auto& Da = get<SymmetryBlockedTensor<double>>("Da");
+    auto& Db = get<SymmetryBlockedTensor<double>>("Db");
+    auto& Fa = get<SymmetryBlockedTensor<double>>("Fa");
+    auto& Fb = get<SymmetryBlockedTensor<double>>("Fb");
+
+    const vector<int>& N = molecule.getNumOrbitals();
+    int nao = N[0];
+
+    Context ctx(Context::ISCF);
+    vector<vector<int>> idx = Shell::setupIndices(ctx, molecule);
+    vector<Shell> shells(molecule.getShellsBegin(), molecule.getShellsEnd());
+    int nshell = shells.size();
+
+    vector<Center> centers;
+    vector<int> atom;
+    for (auto& a : molecule.getAtoms())
+    {
+        for (auto s = a.getShellsBegin();s != a.getShellsEnd();++s) atom.push_back(centers.size());
+        centers.push_back(a.getCenter());
+    }
+    int natom = centers.size();
+
+    /*
+     * AO index of each function i and contraction e of each shell, at i*ncontr+e
+     */
+    vector<vector<int>> ao(nshell);
+    for (int s = 0;s < nshell;s++)
+    {
+        for (int i = 0;i < shells[s].getNFunc();i++)
+        {
+            for (int e = 0;e < shells[s].getNContr();e++)
+            {
+                ao[s].push_back(shells[s].getIndex(ctx, idx[s], i, e, 0));
+            }
+        }
+    }
+
+    vector<double> grad(3*natom, 0.0);
+
+    /*
+     * Nuclear repulsion
+     */
+    if (arena.rank == 0)
+    {
+        for (int a = 0;a < natom;a++)
+        {
+            for (int b = 0;b < a;b++)
+            {
+                vec3 r = centers[a].getCenter(0)-centers[b].getCenter(0);
+                double f = centers[a].getElement().getCharge()*
+                           centers[b].getElement().getCharge()/pow(norm(r), 3);
+
+                for (int xyz = 0;xyz < 3;xyz++)
+                {
+                    grad[3*a+xyz] -= f*r[xyz];
+                    grad[3*b+xyz] += f*r[xyz];
+                }
+            }
+        }
+    }
+
+    CTFTensor<double> P("P", Da({0,0}));
+    P["uv"] += Db({0,0})["uv"];
+
+    /*
+     * Energy-weighted density, W = D F D for each spin
+     */
+    SymmetryBlockedTensor<double> W("W", arena, group, 2, {N,N}, {NS,NS}, false);
+    {
+        SymmetryBlockedTensor<double> FD("FD", arena, group, 2, {N,N}, {NS,NS}, false);
+        FD["pq"]  = Fa["pr"]*Da["rq"];
+        W["pq"]   = Da["pr"]*FD["rq"];
+        FD["pq"]  = Fb["pr"]*Db["rq"];
+        W["pq"]  += Db["pr"]*FD["rq"];
+    }
+
+    vector<double> w, p, da, db;
+    W.getAllData({0,0}, w);
+    P.getAllData(p);
+    Da.getAllData({0,0}, da);
+    Db.getAllData({0,0}, db);
+
+    /*
+     * One-electron terms
+     */
+    {
+        OneElectronDerivatives::Kernel ovi =
+            [](const Shell& a, const Shell& b) { return new IshidaOVI(a, b); };
+        OneElectronDerivatives::Kernel kei =
+            [](const Shell& a, const Shell& b) { return new IshidaKEI(a, b); };
+
+        int64_t block = 0;
+        for (int a = 0;a < nshell;a++)
+        {
+            for (int b = 0;b <= a;b++)
+            {
+                if (block++%arena.size != arena.rank) continue;
+
+                double fac = (a == b ? 1.0 : 2.0);
+                double g[3], h[3];
+
+                /*
+                 * Overlap and kinetic energy derivatives with respect to b
+                 * are minus those with respect to a
+                 */
+                contract1e(OneElectronDerivatives(shells[a], shells[b], ovi).run(0),
+                           shells[a], shells[b], ao[a], ao[b], w, nao, g);
+                for (int xyz = 0;xyz < 3;xyz++)
+                {
+                    grad[3*atom[a]+xyz] -= fac*g[xyz];
+                    grad[3*atom[b]+xyz] += fac*g[xyz];
+                }
+
+                contract1e(OneElectronDerivatives(shells[a], shells[b], kei).run(0),
+                           shells[a], shells[b], ao[a], ao[b], p, nao, g);
+                for (int xyz = 0;xyz < 3;xyz++)
+                {
+                    grad[3*atom[a]+xyz] += fac*g[xyz];
+                    grad[3*atom[b]+xyz] -= fac*g[xyz];
+                }
+
+                /*
+                 * Nuclear attraction, one nucleus at a time, with the
+                 * derivative with respect to the nucleus from translational
+                 * invariance
+                 */
+                for (int c = 0;c < natom;c++)
+                {
+                    vector<Center> nucleus(1, centers[c]);
+                    OneElectronDerivatives nai(shells[a], shells[b],
+                        [&nucleus](const Shell& a, const Shell& b) { return new IshidaNAI(a, b, nucleus); });
+
+                    contract1e(nai.run(0), shells[a], shells[b], ao[a], ao[b], p, nao, g);
+                    contract1e(nai.run(1), shells[a], shells[b], ao[a], ao[b], p, nao, h);
+                    for (int xyz = 0;xyz < 3;xyz++)
+                    {
+                        grad[3*atom[a]+xyz] += fac*g[xyz];
+                        grad[3*atom[b]+xyz] += fac*h[xyz];
+                        grad[3*c      +xyz] -= fac*(g[xyz]+h[xyz]);
+                    }
+                }
+            }
+        }
+    }
+
+    /*
+     * Two-electron terms, contracting the derivative ERIs of each shell
+     * quartet directly with the AO two-particle density of the reference,
+     *
+     *  G(mu lambda,nu sigma) = 1/2 P(mu lambda) P(nu sigma)
+     *                        - 1/4 sum_s [D_s(mu nu) D_s(lambda sigma) + D_s(mu sigma) D_s(lambda nu)]
+     *
+     * which is symmetric in mu lambda and in nu sigma, so that only unique
+     * shell pairs are needed
+     */
+    {
+        TwoElectronDerivatives::Kernel eri =
+            [](const Shell& a, const Shell& b, const Shell& c, const Shell& d)
+            { return new OSERI(a, b, c, d); };
+
+        auto G = [&](int mu, int lambda, int nu, int sigma)
+        {
+            auto D = [nao](const vector<double>& d, int i, int j) { return d[i+(size_t)nao*j]; };
+
+            return 0.5*D(p, mu, lambda)*D(p, nu, sigma) -
+                  0.25*(D(da, mu, nu)*D(da, lambda, sigma) + D(da, mu, sigma)*D(da, lambda, nu) +
+                        D(db, mu, nu)*D(db, lambda, sigma) + D(db, mu, sigma)*D(db, lambda, nu));
+        };
+
+        int64_t quartet = 0;
+        for (int a = 0;a < nshell;a++)
+        {
+            for (int b = 0;b <= a;b++)
+            {
+                for (int c = 0;c < nshell;c++)
+                {
+                    for (int d = 0;d <= c;d++)
+                    {
+                        if (quartet++%arena.size != arena.rank) continue;
+
+                        const Shell& sa = shells[a];
+                        const Shell& sb = shells[b];
+                        const Shell& sc = shells[c];
+                        const Shell& sd = shells[d];
+
+                        double fac = (a == b ? 1.0 : 2.0)*(c == d ? 1.0 : 2.0);
+
+                        /*
+                         * Density of each integral, in the order of
+                         * TwoElectronIntegrals::getIntegrals
+                         */
+                        vector<double> dens;
+                        int ma = sa.getNContr(), mb = sb.getNContr();
+                        int mc = sc.getNContr(), md = sd.getNContr();
+                        for (int l = 0;l < sd.getNFunc();l++)
+                        for (int k = 0;k < sc.getNFunc();k++)
+                        for (int j = 0;j < sb.getNFunc();j++)
+                        for (int i = 0;i < sa.getNFunc();i++)
+                        for (int h = 0;h < md;h++)
+                        for (int e4 = 0;e4 < mc;e4++)
+                        for (int f = 0;f < mb;f++)
+                        for (int e = 0;e < ma;e++)
+                        {
+                            dens.push_back(G(ao[a][i*ma+e], ao[b][j*mb+f],
+                                             ao[c][k*mc+e4], ao[d][l*md+h]));
+                        }
+
+                        TwoElectronDerivatives deriv(sa, sb, sc, sd, eri);
+
+                        double total[3] = {0, 0, 0};
+                        int centers4[3] = {atom[a], atom[b], atom[c]};
+
+                        for (int x = 0;x < 3;x++)
+                        {
+                            vector<double> ints = deriv.run(x);
+                            size_t nint = dens.size();
+
+                            for (int xyz = 0;xyz < 3;xyz++)
+                            {
+                                const double* v = ints.data()+xyz*nint;
+                                double sum = 0;
+                                for (size_t m = 0;m < nint;m++) sum += dens[m]*v[m];
+
+                                grad[3*centers4[x]+xyz] += fac*sum;
+                                total[xyz] += fac*sum;
+                            }
+                        }
+
+                        for (int xyz = 0;xyz < 3;xyz++)
+                            grad[3*atom[d]+xyz] -= total[xyz];
+                    }
+                }
+            }
+        }
+    }
+
+    arena.comm().Allreduce(grad.data(), grad.size(), MPI_SUM);
+
+    vector<vec3>* gradient = new vector<vec3>();
+    for (int a = 0;a < natom;a++)
+    {
+        gradient->emplace_back(grad[3*a], grad[3*a+1], grad[3*a+2]);
+        log(arena) << printos("atom %3d: %18.12f %18.12f %18.12f", a+1,
+                              grad[3*a], grad[3*a+1], grad[3*a+2]) << endl;
+    }
+
+    put("gradient", gradient);
+
+    return true;
+}
+
+FiniteDifference::FiniteDifference(const string& name, Config& config)
+: Task(name, config), atom(config.get<int>("atom")), step(config.get<double>("step"))
+{
+    string dir = config.get<string>("direction");
+    direction = (dir == "x" ? 0 : dir == "y" ? 1 : 2);
+
+    if (atom < 1) throw runtime_error("The atom must be at least 1");
+    if (step <= 0) throw runtime_error("The step must be positive");
+
+    vector<Requirement> reqs;
+    reqs.emplace_back("gradient", "gradient");
+    reqs.emplace_back("double", "plus");
+    reqs.emplace_back("double", "minus");
+    addProduct("double", "analytic", reqs);
+    addProduct("double", "numerical", reqs);
+}
+
+bool FiniteDifference::run(TaskDAG& dag, const Arena& arena)
+{
+    const auto& gradient = get<vector<vec3>>("gradient");
+    double plus = get<double>("plus");
+    double minus = get<double>("minus");
+
+    if (atom > (int)gradient.size())
+        throw runtime_error("The molecule has only " + to_string(gradient.size()) + " atoms");
+
+    double analytic = gradient[atom-1][direction];
+    double numerical = (plus-minus)/(2*step);
+
+    log(arena) << printos("analytic: %18.12f numerical: %18.12f", analytic, numerical) << endl;
+
+    put("analytic", new double(analytic));
+    put("numerical", new double(numerical));
+
+    return true;
+}
+
+}
+}
+
+static const char* fd_spec = R"!(
+
+# atom (starting from 1) and direction of the displacement
+atom
+    int,
+direction
+    enum { x, y, z },
+# displacement in bohr of the plus and minus geometries
+step
+    double
+
+)!";
+
+REGISTER_TASK(aquarius::cc::Gradient,"gradient");
+REGISTER_TASK(aquarius::cc::FiniteDifference,"finitedifference",fd_spec);
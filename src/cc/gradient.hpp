@@ -0,0 +1,53 @@
+#ifndef _AQUARIUS_CC_GRADIENT_HPP_
+#define _AQUARIUS_CC_GRADIENT_HPP_
+
+#include "util/global.hpp"
+
+#include "task/task.hpp"
+#include "time/time.hpp"
+#include "input/molecule.hpp"
+
+namespace aquarius
+{
+namespace cc
+{
+
+/*
+ * Nuclear gradient of the UHF reference, contracted directly with
+ * first-derivative integrals. The two-particle density is formed from the AO
+ * densities for each shell quartet as it is needed, so nothing larger than
+ * the AO one-particle densities is stored. Only C1 is supported.
+ *
+ * Gradients of correlated methods would also need the orbital response of
+ * their density (the Z-vector equations), which is not implemented.
+ */
+class Gradient : public task::Task
+{
+    public:
+        Gradient(const string& name, input::Config& config);
+
+        bool run(task::TaskDAG& dag, const Arena& arena);
+};
+
+/*
+ * Central finite difference of the energies at geometries with one atom
+ * displaced by plus and minus step along one axis, alongside the same
+ * component of an analytic gradient, for testing.
+ */
+class FiniteDifference : public task::Task
+{
+    protected:
+        int atom;
+        int direction;
+        double step;
+
+    public:
+        FiniteDifference(const string& name, input::Config& config);
+
+        bool run(task::TaskDAG& dag, const Arena& arena);
+};
+
+}
+}
+
+#endif
@@ -18,9 +18,21 @@ LambdaCCSD<U>::LambdaCCSD(const string& name, Config& config)
     vector<Requirement> reqs;
     reqs.push_back(Requirement("ccsd.Hbar", "Hbar"));
     reqs.push_back(Requirement("ccsd.T", "T"));
+    if (config.get<string>("guess") == "file" || config.exists("save_guess"))
+    {
+        reqs.emplace_back("occspace", "occ");
+        reqs.emplace_back("vrtspace", "vrt");
+    }
+    if (config.get<string>("guess") == "file")
+    {
+        reqs.emplace_back("ovi", "S");
+        if (!config.exists("guess_file")) reqs.emplace_back("Lguess", "guess");
+    }
     this->addProduct(Product("double", "energy", reqs));
     this->addProduct(Product("double", "convergence", reqs));
+    this->addProduct(Product("double", "iterations", reqs));
     this->addProduct(Product("ccsd.L", "L", reqs));
+    if (config.exists("save_guess")) this->addProduct(Product("Lguess", "saved_guess", reqs));
 }
 
 template <typename U>
@@ -47,10 +59,34 @@ bool LambdaCCSD<U>::run(TaskDAG& dag, const Arena& arena)
     L(1)[  "ia"] = T(1)[  "ai"];
     L(2)["ijab"] = T(2)["abij"];
 
+    /*
+     * Start from the converged L of an earlier calculation, e.g. at a
+     * nearby geometry. Without guess_file, read the file saved by the task
+     * hooked up to "guess", e.g. "using guess from other.lambdaccsd:saved_guess"
+     */
+    if (this->config.template get<string>("guess") == "file")
+    {
+        string file = (this->config.exists("guess_file") ? this->config.template get<string>("guess_file")
+                                                         : this->template get<string>("guess"));
+        readAmplitudeGuess(file,
+                           this->template get<MOSpace<U>>("occ"),
+                           this->template get<MOSpace<U>>("vrt"),
+                           this->template get<SymmetryBlockedTensor<U>>("S"), L);
+    }
+
     Iterative<U>::run(dag, arena);
 
     this->put("energy", new U(this->energy()));
     this->put("convergence", new U(this->conv()));
+    this->put("iterations", new U(this->iter()-1));
+
+    if (this->config.exists("save_guess"))
+    {
+        writeAmplitudeGuess(this->config.template get<string>("save_guess"),
+                            this->template get<MOSpace<U>>("occ"),
+                            this->template get<MOSpace<U>>("vrt"), L);
+        this->put("saved_guess", new string(this->config.template get<string>("save_guess")));
+    }
 
     return true;
 }
@@ -66,7 +102,6 @@ void LambdaCCSD<U>::iterate(const Arena& arena)
     const SpinorbitalTensor<U>& WMNEF = H.getIJAB();
     const SpinorbitalTensor<U>& WAMEF = H.getAIBC();
     const SpinorbitalTensor<U>& WABEJ = H.getABCI();
-    const SpinorbitalTensor<U>& WABEF = H.getABCD();
     const SpinorbitalTensor<U>& WMNIJ = H.getIJKL();
     const SpinorbitalTensor<U>& WMNEJ = H.getIJAK();
     const SpinorbitalTensor<U>& WAMIJ = H.getAIJK();
@@ -108,7 +143,7 @@ void LambdaCCSD<U>::iterate(const Arena& arena)
     Z(2)["ijab"] -=     WMNEJ["ijam"]*L(1)[  "mb"];
     Z(2)["ijab"] +=       FAE[  "ea"]*L(2)["ijeb"];
     Z(2)["ijab"] -=       FMI[  "im"]*L(2)["mjab"];
-    Z(2)["ijab"] += 0.5*WABEF["efab"]*L(2)["ijef"];
+    H.contractABCDLeft(0.5, L(2), Z(2));
     Z(2)["ijab"] += 0.5*WMNIJ["ijmn"]*L(2)["mnab"];
     Z(2)["ijab"] +=     WAMEI["eiam"]*L(2)["mjbe"];
     Z(2)["ijab"] -=     WMNEF["mjab"]* GIM[  "im"];
@@ -125,6 +160,23 @@ void LambdaCCSD<U>::iterate(const Arena& arena)
     diis.extrapolate(L, Z);
 }
 
+template <typename U>
+void LambdaCCSD<U>::writeCheckpoint(Checkpoint& chk)
+{
+    this->template get<DeexcitationOperator<U,2>>("L").write(chk);
+    diis.write(chk);
+}
+
+template <typename U>
+void LambdaCCSD<U>::readCheckpoint(const Arena& arena, Checkpoint& chk)
+{
+    auto& L = this->template get   <DeexcitationOperator<U,2>>("L");
+    auto& Z = this->template gettmp<DeexcitationOperator<U,2>>("Z");
+
+    L.read(chk);
+    diis.read(chk, L, Z);
+}
+
 }
 }
 
@@ -136,6 +188,12 @@ max_iterations?
     int 50,
 conv_type?
     enum { MAXE, RMSE, MAE },
+guess?
+    enum { ccsd, file },
+guess_file?
+    string,
+save_guess?
+    string,
 diis?
 {
     damping?
@@ -9,12 +9,62 @@
 #include "convergence/diis.hpp"
 #include "util/iterative.hpp"
 #include "task/task.hpp"
+#include "cc/ccsd.hpp"
 
 namespace aquarius
 {
 namespace cc
 {
 
+/*
+ * Save the amplitudes of L in the format of writeAmplitudeGuess, i.e. as
+ * the excitation amplitudes L^T
+ */
+template <typename U, int N>
+void writeAmplitudeGuess(const string& file, const op::MOSpace<U>& occ, const op::MOSpace<U>& vrt,
+                         const op::DeexcitationOperator<U,N>& L)
+{
+    op::ExcitationOperator<U,N> X("X", occ.arena, occ, vrt);
+
+    X(0) = (U)0;
+    for (int i = 1;i <= N;i++)
+    {
+        string v = string("abcd").substr(0, i);
+        string o = string("ijkl").substr(0, i);
+        X(i)[v+o] = L(i)[o+v];
+    }
+
+    writeAmplitudeGuess(file, occ, vrt, X);
+}
+
+/*
+ * Read amplitudes saved by writeAmplitudeGuess into L as an initial guess,
+ * matching the orbitals to the current ones as for T
+ */
+template <typename U, int N>
+void readAmplitudeGuess(const string& file, const op::MOSpace<U>& occ, const op::MOSpace<U>& vrt,
+                        const tensor::SymmetryBlockedTensor<U>& S, op::DeexcitationOperator<U,N>& L)
+{
+    op::ExcitationOperator<U,N> X("X", occ.arena, occ, vrt);
+
+    X(0) = (U)0;
+    for (int i = 1;i <= N;i++)
+    {
+        string v = string("abcd").substr(0, i);
+        string o = string("ijkl").substr(0, i);
+        X(i)[v+o] = L(i)[o+v];
+    }
+
+    readAmplitudeGuess(file, occ, vrt, S, X);
+
+    for (int i = 1;i <= N;i++)
+    {
+        string v = string("abcd").substr(0, i);
+        string o = string("ijkl").substr(0, i);
+        L(i)[o+v] = X(i)[v+o];
+    }
+}
+
 /*
  * Solve the left-hand coupled cluster eigenvalue equation:
  *
@@ -32,6 +82,12 @@ class LambdaCCSD : public Iterative<U>
     protected:
         convergence::DIIS<op::DeexcitationOperator<U,2>> diis;
 
+        bool isRestartable() const { return true; }
+
+        void writeCheckpoint(task::Checkpoint& chk);
+
+        void readCheckpoint(const Arena& arena, task::Checkpoint& chk);
+
     public:
         LambdaCCSD(const string& name, input::Config& config);
 
@@ -201,6 +201,23 @@ void LambdaCCSDT<U>::iterate(const Arena& arena)
     diis.extrapolate(L, Z);
 }
 
+template <typename U>
+void LambdaCCSDT<U>::writeCheckpoint(Checkpoint& chk)
+{
+    this->template get<DeexcitationOperator<U,3>>("L").write(chk);
+    diis.write(chk);
+}
+
+template <typename U>
+void LambdaCCSDT<U>::readCheckpoint(const Arena& arena, Checkpoint& chk)
+{
+    auto& L = this->template get   <DeexcitationOperator<U,3>>("L");
+    auto& Z = this->template gettmp<DeexcitationOperator<U,3>>("Z");
+
+    L.read(chk);
+    diis.read(chk, L, Z);
+}
+
 }
 }
 
@@ -32,6 +32,12 @@ class LambdaCCSDT : public Iterative<U>
     protected:
         convergence::DIIS<op::DeexcitationOperator<U,3>> diis;
 
+        bool isRestartable() const { return true; }
+
+        void writeCheckpoint(task::Checkpoint& chk);
+
+        void readCheckpoint(const Arena& arena, task::Checkpoint& chk);
+
     public:
         LambdaCCSDT(const string& name, input::Config& config);
 
@@ -348,6 +348,23 @@ void LambdaCCSDTQ<U>::iterate(const Arena& arena)
     diis.extrapolate(L, Z);
 }
 
+template <typename U>
+void LambdaCCSDTQ<U>::writeCheckpoint(Checkpoint& chk)
+{
+    this->template get<DeexcitationOperator<U,4>>("L").write(chk);
+    diis.write(chk);
+}
+
+template <typename U>
+void LambdaCCSDTQ<U>::readCheckpoint(const Arena& arena, Checkpoint& chk)
+{
+    auto& L = this->template get   <DeexcitationOperator<U,4>>("L");
+    auto& Z = this->template gettmp<DeexcitationOperator<U,4>>("Z");
+
+    L.read(chk);
+    diis.read(chk, L, Z);
+}
+
 }
 }
 
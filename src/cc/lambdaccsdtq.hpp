@@ -32,6 +32,12 @@ class LambdaCCSDTQ : public Iterative<U>
     protected:
         convergence::DIIS<op::DeexcitationOperator<U,4>> diis;
 
+        bool isRestartable() const { return true; }
+
+        void writeCheckpoint(task::Checkpoint& chk);
+
+        void readCheckpoint(const Arena& arena, task::Checkpoint& chk);
+
     public:
         LambdaCCSDTQ(const string& name, input::Config& config);
 
@@ -0,0 +1,95 @@
+#include "rhfccsd_t.hpp"
+
+using namespace aquarius::op;
+using namespace aquarius::input;
+using namespace aquarius::tensor;
+using namespace aquarius::task;
+using namespace aquarius::time;
+using namespace aquarius::symmetry;
+
+namespace aquarius
+{
+namespace cc
+{
+
+template <typename U>
+RHFCCSD_T<U>::RHFCCSD_T(const string& name, Config& config)
+: Task(name, config)
+{
+    vector<Requirement> reqs;
+    reqs.push_back(Requirement( "mofock",     "f"));
+    reqs.push_back(Requirement("<Ab|Ci>", "VABCI"));
+    reqs.push_back(Requirement("<Ab|Ij>", "VABIJ"));
+    reqs.push_back(Requirement("<Ai|Jk>", "VAIJK"));
+    reqs.push_back(Requirement("rhfccsd.T1", "T1"));
+    reqs.push_back(Requirement("rhfccsd.T2", "T2"));
+    this->addProduct(Product("double", "energy", reqs));
+}
+
+template <typename U>
+bool RHFCCSD_T<U>::run(task::TaskDAG& dag, const Arena& arena)
+{
+    const auto& f = this->template get<OneElectronOperator<U>>("f");
+
+    const Space& occ = f.occ;
+    const Space& vrt = f.vrt;
+    const vector<int>& nI = occ.nalpha;
+    const vector<int>& nA = vrt.nalpha;
+
+    Denominator<U> D(f);
+
+    const auto& VABCI = this->template get<SymmetryBlockedTensor<U>>("VABCI");
+    const auto& VABIJ = this->template get<SymmetryBlockedTensor<U>>("VABIJ");
+    const auto& VAIJK = this->template get<SymmetryBlockedTensor<U>>("VAIJK");
+    const auto&    T1 = this->template get<SymmetryBlockedTensor<U>>(   "T1");
+    const auto&    T2 = this->template get<SymmetryBlockedTensor<U>>(   "T2");
+
+    SymmetryBlockedTensor<U> W("W", arena, occ.group, 6, {nA,nA,nA,nI,nI,nI}, {NS,NS,NS,NS,NS,NS}, false);
+    SymmetryBlockedTensor<U> Z("Z", arena, occ.group, 6, {nA,nA,nA,nI,nI,nI}, {NS,NS,NS,NS,NS,NS}, false);
+
+    /*
+     * W(abc,ijk) = P(ia,jb,kc) [ <ba|di> t(cd,kj) - <cj|kl> t(ab,il) ]
+     *
+     * where P sums over the six simultaneous permutations of the pairs
+     */
+    Z["abcijk"]  = VABCI["badi"]*T2["cdkj"];
+    Z["abcijk"] -= VAIJK["cjkl"]*T2["abil"];
+
+    W["abcijk"]  = Z["abcijk"];
+    W["abcijk"] += Z["acbikj"];
+    W["abcijk"] += Z["bacjik"];
+    W["abcijk"] += Z["bcajki"];
+    W["abcijk"] += Z["cabkij"];
+    W["abcijk"] += Z["cbakji"];
+
+    Z["abcijk"]  = 4*W["abcijk"];
+    Z["abcijk"] +=   W["bcaijk"];
+    Z["abcijk"] +=   W["cabijk"];
+    Z.weight({&D.getDA(), &D.getDA(), &D.getDA(), &D.getDI(), &D.getDI(), &D.getDI()});
+
+    /*
+     * V(abc,ijk) = W(abc,ijk) + <bc|jk> t(ai) + <ac|ik> t(bj) + <ab|ij> t(ck)
+     */
+    W["abcijk"] += VABIJ["bcjk"]*T1["ai"];
+    W["abcijk"] += VABIJ["acik"]*T1["bj"];
+    W["abcijk"] += VABIJ["abij"]*T1["ck"];
+
+    /*
+     * E = 1/3 [4 W(abc) + W(bca) + W(cab)] [V(abc) - V(cba)] / D
+     */
+    U E_T = (scalar(Z["abcijk"]*W["abcijk"]) -
+             scalar(Z["abcijk"]*W["cbaijk"]))/3.0;
+    this->log(arena) << printos("energy: %18.15f", E_T) << endl;
+
+    this->put("energy", new U(E_T));
+
+    return true;
+}
+
+}
+}
+
+static const char* spec = "";
+
+INSTANTIATE_SPECIALIZATIONS(aquarius::cc::RHFCCSD_T);
+REGISTER_TASK(aquarius::cc::RHFCCSD_T<double>,"rhfccsd(t)",spec);
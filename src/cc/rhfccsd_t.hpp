@@ -0,0 +1,31 @@
+#ifndef _AQUARIUS_CC_RHFCCSD_T_HPP_
+#define _AQUARIUS_CC_RHFCCSD_T_HPP_
+
+#include "util/global.hpp"
+
+#include "task/task.hpp"
+#include "time/time.hpp"
+#include "operator/2eoperator.hpp"
+#include "operator/denominator.hpp"
+
+namespace aquarius
+{
+namespace cc
+{
+
+/*
+ * Closed-shell spin-adapted (T) correction from the RHFCCSD amplitudes
+ */
+template <typename U>
+class RHFCCSD_T : public task::Task
+{
+    public:
+        RHFCCSD_T(const string& name, input::Config& config);
+
+        bool run(task::TaskDAG& dag, const Arena& arena);
+};
+
+}
+}
+
+#endif
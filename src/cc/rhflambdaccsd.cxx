@@ -0,0 +1,233 @@
+#include "rhflambdaccsd.hpp"
+
+using namespace aquarius::op;
+using namespace aquarius::input;
+using namespace aquarius::tensor;
+using namespace aquarius::task;
+using namespace aquarius::time;
+using namespace aquarius::convergence;
+
+namespace aquarius
+{
+namespace cc
+{
+
+template <typename U>
+RHFLambdaCCSD<U>::RHFLambdaCCSD(const string& name, Config& config)
+: Iterative<U>(name, config), diis_config(config.get("diis"))
+{
+    vector<Requirement> reqs;
+    reqs.push_back(Requirement(       "mofock",       "f"));
+    reqs.push_back(Requirement(      "<Ab|Cd>",   "VABCD"));
+    reqs.push_back(Requirement(      "<Ab|Ci>",   "VABCI"));
+    reqs.push_back(Requirement(      "<Ab|Ij>",   "VABIJ"));
+    reqs.push_back(Requirement(   "rhfccsd.T1",      "T1"));
+    reqs.push_back(Requirement(   "rhfccsd.T2",      "T2"));
+    reqs.push_back(Requirement(   "ccsd.F(AE)",     "FAE"));
+    reqs.push_back(Requirement(   "ccsd.F(MI)",     "FMI"));
+    reqs.push_back(Requirement(   "ccsd.F(ME)",     "FME"));
+    reqs.push_back(Requirement("ccsd.W(Am,Ei)",   "WAMEI"));
+    reqs.push_back(Requirement("ccsd.W(Am,Ie)", "WAMIESA"));
+    reqs.push_back(Requirement("ccsd.W(Mn,Ej)",   "WMNEJ"));
+    reqs.push_back(Requirement("ccsd.W(Ab,Ej)",   "WABEJ"));
+    reqs.push_back(Requirement("ccsd.W(Am,Ij)",   "WAMIJ"));
+    reqs.push_back(Requirement("ccsd.W(Mn,Ij)",   "WMNIJ"));
+    this->addProduct(Product("double", "energy", reqs));
+    this->addProduct(Product("double", "convergence", reqs));
+    this->addProduct(Product("rhfccsd.L1", "L1", reqs));
+    this->addProduct(Product("rhfccsd.L2", "L2", reqs));
+}
+
+template <typename U>
+bool RHFLambdaCCSD<U>::run(TaskDAG& dag, const Arena& arena)
+{
+    const auto& f = this->template get<OneElectronOperator<U>>("f");
+
+    const Space& occ = f.occ;
+    const Space& vrt = f.vrt;
+    const vector<int>& nI = occ.nalpha;
+    const vector<int>& nA = vrt.nalpha;
+
+    const auto&   VABCI = this->template get<SymmetryBlockedTensor<U>>(  "VABCI");
+    const auto&   VABIJ = this->template get<SymmetryBlockedTensor<U>>(  "VABIJ");
+    const auto&      T1 = this->template get<SymmetryBlockedTensor<U>>(     "T1");
+    const auto&      T2 = this->template get<SymmetryBlockedTensor<U>>(     "T2");
+    const auto& WAMIESA = this->template get<SymmetryBlockedTensor<U>>("WAMIESA");
+    const auto&   WAMEI = this->template get<SymmetryBlockedTensor<U>>(  "WAMEI");
+
+    auto&      L1 = this->put   (     "L1", new SymmetryBlockedTensor<U>(     "L1", arena, occ.group, 2,       {nI,nA},       {NS,NS}, false));
+    auto&      L2 = this->put   (     "L2", new SymmetryBlockedTensor<U>(     "L2", arena, occ.group, 4, {nI,nI,nA,nA}, {NS,NS,NS,NS}, false));
+    auto&      Z1 = this->puttmp(     "Z1", new SymmetryBlockedTensor<U>(     "Z1", arena, occ.group, 2,       {nI,nA},       {NS,NS}, false));
+    auto&      Z2 = this->puttmp(     "Z2", new SymmetryBlockedTensor<U>(     "Z2", arena, occ.group, 4, {nI,nI,nA,nA}, {NS,NS,NS,NS}, false));
+    auto&    L2SA = this->puttmp(   "L2SA", new SymmetryBlockedTensor<U>(   "L2SA", arena, occ.group, 4, {nI,nI,nA,nA}, {NS,NS,NS,NS}, false));
+    auto&  Taubar = this->puttmp( "Taubar", new SymmetryBlockedTensor<U>( "Taubar", arena, occ.group, 4, {nA,nA,nI,nI}, {NS,NS,NS,NS}, false));
+    auto& VABIJSA = this->puttmp("VABIJSA", new SymmetryBlockedTensor<U>("VABIJSA", arena, occ.group, 4, {nA,nA,nI,nI}, {NS,NS,NS,NS}, false));
+    auto&   WAMIE = this->puttmp(  "WAMIE", new SymmetryBlockedTensor<U>(  "WAMIE", arena, occ.group, 4, {nA,nI,nI,nA}, {NS,NS,NS,NS}, false));
+    auto&   WAMEF = this->puttmp(  "WAMEF", new SymmetryBlockedTensor<U>("W(Am,Ef)", arena, occ.group, 4, {nA,nI,nA,nA}, {NS,NS,NS,NS}, false));
+    this->puttmp(  "D", new Denominator<U>(f));
+    this->puttmp("GIM", new SymmetryBlockedTensor<U>(   "G(im)", arena, occ.group, 2,       {nI,nI},       {NS,NS}, false));
+    this->puttmp("GEA", new SymmetryBlockedTensor<U>(   "G(ea)", arena, occ.group, 2,       {nA,nA},       {NS,NS}, false));
+    this->puttmp("GIJEM", new SymmetryBlockedTensor<U>("G(Ij,Em)", arena, occ.group, 4, {nI,nI,nA,nI}, {NS,NS,NS,NS}, false));
+    this->puttmp("YIJMN", new SymmetryBlockedTensor<U>("Y(Ij,Mn)", arena, occ.group, 4, {nI,nI,nI,nI}, {NS,NS,NS,NS}, false));
+
+    VABIJSA["abij"]  = 2*VABIJ["abij"];
+    VABIJSA["abij"] -=   VABIJ["abji"];
+
+    /*
+     * The four-virtual block of Hbar is applied implicitly, as in
+     * STTwoElectronOperator::contractABCDLeft, which needs
+     * Taubar(ab,ij) = t(ab,ij) - t(ai) t(bj) and the dressed W(am,ef)
+     */
+    Taubar["abij"]  = T2["abij"];
+    Taubar["abij"] -= T1["ai"]*T1["bj"];
+
+    WAMEF["amef"]  = VABCI["efam"];
+    WAMEF["amef"] -= VABIJ["efnm"]*T1["an"];
+
+    /*
+     * The alpha-beta-beta-alpha block of W(am,ei), with WAMIESA = 2 WAMIE - WAMEI
+     */
+    WAMIE["amie"]  = 0.5*WAMIESA["amie"];
+    WAMIE["amie"] += 0.5*  WAMEI["amei"];
+
+    L1["ia"] = T1["ai"];
+    L2["ijab"] = T2["abij"];
+
+    this->puttmp("DIIS", new DIIS<SymmetryBlockedTensor<U>>(diis_config, 2, 2));
+
+    CTF_Timer_epoch ep(this->name.c_str());
+    ep.begin();
+    Iterative<U>::run(dag, arena);
+    ep.end();
+
+    this->put("energy", new U(this->energy()));
+    this->put("convergence", new U(this->conv()));
+
+    return true;
+}
+
+template <typename U>
+void RHFLambdaCCSD<U>::iterate(const Arena& arena)
+{
+    const auto& VABCD = this->template get<SymmetryBlockedTensor<U>>("VABCD");
+    const auto& VABIJ = this->template get<SymmetryBlockedTensor<U>>("VABIJ");
+    const auto&    T1 = this->template get<SymmetryBlockedTensor<U>>(   "T1");
+    const auto&    T2 = this->template get<SymmetryBlockedTensor<U>>(   "T2");
+
+    const auto&   FAE = this->template get<SymmetryBlockedTensor<U>>(  "FAE");
+    const auto&   FMI = this->template get<SymmetryBlockedTensor<U>>(  "FMI");
+    const auto&   FME = this->template get<SymmetryBlockedTensor<U>>(  "FME");
+    const auto& WMNIJ = this->template get<SymmetryBlockedTensor<U>>("WMNIJ");
+    const auto& WMNEJ = this->template get<SymmetryBlockedTensor<U>>("WMNEJ");
+    const auto& WAMIJ = this->template get<SymmetryBlockedTensor<U>>("WAMIJ");
+    const auto& WAMEI = this->template get<SymmetryBlockedTensor<U>>("WAMEI");
+    const auto& WABEJ = this->template get<SymmetryBlockedTensor<U>>("WABEJ");
+
+    auto&      L1 = this->template get   <SymmetryBlockedTensor<U>>(     "L1");
+    auto&      L2 = this->template get   <SymmetryBlockedTensor<U>>(     "L2");
+    auto&      Z1 = this->template gettmp<SymmetryBlockedTensor<U>>(     "Z1");
+    auto&      Z2 = this->template gettmp<SymmetryBlockedTensor<U>>(     "Z2");
+    auto&    L2SA = this->template gettmp<SymmetryBlockedTensor<U>>(   "L2SA");
+    auto&  Taubar = this->template gettmp<SymmetryBlockedTensor<U>>( "Taubar");
+    auto& VABIJSA = this->template gettmp<SymmetryBlockedTensor<U>>("VABIJSA");
+    auto&   WAMIE = this->template gettmp<SymmetryBlockedTensor<U>>(  "WAMIE");
+    auto&   WAMEF = this->template gettmp<SymmetryBlockedTensor<U>>(  "WAMEF");
+    auto&       D = this->template gettmp<Denominator          <U>>(      "D");
+
+    auto&   GIM = this->template gettmp<SymmetryBlockedTensor<U>>(  "GIM");
+    auto&   GEA = this->template gettmp<SymmetryBlockedTensor<U>>(  "GEA");
+    auto& GIJEM = this->template gettmp<SymmetryBlockedTensor<U>>("GIJEM");
+    auto& YIJMN = this->template gettmp<SymmetryBlockedTensor<U>>("YIJMN");
+
+    auto& diis = this->template gettmp<DIIS<SymmetryBlockedTensor<U>>>("DIIS");
+
+    L2SA["ijab"]  = 2*L2["ijab"];
+    L2SA["ijab"] -=   L2["ijba"];
+
+    /**************************************************************************
+     *
+     * Intermediates for Lambda-CCSD
+     */
+      GIM[  "mn"]  =          T2["efno"]*L2SA["moef"];
+      GEA[  "ef"]  =    -     T2["egmn"]*L2SA["mnfg"];
+
+    GIJEM["ijem"]  =          L2["ijef"]*  T1[  "fm"];
+    YIJMN["ijmn"]  =          L2["ijef"]*Taubar["efmn"];
+    /*
+     *************************************************************************/
+
+    /**************************************************************************
+     *
+     * Lambda-CCSD iteration
+     */
+    Z1[  "ia"]  =       FME[  "ia"];
+    Z1[  "ia"] +=       FAE[  "ea"]*  L1[  "ie"];
+    Z1[  "ia"] -=       FMI[  "im"]*  L1[  "ma"];
+    Z1[  "ia"] +=   WAMIESA["eima"]*  L1[  "me"];
+    Z1[  "ia"] +=     WABEJ["efam"]*L2SA["imef"];
+    Z1[  "ia"] -=     WAMIJ["eimn"]*L2SA["mnea"];
+    Z1[  "ia"] -=   2*WMNEJ["inam"]* GIM[  "mn"];
+    Z1[  "ia"] +=     WMNEJ["niam"]* GIM[  "mn"];
+    Z1[  "ia"] -=   2*WAMEF["fiea"]* GEA[  "ef"];
+    Z1[  "ia"] +=     WAMEF["fiae"]* GEA[  "ef"];
+
+    Z2["ijab"]  = 0.5*VABIJ["abij"];
+    Z2["ijab"] +=       FME[  "ia"]*  L1[  "jb"];
+    Z2["ijab"] +=     WAMEF["ejab"]*  L1[  "ie"];
+    Z2["ijab"] -=     WMNEJ["ijam"]*  L1[  "mb"];
+    Z2["ijab"] +=       FAE[  "ea"]*  L2["ijeb"];
+    Z2["ijab"] -=       FMI[  "im"]*  L2["mjab"];
+    Z2["ijab"] += 0.5*VABCD["efab"]*  L2["ijef"];
+    Z2["ijab"] += 0.5*YIJMN["ijmn"]*VABIJ["abmn"];
+    Z2["ijab"] -=     GIJEM["ijem"]*WAMEF["emab"];
+    Z2["ijab"] += 0.5*WMNIJ["ijmn"]*  L2["mnab"];
+    Z2["ijab"] +=     WAMIE["eima"]*L2SA["mjeb"];
+    Z2["ijab"] -=     WAMEI["eiam"]*  L2["mjeb"];
+    Z2["ijab"] -=     WAMEI["ejam"]*  L2["imeb"];
+    Z2["ijab"] -=     VABIJ["abmj"]* GIM[  "im"];
+    Z2["ijab"] +=     VABIJ["ebij"]* GEA[  "ea"];
+
+    Z2["ijab"] +=        Z2["jiba"];
+    /*
+     *************************************************************************/
+
+    Z1.weight({&D.getDI(), &D.getDA()});
+    Z2.weight({&D.getDI(), &D.getDI(), &D.getDA(), &D.getDA()});
+
+    L1 += Z1;
+    L2 += Z2;
+
+    this->energy() = real(scalar(VABIJSA["abij"]*L2["ijab"]));
+    this->conv() = max(Z1.norm(00), Z2.norm(00));
+
+    diis.extrapolate(ptr_vector<SymmetryBlockedTensor<U>>{&L1, &L2},
+                     ptr_vector<SymmetryBlockedTensor<U>>{&Z1, &Z2});
+}
+
+}
+}
+
+static const char* spec = R"!(
+
+convergence?
+    double 1e-9,
+max_iterations?
+    int 50,
+conv_type?
+    enum { MAXE, RMSE, MAE },
+diis?
+{
+    damping?
+        double 0.0,
+    start?
+        int 1,
+    order?
+        int 5,
+    jacobi?
+        bool false
+}
+
+)!";
+
+INSTANTIATE_SPECIALIZATIONS(aquarius::cc::RHFLambdaCCSD);
+REGISTER_TASK(aquarius::cc::RHFLambdaCCSD<double>,"rhflambdaccsd",spec);
@@ -0,0 +1,40 @@
+#ifndef _AQUARIUS_CC_RHFLAMBDACCSD_HPP_
+#define _AQUARIUS_CC_RHFLAMBDACCSD_HPP_
+
+#include "util/global.hpp"
+
+#include "time/time.hpp"
+#include "task/task.hpp"
+#include "util/iterative.hpp"
+#include "operator/2eoperator.hpp"
+#include "operator/denominator.hpp"
+#include "convergence/diis.hpp"
+
+namespace aquarius
+{
+namespace cc
+{
+
+/*
+ * Closed-shell spin-adapted Lambda-CCSD, using the amplitudes and Hbar
+ * elements of RHFCCSD. L1(ia) and L2(ij,ab) hold the alpha and alpha-beta
+ * blocks of the spin-orbital L, in the same way as T1 and T2.
+ */
+template <typename U>
+class RHFLambdaCCSD : public Iterative<U>
+{
+    protected:
+        input::Config diis_config;
+
+    public:
+        RHFLambdaCCSD(const string& name, input::Config& config);
+
+        bool run(task::TaskDAG& dag, const Arena& arena);
+
+        void iterate(const Arena& arena);
+};
+
+}
+}
+
+#endif
@@ -56,7 +56,7 @@ bool UpsilonCCSD<Type>::run(TaskDAG& dag, const Arena& arena)
 template <typename Type>
 void UpsilonCCSD<Type>::iterate(const Arena& arena)
 {
-    const auto& H = this->template get<TwoElectronOperator<Type>>("Hbar");
+    const auto& H = this->template get<STTwoElectronOperator<Type>>("Hbar");
 
     auto&   FME =   H.getIA();
     auto&   FAE =   H.getAB();
@@ -64,7 +64,6 @@ void UpsilonCCSD<Type>::iterate(const Arena& arena)
     auto& WMNEF = H.getIJAB();
     auto& WAMEF = H.getAIBC();
     auto& WABEJ = H.getABCI();
-    auto& WABEF = H.getABCD();
     auto& WMNIJ = H.getIJKL();
     auto& WMNEJ = H.getIJAK();
     auto& WAMIJ = H.getAIJK();
@@ -110,7 +109,7 @@ void UpsilonCCSD<Type>::iterate(const Arena& arena)
     Z(2)["abij"] -=        FMI[  "mi"]*Ups(2)["abmj"];
     Z(2)["abij"] +=        XAE[  "ae"]*  T(2)["ebij"];
     Z(2)["abij"] -=        XMI[  "mi"]*  T(2)["abmj"];
-    Z(2)["abij"] +=  0.5*WABEF["abef"]*Ups(2)["efij"];
+    H.contractABCD(0.5, Ups(2), Z(2));
     Z(2)["abij"] +=  0.5*WMNIJ["mnij"]*Ups(2)["abmn"];
     Z(2)["abij"] +=      WAMEI["amei"]*Ups(2)["ebjm"];
     /*
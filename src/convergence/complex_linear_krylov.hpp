@@ -79,24 +79,55 @@ class ComplexLinearKrylov : public task::Destructible
             else
                 old_hc_i[nextrap-1] = hc_i;
 
+            /*
+             * Compute the overlaps of the new vectors with everything else
+             * in batches: hc_r, hc_i, and all old_hc_r and old_hc_i (plus the
+             * rhs) against c_r and c_i, and all old_c_r and old_c_i against
+             * hc_r and hc_i
+             */
+            int n = nextrap-1;
+
+            vector<const T*> hcs(2*n+3);
+            for (int extrap = 0;extrap < n;extrap++)
+            {
+                hcs[  extrap] = &old_hc_r[extrap];
+                hcs[n+extrap] = &old_hc_i[extrap];
+            }
+            hcs[2*n  ] = &hc_r;
+            hcs[2*n+1] = &hc_i;
+            hcs[2*n+2] = rhs.get();
+
+            vector<U> hc_c_r = c_r.dots(false, hcs, false);
+            vector<U> hc_c_i = c_i.dots(false, hcs, false);
+
+            vector<const T*> cs(2*n);
+            for (int extrap = 0;extrap < n;extrap++)
+            {
+                cs[  extrap] = &old_c_r[extrap];
+                cs[n+extrap] = &old_c_i[extrap];
+            }
+
+            vector<U> c_hc_r = hc_r.dots(false, cs, false);
+            vector<U> c_hc_i = hc_i.dots(false, cs, false);
+
             /*
              * Compute the overlap with the rhs vector
              */
-            b[nextrap-1].real( scalar(c_r*(*rhs)));
-            b[nextrap-1].imag(-scalar(c_i*(*rhs)));
+            b[nextrap-1].real( hc_c_r[2*n+2]);
+            b[nextrap-1].imag(-hc_c_i[2*n+2]);
 
             /*
              * Augment the subspace matrix with the new vectors
              */
-            e[nextrap-1][nextrap-1].real(scalar(hc_r*c_r) + scalar(hc_i*c_i));
-            e[nextrap-1][nextrap-1].imag(scalar(hc_i*c_r) - scalar(hc_r*c_i));
+            e[nextrap-1][nextrap-1].real(hc_c_r[2*n] + hc_c_i[2*n+1]);
+            e[nextrap-1][nextrap-1].imag(hc_c_r[2*n+1] - hc_c_i[2*n]);
 
-            for (int extrap = 0;extrap < nextrap-1;extrap++)
+            for (int extrap = 0;extrap < n;extrap++)
             {
-                e[   extrap][nextrap-1].real(scalar(old_hc_r[extrap]*c_r) + scalar(old_hc_i[extrap]*c_i));
-                e[   extrap][nextrap-1].imag(scalar(old_hc_i[extrap]*c_r) - scalar(old_hc_r[extrap]*c_i));
-                e[nextrap-1][   extrap].real(scalar(hc_r*old_c_r[extrap]) + scalar(hc_i*old_c_i[extrap]));
-                e[nextrap-1][   extrap].imag(scalar(hc_i*old_c_r[extrap]) - scalar(hc_r*old_c_i[extrap]));
+                e[   extrap][nextrap-1].real(hc_c_r[extrap] + hc_c_i[n+extrap]);
+                e[   extrap][nextrap-1].imag(hc_c_r[n+extrap] - hc_c_i[extrap]);
+                e[nextrap-1][   extrap].real(c_hc_r[extrap] + c_hc_i[n+extrap]);
+                e[nextrap-1][   extrap].imag(c_hc_i[extrap] - c_hc_r[n+extrap]);
             }
         }
 
@@ -104,28 +135,36 @@ class ComplexLinearKrylov : public task::Destructible
         {
             getRoot(c_r, c_i);
 
-            hc_r = 0;
-            hc_i = 0;
-            for (int extrap = 0;extrap < nextrap;extrap++)
-            {
-                hc_r += old_hc_r[extrap]*v[extrap].real();
-                hc_r -= old_hc_i[extrap]*v[extrap].imag();
-                hc_i += old_hc_r[extrap]*v[extrap].imag();
-                hc_i += old_hc_i[extrap]*v[extrap].real();
-            }
+            combine(old_hc_r, old_hc_i, hc_r, hc_i);
         }
 
         void getRoot(T& c_r, T& c_i)
         {
-            c_r = 0;
-            c_i = 0;
+            combine(old_c_r, old_c_i, c_r, c_i);
+        }
+
+        /*
+         * Form x_r + i*x_i = sum_k v[k]*(old_r[k] + i*old_i[k]) with one
+         * fused linear combination for each of the real and imaginary parts
+         */
+        void combine(const unique_vector<T>& old_r, const unique_vector<T>& old_i, T& x_r, T& x_i)
+        {
+            vector<const T*> vecs(2*nextrap);
+            vector<U> coeffs_r(2*nextrap);
+            vector<U> coeffs_i(2*nextrap);
+
             for (int extrap = 0;extrap < nextrap;extrap++)
             {
-                c_r += old_c_r[extrap]*v[extrap].real();
-                c_r -= old_c_i[extrap]*v[extrap].imag();
-                c_i += old_c_r[extrap]*v[extrap].imag();
-                c_i += old_c_i[extrap]*v[extrap].real();
+                vecs[        extrap] = &old_r[extrap];
+                vecs[nextrap+extrap] = &old_i[extrap];
+                coeffs_r[        extrap] =  v[extrap].real();
+                coeffs_r[nextrap+extrap] = -v[extrap].imag();
+                coeffs_i[        extrap] =  v[extrap].imag();
+                coeffs_i[nextrap+extrap] =  v[extrap].real();
             }
+
+            x_r.lincomb(coeffs_r, vecs);
+            x_i.lincomb(coeffs_i, vecs);
         }
 
     public:
@@ -284,36 +284,66 @@ class Davidson : public task::Destructible
             /*
              * Compute the overlap with the guess vectors
              */
+            vector<dtype> olap;
+
             if (!guess.empty())
             {
+                vector<const unique_vector<T>*> gs(nvec);
+                for (int gvec = 0;gvec < nvec;gvec++) gs[gvec] = &guess[gvec];
+
                 for (int cvec = 0;cvec < nvec;cvec++)
                 {
+                    detail::innerProdRow(innerProd, old_c[nextrap-1][cvec], gs, olap);
+
                     for (int gvec = 0;gvec < nvec;gvec++)
                     {
-                        guess_overlap[gvec][cvec][nextrap-1] = innerProd(old_c[nextrap-1][cvec], guess[gvec]);
+                        guess_overlap[gvec][cvec][nextrap-1] = olap[gvec];
                     }
                 }
             }
 
             /*
-             * Augment the subspace matrix with the new vectors
+             * Augment the subspace matrix with the new vectors. The new row
+             * and column are each formed with one batched set of inner
+             * products per vector instead of one sweep per matrix element.
              */
-            for (int lvec = 0;lvec < nvec;lvec++)
+            vector<const unique_vector<T>*> cs, hcs;
+            for (int extrap = 0;extrap < nextrap;extrap++)
             {
-                for (int rvec = 0;rvec < nvec;rvec++)
+                for (int vec = 0;vec < nvec;vec++)
                 {
-                    e[lvec][nextrap-1][rvec][nextrap-1] = innerProd(old_c[nextrap-1][lvec], old_hc[nextrap-1][rvec]);
-                    s[lvec][nextrap-1][rvec][nextrap-1] = innerProd(old_c[nextrap-1][lvec],  old_c[nextrap-1][rvec]);
-
-                    for (int extrap = 0;extrap < nextrap;extrap++)
-                    {
-                        e[lvec][   extrap][rvec][nextrap-1] = innerProd(old_c[   extrap][lvec], old_hc[nextrap-1][rvec]);
-                        e[lvec][nextrap-1][rvec][   extrap] = innerProd(old_c[nextrap-1][lvec], old_hc[   extrap][rvec]);
-                        s[lvec][   extrap][rvec][nextrap-1] = innerProd(old_c[   extrap][lvec],  old_c[nextrap-1][rvec]);
-                        s[lvec][nextrap-1][rvec][   extrap] = innerProd(old_c[nextrap-1][lvec],  old_c[   extrap][rvec]);
-                    }
+                    cs.push_back(&old_c[extrap][vec]);
+                    hcs.push_back(&old_hc[extrap][vec]);
                 }
             }
+
+            for (int lvec = 0;lvec < nvec;lvec++)
+            {
+                detail::innerProdRow(innerProd, old_c[nextrap-1][lvec], hcs, olap);
+                for (int extrap = 0;extrap < nextrap;extrap++)
+                    for (int rvec = 0;rvec < nvec;rvec++)
+                        e[lvec][nextrap-1][rvec][extrap] = olap[extrap*nvec+rvec];
+
+                detail::innerProdRow(innerProd, old_c[nextrap-1][lvec], cs, olap);
+                for (int extrap = 0;extrap < nextrap;extrap++)
+                    for (int rvec = 0;rvec < nvec;rvec++)
+                        s[lvec][nextrap-1][rvec][extrap] = olap[extrap*nvec+rvec];
+            }
+
+            cs.resize((nextrap-1)*nvec);
+
+            for (int rvec = 0;rvec < nvec;rvec++)
+            {
+                detail::innerProdCol(innerProd, cs, old_hc[nextrap-1][rvec], olap);
+                for (int extrap = 0;extrap < nextrap-1;extrap++)
+                    for (int lvec = 0;lvec < nvec;lvec++)
+                        e[lvec][extrap][rvec][nextrap-1] = olap[extrap*nvec+lvec];
+
+                detail::innerProdCol(innerProd, cs, old_c[nextrap-1][rvec], olap);
+                for (int extrap = 0;extrap < nextrap-1;extrap++)
+                    for (int lvec = 0;lvec < nvec;lvec++)
+                        s[lvec][extrap][rvec][nextrap-1] = olap[extrap*nvec+lvec];
+            }
         }
 
         void getRoot(int rt, T& c, T& hc, bool normalize = true)
@@ -335,14 +365,17 @@ class Davidson : public task::Destructible
 
             for (int idx = 0;idx < nc;idx++)
             {
-                hc[idx] = 0;
+                vector<dtype> coeffs;
+                vector<const T*> vecs;
                 for (int extrap = nextrap-1;extrap >= 0;extrap--)
                 {
                     for (int vec = nvec-1;vec >= 0;vec--)
                     {
-                        hc[idx] += old_hc[extrap][vec][idx]*vr[rt][vec][extrap];
+                        coeffs.push_back(vr[rt][vec][extrap]);
+                        vecs.push_back(&old_hc[extrap][vec][idx]);
                     }
                 }
+                hc[idx].lincomb(coeffs, vecs);
             }
 
             if (normalize)
@@ -362,14 +395,17 @@ class Davidson : public task::Destructible
         {
             for (int idx = 0;idx < nc;idx++)
             {
-                c[idx] = 0;
+                vector<dtype> coeffs;
+                vector<const T*> vecs;
                 for (int extrap = nextrap-1;extrap >= 0;extrap--)
                 {
                     for (int vec = nvec-1;vec >= 0;vec--)
                     {
-                        c[idx] += old_c[extrap][vec][idx]*vr[rt][vec][extrap];
+                        coeffs.push_back(vr[rt][vec][extrap]);
+                        vecs.push_back(&old_c[extrap][vec][idx]);
                     }
                 }
+                c[idx].lincomb(coeffs, vecs);
             }
 
             if (normalize)
@@ -5,6 +5,7 @@
 
 #include "input/config.hpp"
 #include "task/task.hpp"
+#include "task/checkpoint.hpp"
 
 namespace aquarius
 {
@@ -31,6 +32,75 @@ struct DefaultInnerProd
     }
 };
 
+/*
+ * Check a batched inner product against the one computed on its own
+ */
+template <typename dtype>
+void checkInnerProd(const dtype& batched, const dtype& single)
+{
+    assert(aquarius::abs(batched-single) <= 1e-10*max(1.0, (double)aquarius::abs(single)));
+}
+
+/*
+ * Compute p[i] = innerProd(a, *b[i]) for all i. Generic inner products are
+ * evaluated one at a time, while the default one is batched so that a is
+ * swept only once and there is a single reduction per component.
+ */
+template <typename dtype, typename InnerProd, typename a_container, typename b_container>
+void innerProdRow(const InnerProd& innerProd, const a_container& a,
+                  const vector<const b_container*>& b, vector<dtype>& p)
+{
+    p.resize(b.size());
+    for (int i = 0;i < b.size();i++) p[i] = innerProd(a, *b[i]);
+}
+
+template <typename dtype, typename T, typename a_container, typename b_container>
+void innerProdRow(const DefaultInnerProd<T>& innerProd, const a_container& a,
+                  const vector<const b_container*>& b, vector<dtype>& p)
+{
+    p.assign(b.size(), (dtype)0);
+    vector<const T*> bj(b.size());
+    for (int j = 0;j < a.size();j++)
+    {
+        for (int i = 0;i < b.size();i++) bj[i] = &(*b[i])[j];
+        vector<dtype> pj = a[j].dots(false, bj, true);
+        for (int i = 0;i < b.size();i++) p[i] += pj[i];
+    }
+
+    #ifndef NDEBUG
+    for (int i = 0;i < b.size();i++) checkInnerProd(p[i], (dtype)innerProd(a, *b[i]));
+    #endif
+}
+
+/*
+ * Compute p[i] = innerProd(*a[i], b) for all i.
+ */
+template <typename dtype, typename InnerProd, typename a_container, typename b_container>
+void innerProdCol(const InnerProd& innerProd, const vector<const a_container*>& a,
+                  const b_container& b, vector<dtype>& p)
+{
+    p.resize(a.size());
+    for (int i = 0;i < a.size();i++) p[i] = innerProd(*a[i], b);
+}
+
+template <typename dtype, typename T, typename a_container, typename b_container>
+void innerProdCol(const DefaultInnerProd<T>& innerProd, const vector<const a_container*>& a,
+                  const b_container& b, vector<dtype>& p)
+{
+    p.assign(a.size(), (dtype)0);
+    vector<const T*> aj(a.size());
+    for (int j = 0;j < b.size();j++)
+    {
+        for (int i = 0;i < a.size();i++) aj[i] = &(*a[i])[j];
+        vector<dtype> pj = b[j].dots(true, aj, false);
+        for (int i = 0;i < a.size();i++) p[i] += pj[i];
+    }
+
+    #ifndef NDEBUG
+    for (int i = 0;i < a.size();i++) checkInnerProd(p[i], (dtype)innerProd(*a[i], b));
+    #endif
+}
+
 }
 
 template<typename T, typename U = T, typename InnerProd = detail::DefaultInnerProd<U>>
@@ -62,6 +132,76 @@ class DIIS
             old_dx.resize(nextrap);
         }
 
+        /*
+         * Save the extrapolation history so that a restarted calculation
+         * continues with the same DIIS subspace
+         */
+        void write(task::Checkpoint& chk) const
+        {
+            int nold = 0;
+            for (int i = 0;i < nextrap && !old_x[i].empty();i++) nold++;
+
+            chk.writeAll(nold);
+            chk.writeAll(start);
+            chk.writeAll(vector<dtype>(e.data(), e.data()+(nextrap+1)*(nextrap+1)));
+            chk.writeAll(vector<dtype>(c.data(), c.data()+(nextrap+1)));
+
+            for (int i = 0;i < nold;i++)
+            {
+                for (int j = 0;j < nx;j++) old_x[i][j].write(chk);
+                for (int j = 0;j < ndx;j++) old_dx[i][j].write(chk);
+            }
+        }
+
+        void read(task::Checkpoint& chk, T& x, U& dx)
+        {
+            read(chk, ptr_vector<T>{&x}, ptr_vector<U>{&dx});
+        }
+
+        /*
+         * x and dx are only used as templates to allocate the stored vectors
+         */
+        template <typename x_container, typename dx_container>
+        void read(task::Checkpoint& chk, x_container&& x, dx_container&& dx)
+        {
+            assert(x.size() == nx);
+            assert(dx.size() == ndx);
+
+            int nold;
+            vector<dtype> e_, c_;
+            chk.readAll(nold);
+            chk.readAll(start);
+            chk.readAll(e_);
+            chk.readAll(c_);
+
+            if (nold > nextrap || e_.size() != (nextrap+1)*(nextrap+1))
+                throw logic_error("Checkpointed DIIS has a different order");
+
+            copy(e_.begin(), e_.end(), e.data());
+            copy(c_.begin(), c_.end(), c.data());
+
+            for (int i = 0;i < nextrap;i++)
+            {
+                old_x[i].clear();
+                old_dx[i].clear();
+            }
+
+            for (int i = 0;i < nold;i++)
+            {
+                for (int j = 0;j < nx;j++)
+                {
+                    old_x[i].push_back(x[j]);
+                    old_x[i][j].read(chk);
+                }
+
+                for (int j = 0;j < ndx;j++)
+                {
+                    old_dx[i].push_back(dx[j]);
+                    old_dx[i][j].read(chk);
+                }
+            }
+        }
+
         void extrapolate(T& x, U& dx)
         {
             extrapolate(ptr_vector<T>{&x}, ptr_vector<U>{&dx});
@@ -119,19 +259,28 @@ class DIIS
                 }
             }
 
-            e[0][0] = innerProd(dx, dx);
-
             /*
-             * Get the new off-diagonal error matrix elements for all
-             * previous vectors which exist. There may be fewer than nextrap of them
+             * Get the new row of the error matrix for all previous vectors
+             * which exist. There may be fewer than nextrap of them
              * (e.g. in iterations 1 to nextrap-1), so save this number.
+             * Slot 0 holds a copy of dx, which gives the diagonal element.
              */
             int nextrap_real = 1;
-            for (int i = 1;i < nextrap && !old_dx[i].empty();i++)
+            for (int i = 1;i < nextrap && !old_dx[i].empty();i++) nextrap_real++;
+
             {
-                e[i][0] = innerProd(dx, old_dx[i]);
-                e[0][i] = e[i][0];
-                nextrap_real++;
+                vector<const unique_vector<U>*> prev(nextrap_real);
+                for (int i = 0;i < nextrap_real;i++) prev[i] = &old_dx[i];
+
+                vector<dtype> olap;
+                detail::innerProdRow(innerProd, dx, prev, olap);
+
+                e[0][0] = olap[0];
+                for (int i = 1;i < nextrap_real;i++)
+                {
+                    e[i][0] = olap[i];
+                    e[0][i] = e[i][0];
+                }
             }
 
             /*
@@ -202,27 +351,24 @@ class DIIS
 
             //for (int i = 0;i <= nextrap_real;i++) printf("%+11e ", c[i]); printf("\n");
 
-            for (int i = 0;i < ndx;i++)
-            {
-                dx[i] = old_dx[0][i]*c[0];
-            }
+            /*
+             * Form the extrapolated vectors with one fused linear combination
+             * each, rather than one pass over x and dx per stored vector
+             */
+            vector<dtype> coeffs(c.data(), c.data()+nextrap_real);
 
-            for (int i = 0;i < nx;i++)
+            for (int j = 0;j < ndx;j++)
             {
-                x[i] = old_x[0][i]*c[0];
+                vector<const U*> vecs(nextrap_real);
+                for (int i = 0;i < nextrap_real;i++) vecs[i] = &old_dx[i][j];
+                dx[j].lincomb(coeffs, vecs);
             }
 
-            for (int i = 1;i < nextrap_real;i++)
+            for (int j = 0;j < nx;j++)
             {
-                for (int j = 0;j < ndx;j++)
-                {
-                    dx[j] += old_dx[i][j]*c[i];
-                }
-
-                for (int j = 0;j < nx;j++)
-                {
-                    x[j] += old_x[i][j]*c[i];
-                }
+                vector<const T*> vecs(nextrap_real);
+                for (int i = 0;i < nextrap_real;i++) vecs[i] = &old_x[i][j];
+                x[j].lincomb(coeffs, vecs);
             }
         }
 };
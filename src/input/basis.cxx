@@ -12,6 +12,140 @@ BasisSet::BasisSet(const string& file)
     readBasisSet(file);
 }
 
+BasisSet::BasisSet(const string& file, const Arena& arena, const set<string>& elements)
+{
+    readBasisSet(file, arena, elements);
+}
+
+void BasisSet::readBasisSet(const string& file, const Arena& arena, const set<string>& elements)
+{
+    if (arena.size == 1)
+    {
+        readBasisSet(file);
+        return;
+    }
+
+    /*
+     * status: 0 = ok, 1 = file not found, 2 = format error, followed by the
+     * sizes of the int and double buffers and of the error message
+     */
+    vector<int> header(4, 0);
+    vector<int> ints;
+    vector<double> doubles;
+    string what;
+
+    if (arena.rank == 0)
+    {
+        try
+        {
+            readBasisSet(file);
+        }
+        catch (BasisSetNotFoundError& e)
+        {
+            header[0] = 1;
+            what = e.what();
+        }
+        catch (BasisSetFormatError& e)
+        {
+            header[0] = 2;
+            what = e.what();
+        }
+
+        if (header[0] == 0 && !elements.empty())
+        {
+            for (map<string,vector<ShellBasis>>::iterator it = atomBases.begin();it != atomBases.end();)
+            {
+                if (elements.count(it->first) == 0)
+                {
+                    atomBases.erase(it++);
+                }
+                else
+                {
+                    ++it;
+                }
+            }
+        }
+
+        /*
+         * Pack as: nelem, then for each element the length of its name,
+         * the characters of the name, nshell, and (L,nprim,ncontr) for each
+         * shell. Exponents and coefficients go in the double buffer.
+         */
+        if (header[0] == 0)
+        {
+            ints.push_back(atomBases.size());
+            for (map<string,vector<ShellBasis>>::iterator it = atomBases.begin();it != atomBases.end();++it)
+            {
+                ints.push_back(it->first.size());
+                for (int i = 0;i < it->first.size();i++) ints.push_back(it->first[i]);
+                ints.push_back(it->second.size());
+                for (vector<ShellBasis>::iterator b = it->second.begin();b != it->second.end();++b)
+                {
+                    ints.push_back(b->L);
+                    ints.push_back(b->nprim);
+                    ints.push_back(b->ncontr);
+                    doubles.insert(doubles.end(), b->exponents.begin(), b->exponents.end());
+                    doubles.insert(doubles.end(), b->coefficients.begin(), b->coefficients.end());
+                }
+            }
+        }
+
+        header[1] = ints.size();
+        header[2] = doubles.size();
+        header[3] = what.size();
+    }
+
+    arena.comm().Bcast(header, 0);
+
+    /*
+     * Every rank throws the same exception, with rank 0's message
+     */
+    if (header[0] != 0)
+    {
+        vector<char> msg(what.begin(), what.end());
+        msg.resize(header[3]);
+        arena.comm().Bcast(msg, 0);
+        what.assign(msg.begin(), msg.end());
+
+        if (header[0] == 1) throw BasisSetNotFoundError(what);
+        throw BasisSetFormatError(what);
+    }
+
+    ints.resize(header[1]);
+    doubles.resize(header[2]);
+    arena.comm().Bcast(ints, 0);
+    arena.comm().Bcast(doubles, 0);
+
+    if (arena.rank == 0) return;
+
+    atomBases.clear();
+
+    vector<int>::iterator i = ints.begin();
+    vector<double>::iterator d = doubles.begin();
+
+    int nelem = *i++;
+    for (int e = 0;e < nelem;e++)
+    {
+        int len = *i++;
+        string name(i, i+len);
+        i += len;
+
+        vector<ShellBasis>& sb = atomBases[name];
+        sb.resize(*i++);
+
+        for (vector<ShellBasis>::iterator b = sb.begin();b != sb.end();++b)
+        {
+            b->L = *i++;
+            b->nprim = *i++;
+            b->ncontr = *i++;
+            b->exponents.assign(d, d+b->nprim);
+            d += b->nprim;
+            b->coefficients.assign(d, d+b->nprim*b->ncontr);
+            d += b->nprim*b->ncontr;
+        }
+    }
+}
+
 void BasisSet::readBasisSet(const string& file)
 {
     ifstream ifs(file.c_str());
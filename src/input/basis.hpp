@@ -31,6 +31,12 @@ class BasisSetFormatError : public runtime_error
     public:
         BasisSetFormatError(const string& file, const string& what_arg, const int lineno)
         : runtime_error(buildString(file, what_arg, lineno)) {}
+
+        /*
+         * Recreate an error raised (and formatted) on another rank
+         */
+        explicit BasisSetFormatError(const string& what_arg)
+        : runtime_error(what_arg) {}
 };
 
 class BasisSet
@@ -49,6 +55,8 @@ class BasisSet
 
         void readBasisSet(const string& file);
 
+        void readBasisSet(const string& file, const Arena& arena, const set<string>& elements);
+
         template <typename T>
         T readValue(istream& is, const string& file, int& lineno)
         {
@@ -116,6 +124,18 @@ class BasisSet
 
         BasisSet(const string& file);
 
+        /*
+         * Parse the basis set file on rank 0 only and broadcast the result.
+         * If elements is non-empty, only the bases for those elements are
+         * kept and sent. Errors on rank 0 are rethrown, as the same type
+         * and with the same message, on every rank.
+         *
+         * There is no precompiled (binary) basis library: the text file is
+         * read once per run regardless of the number of ranks.
+         */
+        BasisSet(const string& file, const Arena& arena,
+                 const set<string>& elements = set<string>());
+
         void apply(Atom& atom, bool spherical = true, bool contaminants = false);
 
         void apply(Molecule& molecule, bool spherical = true, bool contaminants = false);
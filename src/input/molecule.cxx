@@ -149,7 +149,7 @@ Molecule::Molecule(Config& config, const Arena& arena)
     vector<AtomCartSpec> cartpos;
     initGeometry(config, cartpos);
     initSymmetry(config, cartpos);
-    initBasis(config, cartpos);
+    initBasis(config, cartpos, arena);
 
 
     if (arena.rank == 0) 
@@ -1236,17 +1236,16 @@ void Molecule::initSymmetry(Config& config, vector<AtomCartSpec>& cartpos)
     }
 }
 
-void Molecule::initBasis(Config& config, const vector<AtomCartSpec>& cartpos)
+void Molecule::initBasis(Config& config, const vector<AtomCartSpec>& cartpos, const Arena& arena)
 {
     bool contaminants = config.get<bool>("basis.contaminants");
     bool spherical = config.get<bool>("basis.spherical");
 
-    BasisSet defaultBasis;
+    string defaultName;
     bool hasDefaultBasis;
     try
     {
-        string name = config.get<string>("basis.basis_set");
-        defaultBasis = BasisSet(TOPDIR "/basis/" + name);
+        defaultName = config.get<string>("basis.basis_set");
         hasDefaultBasis = true;
     }
     catch (EntryNotFoundError& e)
@@ -1254,6 +1253,25 @@ void Molecule::initBasis(Config& config, const vector<AtomCartSpec>& cartpos)
         hasDefaultBasis = false;
     }
 
+    /*
+     * Collect the elements needed from each basis set file so that each file
+     * is parsed only once (on rank 0), and only the required elements are
+     * broadcast to the other ranks.
+     */
+    map<string,set<string>> needed;
+    for (vector<AtomCartSpec>::const_iterator it = cartpos.begin();it != cartpos.end();++it)
+    {
+        string name = it->basisSet != "" ? it->basisSet : defaultName;
+        if (name == "") continue;
+        needed[name].insert(Element::getElement(it->symbol).getName());
+    }
+
+    map<string,BasisSet> bases;
+    for (map<string,set<string>>::iterator it = needed.begin();it != needed.end();++it)
+    {
+        bases[it->first] = BasisSet(TOPDIR "/basis/" + it->first, arena, it->second);
+    }
+
     norb.resize(group->getNumIrreps(), 0);
 
     for (vector<AtomCartSpec>::const_iterator it = cartpos.begin();it != cartpos.end();++it)
@@ -1266,11 +1284,11 @@ void Molecule::initBasis(Config& config, const vector<AtomCartSpec>& cartpos)
         Atom a(Center(*group, it->pos, myelem));
         if (it->basisSet != "")
         {
-            BasisSet(TOPDIR "/basis/" + it->basisSet).apply(a, spherical, contaminants);
+            bases[it->basisSet].apply(a, spherical, contaminants);
         }
         else if (hasDefaultBasis)
         {
-            defaultBasis.apply(a, spherical, contaminants);
+            bases[defaultName].apply(a, spherical, contaminants);
         }
 
         atoms.push_back(a);
@@ -131,7 +131,7 @@ class Molecule
 
         void initSymmetry(input::Config& config, vector<AtomCartSpec>& cartpos);
 
-        void initBasis(input::Config& config, const vector<AtomCartSpec>& cartpos);
+        void initBasis(input::Config& config, const vector<AtomCartSpec>& cartpos, const Arena& arena);
 
     public:
         Molecule(Config& config, const Arena& arena);
@@ -30,9 +30,12 @@ namespace integrals
 class IshidaOVI;
 class IshidaKEI;
 class IshidaNAI;
+class OneElectronDerivatives;
 
 class OneElectronIntegrals
 {
+    friend class OneElectronDerivatives;
+
     protected:
         const Shell& sa;
         const Shell& sb;
@@ -35,8 +35,12 @@ struct idx4_t
 namespace integrals
 {
 
+class TwoElectronDerivatives;
+
 class TwoElectronIntegrals
 {
+    friend class TwoElectronDerivatives;
+
     protected:
         const Shell& sa;
         const Shell& sb;
@@ -159,8 +163,12 @@ class TwoElectronIntegralsTask : public task::Task
                             if (abcd%arena.size == arena.rank)
                             {
                                 ERIType block(shells[a], shells[b], shells[c], shells[d]);
+
+                                PROFILE_SECTION(eri_compute)
                                 block.run();
+                                PROFILE_STOP
 
+                                PROFILE_SECTION(eri_process)
                                 size_t n;
                                 while ((n = block.process(ctx, idx[a], idx[b], idx[c], idx[d],
                                                           TMP_BUFSIZE, tmpval.data(), tmpidx.data(), INTEGRAL_CUTOFF)) != 0)
@@ -168,6 +176,7 @@ class TwoElectronIntegralsTask : public task::Task
                                     eri->ints.insert(eri->ints.end(), tmpval.data(), tmpval.data()+n);
                                     eri->idxs.insert(eri->idxs.end(), tmpidx.data(), tmpidx.data()+n);
                                 }
+                                PROFILE_STOP
                             }
                             abcd++;
                         }
@@ -0,0 +1,227 @@
+#include "derivatives.hpp"
+
+namespace aquarius
+{
+namespace integrals
+{
+
+/*
+ * Cartesian powers of each function of a shell, in the order of XYZ()
+ */
+static vector<array<int,3>> cartesians(int L)
+{
+    vector<array<int,3>> xyz((L+1)*(L+2)/2);
+
+    for (int x = L;x >= 0;x--)
+    {
+        for (int y = L-x;y >= 0;y--)
+        {
+            int z = L-x-y;
+            xyz[XYZ(x,y,z)] = {x, y, z};
+        }
+    }
+
+    return xyz;
+}
+
+static int func(const array<int,3>& p)
+{
+    return XYZ(p[0],p[1],p[2]);
+}
+
+/*
+ * A cartesian shell with the primitives of s but angular momentum L. Only its
+ * primitive integrals are used, so the contraction coefficients do not matter.
+ */
+static Shell shifted(const Shell& s, int L)
+{
+    int n = s.getNPrim();
+    return Shell(s.getCenter(), L, n, 1, false, false, s.getExponents(), vector<double>(n, 1.0));
+}
+
+vector<double> OneElectronDerivatives::run(int center) const
+{
+    assert(center >= 0 && center < 2);
+
+    unique_ptr<OneElectronIntegrals> base(kernel(sa, sb));
+
+    const Shell& s = (center == 0 ? sa : sb);
+    int l = s.getL();
+    const vector<double>& zeta = s.getExponents();
+
+    Shell up = shifted(s, l+1);
+    Shell dn = shifted(s, max(l-1, 0));
+
+    unique_ptr<OneElectronIntegrals> kup(center == 0 ? kernel(up, sb) : kernel(sa, up));
+    unique_ptr<OneElectronIntegrals> kdn;
+    if (l > 0) kdn.reset(center == 0 ? kernel(dn, sb) : kernel(sa, dn));
+
+    int na = base->na, nb = base->nb;
+    int ma = base->ma, mb = base->mb;
+    int fca = base->fca, fcb = base->fcb;
+    int nprim = na*nb;
+
+    const vec3& posa = sa.getCenter().getCenter(0);
+    const vec3& posb = sb.getCenter().getCenter(0);
+
+    vector<double> pup(kup->fca*kup->fcb*nprim);
+    kup->prims(posa, posb, pup.data());
+
+    vector<double> pdn;
+    if (kdn)
+    {
+        pdn.resize(kdn->fca*kdn->fcb*nprim);
+        kdn->prims(posa, posb, pdn.data());
+    }
+
+    vector<array<int,3>> carta = cartesians(base->la);
+    vector<array<int,3>> cartb = cartesians(base->lb);
+
+    size_t nint = base->ints.size();
+    vector<double> ints(3*nint);
+    vector<double> buf1(fca*fcb*max(na,ma)*max(nb,mb));
+    vector<double> buf2(buf1.size());
+
+    for (int xyz = 0;xyz < 3;xyz++)
+    {
+        for (int m = 0;m < nprim;m++)
+        {
+            double z2 = 2*zeta[center == 0 ? m%na : m/na];
+
+            for (int b = 0;b < fcb;b++)
+            {
+                for (int a = 0;a < fca;a++)
+                {
+                    array<int,3> p[2] = {carta[a], cartb[b]};
+                    int n = p[center][xyz];
+
+                    p[center][xyz]++;
+                    double d = z2*pup[(m*kup->fcb+func(p[1]))*kup->fca+func(p[0])];
+
+                    if (n > 0)
+                    {
+                        p[center][xyz] -= 2;
+                        d -= n*pdn[(m*kdn->fcb+func(p[1]))*kdn->fca+func(p[0])];
+                    }
+
+                    buf1[(m*fcb+b)*fca+a] = d;
+                }
+            }
+        }
+
+        base->prim2contr2r(fca*fcb, buf1.data(), buf2.data());
+        base->cart2spher2r(ma*mb, buf2.data(), buf1.data());
+        transpose(base->fsa*base->fsb, ma*mb, 1.0, buf1.data(), base->fsa*base->fsb,
+                                              0.0, ints.data()+xyz*nint, ma*mb);
+    }
+
+    return ints;
+}
+
+vector<double> TwoElectronDerivatives::run(int center) const
+{
+    assert(center >= 0 && center < 4);
+
+    unique_ptr<TwoElectronIntegrals> base(kernel(sa, sb, sc, sd));
+
+    const Shell* shells[4] = {&sa, &sb, &sc, &sd};
+    const Shell& s = *shells[center];
+    int l = s.getL();
+    const vector<double>& zeta = s.getExponents();
+
+    Shell up = shifted(s, l+1);
+    Shell dn = shifted(s, max(l-1, 0));
+
+    auto shifted_kernel = [&](const Shell& t)
+    {
+        const Shell* q[4] = {&sa, &sb, &sc, &sd};
+        q[center] = &t;
+        return kernel(*q[0], *q[1], *q[2], *q[3]);
+    };
+
+    unique_ptr<TwoElectronIntegrals> kup(shifted_kernel(up));
+    unique_ptr<TwoElectronIntegrals> kdn;
+    if (l > 0) kdn.reset(shifted_kernel(dn));
+
+    int n[4] = {base->na, base->nb, base->nc, base->nd};
+    int64_t nprim = (int64_t)n[0]*n[1]*n[2]*n[3];
+    int64_t stride = 1;
+    for (int i = 0;i < center;i++) stride *= n[i];
+
+    int fca = base->fca, fcb = base->fcb, fcc = base->fcc, fcd = base->fcd;
+    int64_t len = fca*fcb*fcc*fcd;
+    int64_t lenup = kup->fca*kup->fcb*kup->fcc*kup->fcd;
+    int64_t lendn = (kdn ? kdn->fca*kdn->fcb*kdn->fcc*kdn->fcd : 0);
+    int64_t ncontr = base->ma*base->mb*base->mc*base->md;
+    int64_t nspher = base->fsa*base->fsb*base->fsc*base->fsd;
+
+    const vec3& posa = sa.getCenter().getCenter(0);
+    const vec3& posb = sb.getCenter().getCenter(0);
+    const vec3& posc = sc.getCenter().getCenter(0);
+    const vec3& posd = sd.getCenter().getCenter(0);
+
+    vector<double> pup(lenup*nprim);
+    kup->prims(posa, posb, posc, posd, pup.data());
+
+    vector<double> pdn(lendn*nprim);
+    if (kdn) kdn->prims(posa, posb, posc, posd, pdn.data());
+
+    vector<array<int,3>> cart[4] = {cartesians(base->la), cartesians(base->lb),
+                                    cartesians(base->lc), cartesians(base->ld)};
+
+    auto offset = [](const TwoElectronIntegrals& k, const array<int,3> (&p)[4])
+    {
+        return ((func(p[3])*k.fcc+func(p[2]))*k.fcb+func(p[1]))*k.fca+func(p[0]);
+    };
+
+    size_t nint = base->ints.size();
+    vector<double> ints(3*nint);
+    vector<double> buf1(len*max(base->na,base->ma)*max(base->nb,base->mb)*
+                            max(base->nc,base->mc)*max(base->nd,base->md));
+    vector<double> buf2(buf1.size());
+
+    for (int xyz = 0;xyz < 3;xyz++)
+    {
+        #pragma omp parallel for
+        for (int64_t j = 0;j < nprim;j++)
+        {
+            double z2 = 2*zeta[(j/stride)%n[center]];
+
+            for (int d = 0;d < fcd;d++)
+            {
+                for (int c = 0;c < fcc;c++)
+                {
+                    for (int b = 0;b < fcb;b++)
+                    {
+                        for (int a = 0;a < fca;a++)
+                        {
+                            array<int,3> p[4] = {cart[0][a], cart[1][b], cart[2][c], cart[3][d]};
+                            int m = p[center][xyz];
+
+                            p[center][xyz]++;
+                            double v = z2*pup[j*lenup+offset(*kup, p)];
+
+                            if (m > 0)
+                            {
+                                p[center][xyz] -= 2;
+                                v -= m*pdn[j*lendn+offset(*kdn, p)];
+                            }
+
+                            buf1[j*len+((d*fcc+c)*fcb+b)*fca+a] = v;
+                        }
+                    }
+                }
+            }
+        }
+
+        base->prim2contr4r(len, buf1.data(), buf2.data());
+        base->cart2spher4r(ncontr, buf2.data(), buf1.data());
+        transpose(nspher, ncontr, 1.0, buf1.data(), nspher,
+                                  0.0, ints.data()+xyz*nint, ncontr);
+    }
+
+    return ints;
+}
+
+}
+}
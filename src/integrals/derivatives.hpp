@@ -0,0 +1,77 @@
+#ifndef _AQUARIUS_INTEGRALS_DERIVATIVES_HPP_
+#define _AQUARIUS_INTEGRALS_DERIVATIVES_HPP_
+
+#include "util/global.hpp"
+
+#include "1eints.hpp"
+#include "2eints.hpp"
+
+namespace aquarius
+{
+namespace integrals
+{
+
+/*
+ * First derivatives of the integrals over a set of shells with respect to the
+ * position of one of their centers. The primitive derivative integrals are
+ * formed from primitive integrals of the same kind over a shell of one higher
+ * and one lower angular momentum on that center,
+ *
+ *  d/dA_x (a|...) = 2 zeta_a (a+1_x|...) - a_x (a-1_x|...),
+ *
+ * and are then contracted and transformed to spherical harmonics exactly as
+ * the integrals themselves. The result holds the x, y, and z derivatives one
+ * after the other, each in the layout of getIntegrals().
+ *
+ * Only C1 is supported, so that the AO and SO integrals are the same.
+ */
+class OneElectronDerivatives
+{
+    public:
+        typedef std::function<OneElectronIntegrals*(const Shell&, const Shell&)> Kernel;
+
+    protected:
+        const Shell& sa;
+        const Shell& sb;
+        Kernel kernel;
+
+    public:
+        OneElectronDerivatives(const Shell& a, const Shell& b, const Kernel& kernel)
+        : sa(a), sb(b), kernel(kernel) {}
+
+        /*
+         * Derivatives with respect to the center of a (0) or b (1)
+         */
+        vector<double> run(int center) const;
+};
+
+class TwoElectronDerivatives
+{
+    public:
+        typedef std::function<TwoElectronIntegrals*(const Shell&, const Shell&,
+                                                    const Shell&, const Shell&)> Kernel;
+
+    protected:
+        const Shell& sa;
+        const Shell& sb;
+        const Shell& sc;
+        const Shell& sd;
+        Kernel kernel;
+
+    public:
+        TwoElectronDerivatives(const Shell& a, const Shell& b, const Shell& c, const Shell& d,
+                               const Kernel& kernel)
+        : sa(a), sb(b), sc(c), sd(d), kernel(kernel) {}
+
+        /*
+         * Derivatives with respect to the center of a (0), b (1), c (2), or
+         * d (3); the last is usually cheaper to get from translational
+         * invariance as minus the sum of the other three
+         */
+        vector<double> run(int center) const;
+};
+
+}
+}
+
+#endif
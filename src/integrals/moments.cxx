@@ -5,60 +5,133 @@ namespace aquarius
 namespace integrals
 {
 
+OSMoments::OSMoments(const Shell& a, const Shell& b, const vec3& origin, int lmax, bool kinetic)
+: OneElectronIntegrals(a, b), origin(origin), lmax(lmax), kinetic(kinetic),
+  ncomp(getNumMoments(lmax)+(kinetic ? 1 : 0))
+{
+    assert(group.getOrder() == 1);
+    ints.resize(fsa*fsb*ma*mb*ncomp);
+}
+
+void OSMoments::run()
+{
+    const vec3& posa = ca.getCenter(0);
+    const vec3& posb = cb.getCenter(0);
+
+    size_t ncart = fca*fcb;
+    size_t nspher = fsa*fsb*ma*mb;
+
+    vector<double> buf1(ncart*max(na,ma)*max(nb,mb)*ncomp);
+    vector<double> buf2(buf1.size());
+
+    prims(posa, posb, buf1.data());
+    prim2contr2r(ncart*ncomp, buf1.data(), buf2.data());
+
+    /*
+     * Each component is now a contiguous block of contracted cartesian
+     * integrals, so transform them one at a time as in spher()
+     */
+    for (int comp = 0;comp < ncomp;comp++)
+    {
+        double* block = buf2.data()+comp*ncart*ma*mb;
+        cart2spher2r(ma*mb, block, buf1.data());
+        transpose(fsa*fsb, ma*mb, 1.0, buf1.data(), fsa*fsb,
+                                  0.0, ints.data()+comp*nspher, ma*mb);
+    }
+}
+
 /*
  * Calculate moment integrals with the algorithm of Obara and Saika
  *  S. Obara; A. Saika, J. Chem. Phys. 84, 3963 (1986)
+ *
+ * The x, y, and z factors of each integral are tabulated once per primitive
+ * pair up to the highest order needed by any component. The kinetic energy
+ * integrals come from the same tables, using
+ *
+ *  T_x(a,b) = 1/2 <d/dx a|d/dx b>
+ *           = 1/2 [ab S(a-1,b-1) - 2 z_b a S(a-1,b+1)
+ *                  - 2 z_a b S(a+1,b-1) + 4 z_a z_b S(a+1,b+1)]
  */
-void OSMoments::prim(const vec3& posa, int e,
-                     const vec3& posb, int f, double* integrals)
+void OSMoments::prims(const vec3& posa, const vec3& posb, double* integrals)
 {
-    constexpr double PI_32 = 5.5683279968317078452848179821188;
+    constexpr double PI_32 = 5.5683279968317078452848179821188; // pi^(3/2)
 
-    double zp = za[e] + zb[f];
-    double A0 = PI_32*exp(-za[e]*zb[f]*norm2(posa-posb)/zp)/pow(zp, 1.5);
+    int k = (kinetic ? 1 : 0);
+    int nmom = getNumMoments(lmax);
 
-    vec3 posp = (posa*za[e] + posb*zb[f])/zp;
+    #pragma omp parallel for
+    for (int m = 0;m < na*nb;m++)
+    {
+        int f = m/na;
+        int e = m%na;
 
-    vec3 afac = posp - posa;
-    vec3 bfac = posp - posb;
-    vec3 cfac = posp - posc;
-    double sfac = 1.0/(2*zp);
+        double zp = za[e] + zb[f];
+        double A0 = PI_32*exp(-za[e]*zb[f]*norm2(posa-posb)/zp)/pow(zp, 1.5);
 
-    marray<double,3> table(la+1, lb+1, lc+1);
-    table[0][0][0] = A0;
+        vec3 posp = (posa*za[e] + posb*zb[f])/zp;
+        vec3 afac = posp - posa;
+        vec3 bfac = posp - posb;
+        vec3 cfac = posp - origin;
+        double sfac = 1.0/(2*zp);
 
-    marray_view<double,3> integral((la+1)*(la+2)/2, (lb+1)*(lb+2)/2, (lc+1)*(lc+2)/2, integrals);
+        marray<double,3> tx(la+k+1, lb+k+1, lmax+1);
+        marray<double,3> ty(la+k+1, lb+k+1, lmax+1);
+        marray<double,3> tz(la+k+1, lb+k+1, lmax+1);
 
-    // fill table with x
-    filltable(afac[0], bfac[0], cfac[0], sfac, table);
+        tx[0][0][0] = A0;
+        ty[0][0][0] = 1.0;
+        tz[0][0][0] = 1.0;
+
+        filltable(afac[0], bfac[0], cfac[0], sfac, tx);
+        filltable(afac[1], bfac[1], cfac[1], sfac, ty);
+        filltable(afac[2], bfac[2], cfac[2], sfac, tz);
+
+        double* prim = integrals+fca*fcb*ncomp*m;
 
-    // loop over all possible distributions of x momenta
-    for (int cx = lc;cx >= 0;cx--)
-    {
         for (int bx = lb;bx >= 0;bx--)
         {
-            for (int ax = la;ax >= 0;ax--)
+            for (int by = lb-bx;by >= 0;by--)
             {
-                // and fill remainder with y from that point
-                filltable(afac[1], bfac[1], cfac[1], sfac,
-                          table[range(ax,la+1)][range(bx,lb+1)][range(cx,lc+1)]);
-
-                // loop over all possible distirubtions of y momenta given x
-                for (int cy = lc-cx;cy >= 0;cy--)
+                int bz = lb-bx-by;
+                for (int ax = la;ax >= 0;ax--)
                 {
-                    for (int by = lb-bx;by >= 0;by--)
+                    for (int ay = la-ax;ay >= 0;ay--)
                     {
-                        for (int ay = la-ax;ay >= 0;ay--)
-                        {
-                            int az = la-ax-ay;
-                            int bz = lb-bx-by;
-                            int cz = lc-cx-cy;
+                        int az = la-ax-ay;
+                        int ab = XYZ(bx,by,bz)*fca+XYZ(ax,ay,az);
 
-                            // and fill remainder with z from that point
-                            filltable(afac[2], bfac[2], cfac[2], sfac,
-                                      table[range(ax+ay,la+1)][range(bx+by,lb+1)][range(cx+cy,lc+1)]);
+                        for (int L = 0;L <= lmax;L++)
+                        {
+                            int off = L*(L+1)*(L+2)/6;
+                            for (int cx = L;cx >= 0;cx--)
+                            {
+                                for (int cy = L-cx;cy >= 0;cy--)
+                                {
+                                    int cz = L-cx-cy;
+                                    prim[(off+XYZ(cx,cy,cz))*fca*fcb+ab] =
+                                        tx[ax][bx][cx]*ty[ay][by][cy]*tz[az][bz][cz];
+                                }
+                            }
+                        }
 
-                            integral[XYZ(ax,ay,az)][XYZ(bx,by,bz)][XYZ(cx,cy,cz)] = table[la][lb][lc];
+                        if (kinetic)
+                        {
+                            auto kin = [&](const marray<double,3>& t, int a, int b)
+                            {
+                                double v = 4*za[e]*zb[f]*t[a+1][b+1][0];
+                                if (a > 0)          v -= 2*zb[f]*a*t[a-1][b+1][0];
+                                if (b > 0)          v -= 2*za[e]*b*t[a+1][b-1][0];
+                                if (a > 0 && b > 0) v += a*b*t[a-1][b-1][0];
+                                return 0.5*v;
+                            };
+
+                            double sx = tx[ax][bx][0];
+                            double sy = ty[ay][by][0];
+                            double sz = tz[az][bz][0];
+
+                            prim[nmom*fca*fcb+ab] = kin(tx, ax, bx)*sy*sz +
+                                                    sx*kin(ty, ay, by)*sz +
+                                                    sx*sy*kin(tz, az, bz);
                         }
                     }
                 }
@@ -67,88 +140,44 @@ void OSMoments::prim(const vec3& posa, int e,
     }
 }
 
+/*
+ * Fill table[a][b][c] = (a|x_C^c|b) in one dimension, given table[0][0][0],
+ * so that each element only depends on ones already computed
+ */
 void OSMoments::filltable(double afac, double bfac, double cfac, double sfac,
-                          marray_view<double,3>&& table)
+                          marray<double,3>& table)
 {
     int la = table.length(0)-1;
     int lb = table.length(1)-1;
     int lc = table.length(2)-1;
 
-    table[0][0][1] = cfac*table[0][0][0];
-    table[0][1][0] = bfac*table[0][0][0];
-    table[1][0][0] = afac*table[0][0][0];
-
-    for (int c = 1;c < lc;c++)
-    {
-        table[0][0][c+1] =   cfac*table[0][0][  c] +
-                           c*sfac*table[0][0][c-1];
-    }
-
-    for (int b = 1;b < lb;b++)
-    {
-        table[0][b+1][0] =   bfac*table[0][  b][0] +
-                           b*sfac*table[0][b-1][0];
-    }
-
-    for (int a = 1;a < la;a++)
-    {
-        table[a+1][0][0] =   afac*table[  a][0][0] +
-                           a*sfac*table[a-1][0][0];
-    }
-
-    for (int b = 1;b <= lb;b++)
+    for (int c = 0;c <= lc;c++)
     {
-        table[1][b][0] =   afac*table[0][  b][0] +
-                         b*sfac*table[0][b-1][0];
-
-        for (int a = 1;a < la;a++)
+        for (int b = 0;b <= lb;b++)
         {
-            table[a+1][b][0] =   afac*table[  a][  b][0] +
-                               a*sfac*table[a-1][  b][0] +
-                               b*sfac*table[  a][b-1][0];
-        }
-    }
-
-    for (int c = 1;c <= lc;c++)
-    {
-        table[0][1][c] =   bfac*table[0][0][  c] +
-                         c*sfac*table[0][0][c-1];
-
-        for (int b = 1;b < lb;b++)
-        {
-            table[0][b+1][c] =   bfac*table[0][  b][  c] +
-                               b*sfac*table[0][b-1][  c] +
-                               c*sfac*table[0][  b][c-1];
-        }
-    }
-
-    for (int c = 1;c <= lc;c++)
-    {
-        table[1][0][c] =   afac*table[0][0][  c] +
-                         c*sfac*table[0][0][c-1];
-
-        for (int a = 1;a < la;a++)
-        {
-            table[a+1][0][c] =   afac*table[  a][0][  c] +
-                               a*sfac*table[a-1][0][  c] +
-                               c*sfac*table[  a][0][c-1];
-        }
-    }
-
-    for (int c = 1;c <= lc;c++)
-    {
-        for (int b = 1;b <= lb;b++)
-        {
-            table[1][b][c] =   afac*table[0][  b][  c] +
-                             b*sfac*table[0][b-1][  c] +
-                             c*sfac*table[0][  b][c-1];
-
-            for (int a = 1;a < la;a++)
+            for (int a = 0;a <= la;a++)
             {
-                table[a+1][b][c] =   afac*table[  a][  b][  c] +
-                                   a*sfac*table[a-1][  b][  c] +
-                                   b*sfac*table[  a][b-1][  c] +
-                                   c*sfac*table[  a][  b][c-1];
+                if (a > 0)
+                {
+                    double v = afac*table[a-1][b][c];
+                    if (a > 1) v += (a-1)*sfac*table[a-2][b  ][c  ];
+                    if (b > 0) v +=     b*sfac*table[a-1][b-1][c  ];
+                    if (c > 0) v +=     c*sfac*table[a-1][b  ][c-1];
+                    table[a][b][c] = v;
+                }
+                else if (b > 0)
+                {
+                    double v = bfac*table[0][b-1][c];
+                    if (b > 1) v += (b-1)*sfac*table[0][b-2][c  ];
+                    if (c > 0) v +=     c*sfac*table[0][b-1][c-1];
+                    table[0][b][c] = v;
+                }
+                else if (c > 0)
+                {
+                    double v = cfac*table[0][0][c-1];
+                    if (c > 1) v += (c-1)*sfac*table[0][0][c-2];
+                    table[0][0][c] = v;
+                }
             }
         }
     }
@@ -3,30 +3,61 @@
 
 #include "util/global.hpp"
 
-#include "shell.hpp"
+#include "1eints.hpp"
 
 namespace aquarius
 {
 namespace integrals
 {
 
+/*
+ * Cartesian multipole moment integrals about origin for all orders up to
+ * lmax (order 0 being the overlap) and, optionally, kinetic energy integrals,
+ * all from one set of Obara-Saika recursion tables per primitive pair.
+ *
+ * Component L, xyz of the moments is at index L*(L+1)*(L+2)/6 + xyz, where xyz
+ * is the index of the cartesian function with the same powers (see XYZ()),
+ * and the kinetic energy integrals, if requested, follow the moments. Each
+ * component is in the layout of getIntegrals() for a single operator.
+ *
+ * Only C1 is supported, as moments of non-zero order are not in general
+ * totally symmetric.
+ */
 class OSMoments : public OneElectronIntegrals
 {
     protected:
-        int lc;
-        vec3 posc;
+        vec3 origin;
+        int lmax;
+        bool kinetic;
+        int ncomp;
 
         void filltable(double afac, double bfac, double cfac, double sfac,
-                       marray_view<double,3>&& table);
+                       marray<double,3>& table);
 
     public:
         /*
          * Calculate moment integrals with the algorithm of Obara and Saika
          *  S. Obara; A. Saika, J. Chem. Phys. 84, 3963 (1986)
          */
-        void prim(const vec3& posa, int e,
-                  const vec3& posb, int f, double* integrals);
+        OSMoments(const Shell& a, const Shell& b, const vec3& origin, int lmax, bool kinetic = false);
+
+        void run();
+
+        using OneElectronIntegrals::getIntegrals;
+
+        int getNumComponents() const { return ncomp; }
+
+        size_t getNumIntegrals() const { return ints.size()/ncomp; }
+
+        const double* getIntegrals(int comp) const { return ints.data()+comp*getNumIntegrals(); }
+
+        static int getNumMoments(int lmax) { return (lmax+1)*(lmax+2)*(lmax+3)/6; }
+
+    protected:
+        void prims(const vec3& posa, const vec3& posb, double* integrals);
 };
 
 }
 }
+
+#endif
@@ -11,6 +11,37 @@ namespace aquarius
 namespace jellium
 {
 
+/*
+ * Momentum conservation, k_p+k_q = k_r+k_s, implies conservation of the
+ * parity of each integer component of k. These parities combine exactly as
+ * the irreps of D2h spanned by x^a y^b z^c, so labelling each plane wave by
+ * that irrep lets the usual symmetry blocking store and contract only the
+ * blocks which conserve momentum modulo 2 (1/8 of each four-index tensor).
+ * This is the largest quotient of the translation group with real
+ * characters, which PointGroup requires.
+ */
+static int momentumIrrep(const vec3& g)
+{
+    const PointGroup& group = PointGroup::D2h();
+
+    int x = lround(g[0]);
+    int y = lround(g[1]);
+    int z = lround(g[2]);
+
+    for (int i = 0;i < group.getNumIrreps();i++)
+    {
+        bool match = true;
+        for (int op = 0;op < group.getOrder();op++)
+        {
+            if (group.character(i, op) != group.cartesianParity(x, y, z, op)) match = false;
+        }
+        if (match) return i;
+    }
+
+    assert(0);
+    return 0;
+}
+
 template <typename U>
 Jellium<U>::Jellium(const string& name, Config& config)
 : Task(name, config),
@@ -62,6 +93,37 @@ Jellium<U>::Jellium(const string& name, Config& config)
     assert(0 < nocc && nocc <= norb);
     assert(nocc == norb || aquarius::abs(glen[nocc-1] - glen[nocc]) > 1e-12);
 
+    /*
+     * Plane waves form an abelian translation group: <pq|rs> vanishes unless
+     * k_p-k_r = k_s-k_q, so given p, q, and r there is at most one s. Build a
+     * lookup from momentum to orbital so that only the conserving elements
+     * are ever generated.
+     */
+    gmax = 0;
+    for (auto& g : gvecs)
+        for (int i = 0;i < 3;i++)
+            gmax = max(gmax, (int)aquarius::abs(lround(g[i])));
+
+    int ng = 2*gmax+1;
+    gindex.assign(ng*ng*ng, -1);
+    for (int p = 0;p < norb;p++)
+    {
+        int x = lround(gvecs[p][0])+gmax;
+        int y = lround(gvecs[p][1])+gmax;
+        int z = lround(gvecs[p][2])+gmax;
+        gindex[(x*ng+y)*ng+z] = p;
+    }
+
+    int nirrep = PointGroup::D2h().getNumIrreps();
+    nI.assign(nirrep, 0);
+    nA.assign(nirrep, 0);
+    for (int p = 0;p < norb;p++)
+    {
+        irrep.push_back(momentumIrrep(gvecs[p]));
+        vector<int>& n = (p < nocc ? nI : nA);
+        local.push_back(n[irrep[p]]++);
+    }
+
     V = nelec*(4.0/3.0)*M_PI*pow(radius,3);
     L = pow(V, 1.0/3.0);
     PotVm = 2.83729747948149/L;
@@ -70,33 +132,44 @@ Jellium<U>::Jellium(const string& name, Config& config)
 template <typename U>
 bool Jellium<U>::run(TaskDAG& dag, const Arena& arena)
 {
-    vector<vector<real_type_t<U>>> E{vector<real_type_t<U>>(norb)};
+    const PointGroup& group = PointGroup::D2h();
+    int nirrep = group.getNumIrreps();
 
-    int nvrt = norb-nocc;
+    vector<int> N(nirrep);
+    for (int h = 0;h < nirrep;h++) N[h] = nI[h]+nA[h];
+
+    vector<real_type_t<U>> e(norb);
 
     for (int i = 0;i < norb;i++)
     {
-        E[0][i] = 2*(M_PI/L)*(M_PI/L)*norm2(gvecs[i]);
+        e[i] = 2*(M_PI/L)*(M_PI/L)*norm2(gvecs[i]);
         for (int j = 0;j < nocc;j++)
         {
             if (i == j)
             {
-                E[0][i] -= PotVm;
+                e[i] -= PotVm;
             }
             else
             {
-                E[0][i] -= 1/(M_PI*L*norm2(gvecs[i]-gvecs[j]));
+                e[i] -= 1/(M_PI*L*norm2(gvecs[i]-gvecs[j]));
             }
         }
     }
 
+    /*
+     * Within each irrep the occupied orbitals come first, in the same order
+     * as globally
+     */
+    vector<vector<real_type_t<U>>> E(nirrep);
+    for (int p = 0;p < norb;p++) E[irrep[p]].push_back(e[p]);
+
     this->put("Ea", new vector<vector<real_type_t<U>>>(E));
     this->put("Eb", new vector<vector<real_type_t<U>>>(E));
 
     U energy = 0;
     for (int i = 0;i < nocc;i++)
     {
-        energy += 2*E[0][i];
+        energy += 2*e[i];
         for (int j = 0;j < nocc;j++)
         {
             if (i == j)
@@ -110,64 +183,53 @@ bool Jellium<U>::run(TaskDAG& dag, const Arena& arena)
         }
     }
 
-    auto& Fa = this->put("Fa", new SymmetryBlockedTensor<U>("Fa", arena, PointGroup::C1(), 2, {{norb},{norb}}, {NS,NS}, true));
-    auto& Fb = this->put("Fb", new SymmetryBlockedTensor<U>("Fb", arena, PointGroup::C1(), 2, {{norb},{norb}}, {NS,NS}, true));
-    auto& Da = this->put("Da", new SymmetryBlockedTensor<U>("Da", arena, PointGroup::C1(), 2, {{norb},{norb}}, {NS,NS}, true));
-    auto& Db = this->put("Db", new SymmetryBlockedTensor<U>("Db", arena, PointGroup::C1(), 2, {{norb},{norb}}, {NS,NS}, true));
+    auto& Fa = this->put("Fa", new SymmetryBlockedTensor<U>("Fa", arena, group, 2, {N,N}, {NS,NS}, true));
+    auto& Fb = this->put("Fb", new SymmetryBlockedTensor<U>("Fb", arena, group, 2, {N,N}, {NS,NS}, true));
+    auto& Da = this->put("Da", new SymmetryBlockedTensor<U>("Da", arena, group, 2, {N,N}, {NS,NS}, true));
+    auto& Db = this->put("Db", new SymmetryBlockedTensor<U>("Db", arena, group, 2, {N,N}, {NS,NS}, true));
     this->put("energy", new double(energy));
 
     Logger::log(arena) << "SCF energy = " << setprecision(15) << energy << endl;
 
-    vector<tkv_pair<U>> dpairs;
-    vector<tkv_pair<U>> fpairs;
-    for (int i = 0;i < nocc;i++)
-    {
-        dpairs.emplace_back(i*norb+i, 1);
-    }
-    for (int i = 0;i < norb;i++)
-    {
-        fpairs.emplace_back(i*norb+i, E[0][i]);
-    }
-
-    if (arena.rank == 0)
-    {
-        Da.writeRemoteData({0,0}, dpairs);
-        Fa.writeRemoteData({0,0}, fpairs);
-    }
-    else
-    {
-        Da.writeRemoteData({0,0});
-        Fa.writeRemoteData({0,0});
-    }
-    Db = Da;
-    Fb = Fa;
-
-    Space occ(PointGroup::C1(), {nocc}, {nocc});
-    Space vrt(PointGroup::C1(), {nvrt}, {nvrt});
+    Space occ(group, nI, nI);
+    Space vrt(group, nA, nA);
 
     auto& H = put("H", new TwoElectronOperator<U>("H", arena, occ, vrt));
 
-    vector<tkv_pair<U>> abpairs;
-    vector<tkv_pair<U>> ijpairs;
-    for (int i = 0;i < nocc;i++)
-    {
-        ijpairs.emplace_back(i*nocc+i, E[0][i]);
-    }
-    for (int i = 0;i < nvrt;i++)
-    {
-        abpairs.emplace_back(i*nvrt+i, E[0][i+nocc]);
-    }
+    vector<vector<tkv_pair<U>>> dpairs(nirrep), fpairs(nirrep);
+    vector<vector<tkv_pair<U>>> ijpairs(nirrep), abpairs(nirrep);
 
     if (arena.rank == 0)
     {
-        H.getAB()({0,0},{0,0}).writeRemoteData({0,0}, abpairs);
-        H.getIJ()({0,0},{0,0}).writeRemoteData({0,0}, ijpairs);
+        for (int p = 0;p < norb;p++)
+        {
+            int h = irrep[p];
+            if (p < nocc)
+            {
+                int i = local[p];
+                dpairs[h].emplace_back(i*N[h]+i, 1);
+                fpairs[h].emplace_back(i*N[h]+i, e[p]);
+                ijpairs[h].emplace_back(i*nI[h]+i, e[p]);
+            }
+            else
+            {
+                int a = local[p];
+                fpairs[h].emplace_back((nI[h]+a)*N[h]+nI[h]+a, e[p]);
+                abpairs[h].emplace_back(a*nA[h]+a, e[p]);
+            }
+        }
     }
-    else
+
+    for (int h = 0;h < nirrep;h++)
     {
-        H.getAB()({0,0},{0,0}).writeRemoteData({0,0});
-        H.getIJ()({0,0},{0,0}).writeRemoteData({0,0});
+        Da.writeRemoteData({h,h}, dpairs[h]);
+        Fa.writeRemoteData({h,h}, fpairs[h]);
+        H.getAB()({0,0},{0,0}).writeRemoteData({h,h}, abpairs[h]);
+        H.getIJ()({0,0},{0,0}).writeRemoteData({h,h}, ijpairs[h]);
     }
+    Db = Da;
+    Fb = Fa;
+
     H.getAB()({1,0},{1,0}) = H.getAB()({0,0},{0,0});
     H.getIJ()({0,1},{0,1}) = H.getIJ()({0,0},{0,0});
 
@@ -190,7 +252,6 @@ bool Jellium<U>::run(TaskDAG& dag, const Arena& arena)
      * <ai||jk>
      */
     writeIntegrals(true, false, false, false, H.getAIJK()({1,0},{0,1}));
-    SymmetryBlockedTensor<U> tmp(H.getAIJK()({1,0},{0,1}));
     H.getAIJK()({0,0},{0,0})["aijk"] =  H.getAIJK()({1,0},{0,1})["aijk"];
     H.getAIJK()({0,1},{0,1})["aIKj"] = -H.getAIJK()({1,0},{0,1})["aIjK"];
     H.getAIJK()({1,1},{0,2})["AIJK"] =  H.getAIJK()({1,0},{0,1})["AIJK"];
@@ -212,7 +273,7 @@ bool Jellium<U>::run(TaskDAG& dag, const Arena& arena)
     /*
      * <ai||bj>
      */
-    SymmetryBlockedTensor<U> aijb("aijb", arena, PointGroup::C1(), 4, {{nvrt},{nocc},{nocc},{nvrt}}, {NS,NS,NS,NS}, false);
+    SymmetryBlockedTensor<U> aijb("aijb", arena, group, 4, {nA,nI,nI,nA}, {NS,NS,NS,NS}, true);
     writeIntegrals(true, false, true, false, H.getAIBJ()({0,1},{0,1}));
     H.getAIBJ()({1,0},{1,0})["AiBj"] = H.getAIBJ()({0,1},{0,1})["AiBj"];
     writeIntegrals(true, false, false, true, aijb);
@@ -243,55 +304,97 @@ bool Jellium<U>::run(TaskDAG& dag, const Arena& arena)
     return true;
 }
 
+template <typename U>
+int Jellium<U>::momentumIndex(const vec3& g) const
+{
+    int x = lround(g[0]);
+    int y = lround(g[1]);
+    int z = lround(g[2]);
+
+    if (aquarius::abs(x) > gmax ||
+        aquarius::abs(y) > gmax ||
+        aquarius::abs(z) > gmax) return -1;
+
+    int ng = 2*gmax+1;
+    return gindex[((x+gmax)*ng+(y+gmax))*ng+(z+gmax)];
+}
+
 template <typename U>
 void Jellium<U>::writeIntegrals(bool pvirt, bool qvirt, bool rvirt, bool svirt,
                                 SymmetryBlockedTensor<U>& tensor)
 {
-    vector<tkv_pair<U>> pairs;
-    tensor.getLocalData({0,0,0,0}, pairs);
+    /*
+     * The tensor starts out zeroed, so only the O(N^3) momentum-conserving
+     * elements are generated (spread round-robin over (p,q) pairs) instead
+     * of touching all N^4 local elements. Each element lands in the block
+     * of the irreps of its four orbitals, indexed within that block.
+     */
+    const PointGroup& group = tensor.getGroup();
+    int nirrep = group.getNumIrreps();
+
+    const vector<int>& np = (pvirt ? nA : nI);
+    const vector<int>& nq = (qvirt ? nA : nI);
+    const vector<int>& nr = (rvirt ? nA : nI);
+    const vector<int>& ns = (svirt ? nA : nI);
+
+    int poff = (pvirt ? nocc : 0);
+    int qoff = (qvirt ? nocc : 0);
+    int roff = (rvirt ? nocc : 0);
+    int soff = (svirt ? nocc : 0);
+
+    int npg = (pvirt ? norb-nocc : nocc);
+    int nqg = (qvirt ? norb-nocc : nocc);
+    int nrg = (rvirt ? norb-nocc : nocc);
+    int nsg = (svirt ? norb-nocc : nocc);
+
+    map<vector<int>,vector<tkv_pair<U>>> pairs;
 
-    int np = (pvirt ? norb-nocc : nocc);
-    int nq = (qvirt ? norb-nocc : nocc);
-    int nr = (rvirt ? norb-nocc : nocc);
-    int ns = (svirt ? norb-nocc : nocc);
+    const Arena& arena = tensor.arena;
 
-    for (auto& pair : pairs)
+    for (int q = qoff;q < qoff+nqg;q++)
     {
-        auto k = pair.k;
-        int p = k%np;
-        k /= np;
-        int q = k%nq;
-        k /= nq;
-        int r = k%nr;
-        k /= nr;
-        int s = k;
-
-        if (pvirt) p += nocc;
-        if (qvirt) q += nocc;
-        if (rvirt) r += nocc;
-        if (svirt) s += nocc;
-
-        vec3 pr = gvecs[p]-gvecs[r];
-        vec3 sq = gvecs[s]-gvecs[q];
-
-        if (norm2(pr-sq) < 1e-12)
+        for (int p = poff;p < poff+npg;p++)
         {
-            if (p == r)
-            {
-                pair.d = PotVm;
-            }
-            else
+            if (((q-qoff)*npg+(p-poff))%arena.size != arena.rank) continue;
+
+            for (int r = roff;r < roff+nrg;r++)
             {
-                pair.d = 1/(M_PI*L*norm2(pr));
+                vec3 pr = gvecs[p]-gvecs[r];
+
+                int s = momentumIndex(pr+gvecs[q]);
+                if (s < soff || s >= soff+nsg) continue;
+
+                U val;
+                if (p == r)
+                {
+                    val = PotVm;
+                }
+                else
+                {
+                    val = 1/(M_PI*L*norm2(pr));
+                }
+
+                int hp = irrep[p], hq = irrep[q], hr = irrep[r], hs = irrep[s];
+
+                pairs[{hp,hq,hr,hs}].emplace_back(((local[s]*nr[hr]+local[r])*nq[hq]+local[q])*np[hp]+local[p], val);
             }
         }
-        else
-        {
-            pair.d = 0;
-        }
     }
 
-    tensor.writeRemoteData({0,0,0,0}, pairs);
+    /*
+     * Every rank must take part in the write to each allowed block, whether
+     * or not it has any elements there
+     */
+    for (int hp = 0;hp < nirrep;hp++)
+    for (int hq = 0;hq < nirrep;hq++)
+    for (int hr = 0;hr < nirrep;hr++)
+    for (int hs = 0;hs < nirrep;hs++)
+    {
+        if (!(group.getIrrep(hp)*group.getIrrep(hq)*
+              group.getIrrep(hr)*group.getIrrep(hs)).isTotallySymmetric()) continue;
+
+        tensor.writeRemoteData({hp,hq,hr,hs}, pairs[{hp,hq,hr,hs}]);
+    }
 }
 
 }
@@ -24,6 +24,22 @@ class Jellium : public task::Task
         double V;
         double L;
         double PotVm;
+        /*
+         * Dense lookup from an integer wavevector in [-gmax,gmax]^3 to the
+         * orbital carrying that momentum (or -1)
+         */
+        int gmax;
+        vector<int> gindex;
+        /*
+         * Irrep of each orbital in the momentum parity group, its index among
+         * the occupied or virtual orbitals of that irrep, and the number of
+         * occupied and virtual orbitals in each irrep
+         */
+        vector<int> irrep;
+        vector<int> local;
+        vector<int> nI, nA;
+
+        int momentumIndex(const vec3& g) const;
 
         void writeIntegrals(bool pvirt, bool qvirt, bool rvirt, bool svirt,
                             tensor::SymmetryBlockedTensor<U>& tensor);
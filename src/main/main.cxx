@@ -33,6 +33,11 @@ int main(int argc, char **argv)
     int status = 0;
 
     {
+        #ifdef TRACE
+        Tracer::init(world(), getenv("AQUARIUS_TRACE_FILE") != NULL ?
+                              getenv("AQUARIUS_TRACE_FILE") : "trace.json");
+        #endif
+
         if (world().rank == 0)
         {
             srand(::time(NULL));
@@ -150,6 +155,23 @@ int main(int argc, char **argv)
             //try
             //{
                 TaskDAG dag(argv[1]);
+                if (getenv("AQUARIUS_CHECKPOINT_DIR") != NULL)
+                {
+                    dag.setCheckpointDirectory(getenv("AQUARIUS_CHECKPOINT_DIR"));
+                }
+                if (getenv("AQUARIUS_CHECKPOINT_INTERVAL") != NULL)
+                {
+                    dag.setCheckpointInterval(getenv("AQUARIUS_CHECKPOINT_INTERVAL"));
+                }
+                if (getenv("AQUARIUS_REPORT_FILE") != NULL)
+                {
+                    dag.setReportFile(getenv("AQUARIUS_REPORT_FILE"));
+                }
+                if (getenv("AQUARIUS_THREAD_PROFILE") != NULL)
+                {
+                    dag.setThreadProfile(getenv("AQUARIUS_THREAD_PROFILE"),
+                                         getenv("AQUARIUS_TUNE_THREADS") != NULL);
+                }
                 dag.execute(world());
             //}
             //catch (const runtime_error& e)
@@ -160,6 +182,14 @@ int main(int argc, char **argv)
         }
 
         Timer::printTimers(world());
+
+        #ifdef PROFILE
+        Profiler::print(world());
+        #endif
+
+        #ifdef TRACE
+        Tracer::finish(world());
+        #endif
     }
 
     #ifdef HAVE_LIBINT2
@@ -122,6 +122,7 @@ T TwoElectronOperator<T>::dot(bool conja, const TwoElectronOperator<T>& A, bool
 }
 
 INSTANTIATE_SPECIALIZATIONS(TwoElectronOperator);
+INSTANTIATE_SINGLE_PRECISION(TwoElectronOperator);
 
 }
 }
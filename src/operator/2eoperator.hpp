@@ -62,7 +62,13 @@ class TwoElectronOperator : public OneElectronOperatorBase<T,TwoElectronOperator
         tensor::SpinorbitalTensor<T>& getAIBJ() { return aibj; }
         tensor::SpinorbitalTensor<T>& getAIBC() { return aibc; }
         tensor::SpinorbitalTensor<T>& getABCI() { return abci; }
-        tensor::SpinorbitalTensor<T>& getABCD() { return abcd; }
+        /*
+         * Operators which do not store the four-virtual block explicitly
+         * (see STTwoElectronOperator) override these to refuse direct
+         * access; use contractABCD and contractABCDLeft instead, which are
+         * correct for either kind of operator
+         */
+        virtual tensor::SpinorbitalTensor<T>& getABCD() { return abcd; }
 
         const tensor::SpinorbitalTensor<T>& getIJKL() const { return ijkl; }
         const tensor::SpinorbitalTensor<T>& getAIJK() const { return aijk; }
@@ -72,7 +78,23 @@ class TwoElectronOperator : public OneElectronOperatorBase<T,TwoElectronOperator
         const tensor::SpinorbitalTensor<T>& getAIBJ() const { return aibj; }
         const tensor::SpinorbitalTensor<T>& getAIBC() const { return aibc; }
         const tensor::SpinorbitalTensor<T>& getABCI() const { return abci; }
-        const tensor::SpinorbitalTensor<T>& getABCD() const { return abcd; }
+        virtual const tensor::SpinorbitalTensor<T>& getABCD() const { return abcd; }
+
+        /*
+         * Z(ab,ij) += alpha W(ab,ef) X(ef,ij)
+         */
+        virtual void contractABCD(T alpha, const tensor::SpinorbitalTensor<T>& X, tensor::SpinorbitalTensor<T>& Z) const
+        {
+            Z["abij"] += alpha*abcd["abef"]*X["efij"];
+        }
+
+        /*
+         * Z(ij,ab) += alpha X(ij,ef) W(ef,ab)
+         */
+        virtual void contractABCDLeft(T alpha, const tensor::SpinorbitalTensor<T>& X, tensor::SpinorbitalTensor<T>& Z) const
+        {
+            Z["ijab"] += alpha*X["ijef"]*abcd["efab"];
+        }
 };
 
 }
@@ -526,6 +526,152 @@ void pqrs_integrals<T>::collect(bool rles)
     PROFILE_STOP
 }
 
+/*
+ * Redistribute integrals in batches, overlapping the communication of
+ * batch k+1 with the processing of batch k
+ */
+template <typename T>
+void pqrs_integrals<T>::collect(bool rles, int nchunk, const std::function<void(pqrs_integrals<T>&)>& process)
+{
+    PROFILE_FUNCTION
+
+    Datatype IDX4_T_TYPE = MPI_TYPE_<uint16_t>::value()*4;
+
+    size_t nrs;
+    vector<size_t> rscount;
+    sortInts(rles, nrs, rscount);
+
+    int nproc = arena.size;
+    nchunk = max(nchunk, 1);
+
+    vector<size_t> rsoff(nrs+1, 0);
+    for (size_t rs = 0;rs < nrs;rs++) rsoff[rs+1] = rsoff[rs]+rscount[rs];
+
+    /*
+     * The rs pairs owned by each node are split into nchunk contiguous
+     * batches, and batch c of every node is exchanged in round c
+     */
+    vector<size_t> rsstart(nproc*nchunk+1);
+    for (int i = 0;i < nproc;i++)
+    {
+        size_t rs0 = (nrs*i)/nproc;
+        size_t rs1 = (nrs*(i+1))/nproc;
+        for (int c = 0;c < nchunk;c++)
+        {
+            rsstart[c+i*nchunk] = rs0+((rs1-rs0)*c)/nchunk;
+        }
+    }
+    rsstart[nproc*nchunk] = nrs;
+
+    vector<MPI_Int> sendcount(nproc*nchunk);
+    vector<MPI_Int> recvcount(nproc*nchunk);
+    for (int i = 0;i < nproc*nchunk;i++)
+    {
+        size_t count = rsoff[rsstart[i+1]]-rsoff[rsstart[i]];
+        assert(count <= numeric_limits<int>::max());
+        sendcount[i] = count;
+    }
+
+    PROFILE_SECTION(collect_comm)
+    arena.comm().Alltoall(const_cast<const vector<MPI_Int>&>(sendcount), recvcount);
+    PROFILE_STOP
+
+    struct batch
+    {
+        vector<T> sendints, recvints;
+        vector<idx4_t> sendidxs, recvidxs;
+        vector<MPI_Int> sendcount, senddispl, recvcount, recvdispl;
+        Request reqs[2];
+    };
+
+    batch batches[2];
+
+    auto post = [&](int c, batch& b)
+    {
+        b.sendcount.resize(nproc);
+        b.senddispl.resize(nproc);
+        b.recvcount.resize(nproc);
+        b.recvdispl.resize(nproc);
+
+        size_t nsend = 0, nrecv = 0;
+        for (int i = 0;i < nproc;i++)
+        {
+            b.sendcount[i] = sendcount[c+i*nchunk];
+            b.recvcount[i] = recvcount[c+i*nchunk];
+            b.senddispl[i] = nsend;
+            b.recvdispl[i] = nrecv;
+            nsend += b.sendcount[i];
+            nrecv += b.recvcount[i];
+            assert(nsend <= numeric_limits<int>::max() &&
+                   nrecv <= numeric_limits<int>::max());
+        }
+
+        b.sendints.resize(nsend);
+        b.sendidxs.resize(nsend);
+        b.recvints.resize(nrecv);
+        b.recvidxs.resize(nrecv);
+
+        for (int i = 0;i < nproc;i++)
+        {
+            size_t off = rsoff[rsstart[c+i*nchunk]];
+            copy_n(ints.begin()+off, b.sendcount[i], b.sendints.begin()+b.senddispl[i]);
+            copy_n(idxs.begin()+off, b.sendcount[i], b.sendidxs.begin()+b.senddispl[i]);
+        }
+
+        b.reqs[0] = arena.comm().Ialltoall(b.sendints, b.sendcount, b.senddispl,
+                                           b.recvints, b.recvcount, b.recvdispl);
+        b.reqs[1] = arena.comm().Ialltoall(b.sendidxs, b.sendcount, b.senddispl,
+                                           b.recvidxs, b.recvcount, b.recvdispl, IDX4_T_TYPE);
+    };
+
+    PROFILE_SECTION(collect_comm)
+    post(0, batches[0]);
+    PROFILE_STOP
+
+    for (int c = 0;c < nchunk;c++)
+    {
+        batch& cur = batches[c%2];
+
+        if (c+1 < nchunk)
+        {
+            PROFILE_SECTION(collect_comm)
+            post(c+1, batches[(c+1)%2]);
+            PROFILE_STOP
+        }
+
+        /*
+         * Time spent here is communication which could not be hidden
+         * behind the processing of the previous batch
+         */
+        PROFILE_SECTION(collect_wait)
+        cur.reqs[0].wait();
+        cur.reqs[1].wait();
+        PROFILE_STOP
+
+        pqrs_integrals<T> chunk(arena, group);
+        chunk.np = np;
+        chunk.nq = nq;
+        chunk.nr = nr;
+        chunk.ns = ns;
+        swap(chunk.ints, cur.recvints);
+        swap(chunk.idxs, cur.recvidxs);
+        cur.sendints.clear();
+        cur.sendidxs.clear();
+
+        size_t nrs_;
+        vector<size_t> rscount_;
+        chunk.sortInts(rles, nrs_, rscount_);
+
+        PROFILE_SECTION(collect_overlap)
+        process(chunk);
+        PROFILE_STOP
+    }
+
+    free();
+
+    PROFILE_STOP
+}
+
 template <typename T>
 abrs_integrals<T>::abrs_integrals(pqrs_integrals<T>& pqrs, const bool pleq)
 : Distributed(pqrs.arena), group(pqrs.group)
@@ -930,6 +1076,33 @@ void abrs_integrals<T>::free()
     rs.clear();
 }
 
+template <typename T>
+void abrs_integrals<T>::append(abrs_integrals<T>&& other)
+{
+    if (rs.empty())
+    {
+        na = other.na;
+        nb = other.nb;
+        nr = other.nr;
+        ns = other.ns;
+        swap(rs, other.rs);
+        swap(ints, other.ints);
+    }
+    else
+    {
+        assert(na == other.na && nb == other.nb);
+        assert(nr == other.nr && ns == other.ns);
+        assert(other.rs.empty() ||
+               other.rs.front().j  > rs.back().j ||
+              (other.rs.front().j == rs.back().j &&
+               other.rs.front().i  > rs.back().i));
+        rs.insert(rs.end(), other.rs.begin(), other.rs.end());
+        ints.insert(ints.end(), other.ints.begin(), other.ints.end());
+    }
+
+    other.free();
+}
+
 template <typename T>
 size_t abrs_integrals<T>::getNumAB(idx2_t rs)
 {
@@ -1011,6 +1184,9 @@ template <typename T>
 AOMOIntegrals<T>::AOMOIntegrals(const string& name, Config& config)
 : MOIntegrals<T>(name, config)
 {
+    nchunk = config.get<int>("collect_batches");
+    spin_adapt = config.get<bool>("spin_adapt");
+    restricted_tol = config.get<double>("restricted_tolerance");
     this->getProduct("H").addRequirement("eri", "I");
 }
 
@@ -1091,265 +1267,409 @@ bool AOMOIntegrals<T>::run(TaskDAG& dag, const Arena& arena)
         assert(ci[i].size() == N[i]*ni[i]);
     }
 
-    #define SHOWIT(name) cout << #name ": " << absmax(name.ints) << endl;
-
-    /*
-     * Resort integrals so that each node has (pq|r_k s_l) where pq
-     * are dense blocks for each sparse rs pair
-     */
-    pqrs_integrals<T> pqrs(N, ints);
-    pqrs.collect(true);
-    abrs_integrals<T> PQrs(pqrs, true);
-
-    /*
-     * First quarter-transformation
-     */
-    //SHOWIT(PQrs);
-    abrs_integrals<T> PArs = PQrs.transform(B, nA, cA);
-    //SHOWIT(PArs);
-    abrs_integrals<T> Pars = PQrs.transform(B, na, ca);
-    //SHOWIT(Pars);
-    abrs_integrals<T> PIrs = PQrs.transform(B, nI, cI);
-    //SHOWIT(PIrs);
-    abrs_integrals<T> Pirs = PQrs.transform(B, ni, ci);
-    //SHOWIT(Pirs);
-    PQrs.free();
-
-    /*
-     * Second quarter-transformation
-     */
-    abrs_integrals<T> ABrs = PArs.transform(A, nA, cA);
-    //SHOWIT(ABrs);
-    PArs.free();
-    abrs_integrals<T> abrs = Pars.transform(A, na, ca);
-    //SHOWIT(abrs);
-    Pars.free();
-    abrs_integrals<T> AIrs = PIrs.transform(A, nA, cA);
-    //SHOWIT(AIrs);
-    abrs_integrals<T> IJrs = PIrs.transform(A, nI, cI);
-    //SHOWIT(IJrs);
-    PIrs.free();
-    abrs_integrals<T> airs = Pirs.transform(A, na, ca);
-    //SHOWIT(airs);
-    abrs_integrals<T> ijrs = Pirs.transform(A, ni, ci);
-    //SHOWIT(ijrs);
-    Pirs.free();
-
-    /*
-     * Make <AB||CD>
-     */
-    pqrs_integrals<T> rsAB(ABrs);
-    rsAB.collect(false);
-
-    abrs_integrals<T> RSAB(rsAB, true);
-    //SHOWIT(RSAB)<T>;
-    abrs_integrals<T> RDAB = RSAB.transform(B, nA, cA);
-    //SHOWIT(RDAB);
-    RSAB.free();
-
-    abrs_integrals<T> CDAB = RDAB.transform(A, nA, cA);
-    //SHOWIT(CDAB);
-    RDAB.free();
-    CDAB.transcribe(H.getABCD()({2,0},{2,0}), true, true, NONE);
-    CDAB.free();
-
-    /*
-     * Make <Ab|Cd> and <ab||cd>
-     */
-    pqrs_integrals<T> rsab(abrs);
-    rsab.collect(false);
-
-    abrs_integrals<T> RSab(rsab, true);
-    //SHOWIT(RSab);
-    abrs_integrals<T> RDab = RSab.transform(B, nA, cA);
-    //SHOWIT(RDab);
-    abrs_integrals<T> Rdab = RSab.transform(B, na, ca);
-    //SHOWIT(Rdab);
-    RSab.free();
-
-    abrs_integrals<T> CDab = RDab.transform(A, nA, cA);
-    //SHOWIT(CDab);
-    RDab.free();
-    CDab.transcribe(H.getABCD()({1,0},{1,0}), false, false, NONE);
-    CDab.free();
-
-    abrs_integrals<T> cdab = Rdab.transform(A, na, ca);
-    //SHOWIT(cdab);
-    Rdab.free();
-    cdab.transcribe(H.getABCD()({0,0},{0,0}), true, true, NONE);
-    cdab.free();
-
-    /*
-     * Make <AB||CI>, <Ab|cI>, and <AB|IJ>
-     */
-    pqrs_integrals<T> rsAI(AIrs);
-    rsAI.collect(false);
-
-    abrs_integrals<T> RSAI(rsAI, true);
-    //SHOWIT(RSAI);
-    abrs_integrals<T> RCAI = RSAI.transform(B, nA, cA);
-    //SHOWIT(RCAI);
-    abrs_integrals<T> RcAI = RSAI.transform(B, na, ca);
-    //SHOWIT(RcAI);
-    abrs_integrals<T> RJAI = RSAI.transform(B, nI, cI);
-    //SHOWIT(RJAI);
-    RSAI.free();
-
-    abrs_integrals<T> BCAI = RCAI.transform(A, nA, cA);
-    //SHOWIT(BCAI);
-    RCAI.free();
-    BCAI.transcribe(H.getABCI()({2,0},{1,1}), true, false, NONE);
-    BCAI.free();
-
-    abrs_integrals<T> bcAI = RcAI.transform(A, na, ca);
-    //SHOWIT(bcAI);
-    RcAI.free();
-    bcAI.transcribe(H.getABCI()({1,0},{0,1}), false, false, PQ);
-    bcAI.free();
-
-    abrs_integrals<T> BJAI = RJAI.transform(A, nA, cA);
-    //SHOWIT(BJAI);
-    RJAI.free();
-    BJAI.transcribe(ABIJ__, false, false, NONE);
-    BJAI.free();
-
     /*
-     * Make <Ab|Ci>, <ab||ci>, <Ab|Ij>, and <ab|ij>
+     * Check for a restricted reference, in which case only one set
+     * of coefficients needs to be used
      */
-    pqrs_integrals<T> rsai(airs);
-    rsai.collect(false);
-
-    abrs_integrals<T> RSai(rsai, true);
-    //SHOWIT(RSai);
-    abrs_integrals<T> RCai = RSai.transform(B, nA, cA);
-    //SHOWIT(RCai);
-    abrs_integrals<T> Rcai = RSai.transform(B, na, ca);
-    //SHOWIT(Rcai);
-    abrs_integrals<T> RJai = RSai.transform(B, nI, cI);
-    //SHOWIT(RJai);
-    abrs_integrals<T> Rjai = RSai.transform(B, ni, ci);
-    //SHOWIT(Rjai);
-    RSai.free();
-
-    abrs_integrals<T> BCai = RCai.transform(A, nA, cA);
-    //SHOWIT(BCai);
-    RCai.free();
-    BCai.transcribe(H.getABCI()({1,0},{1,0}), false, false, NONE);
-    BCai.free();
-
-    abrs_integrals<T> bcai = Rcai.transform(A, na, ca);
-    //SHOWIT(bcai);
-    Rcai.free();
-    bcai.transcribe(H.getABCI()({0,0},{0,0}), true, false, NONE);
-    bcai.free();
-
-    abrs_integrals<T> BJai = RJai.transform(A, nA, cA);
-    //SHOWIT(BJai);
-    RJai.free();
-    BJai.transcribe(H.getABIJ()({1,0},{0,1}), false, false, NONE);
-    BJai.free();
-
-    abrs_integrals<T> bjai = Rjai.transform(A, na, ca);
-    //SHOWIT(bjai);
-    Rjai.free();
-    bjai.transcribe(abij__, false, false, NONE);
-    bjai.free();
+    bool restricted = spin_adapt && nA == na && nI == ni;
+    for (int i = 0;i < n && restricted;i++)
+    {
+        for (size_t j = 0;j < cA[i].size() && restricted;j++)
+        {
+            if (aquarius::abs(cA[i][j]-ca[i][j]) > restricted_tol) restricted = false;
+        }
+        for (size_t j = 0;j < cI[i].size() && restricted;j++)
+        {
+            if (aquarius::abs(cI[i][j]-ci[i][j]) > restricted_tol) restricted = false;
+        }
+    }
 
-    /*
-     * Make <IJ||KL>, <AI||JK>, <aI|Jk>, <aI|bJ>, and <AI|BJ>
-     */
-    pqrs_integrals<T> rsIJ(IJrs);
-    rsIJ.collect(false);
-
-    abrs_integrals<T> RSIJ(rsIJ, true);
-    //SHOWIT(RSIJ);
-    abrs_integrals<T> RBIJ = RSIJ.transform(B, nA, cA);
-    //SHOWIT(RBIJ);
-    abrs_integrals<T> RbIJ = RSIJ.transform(B, na, ca);
-    //SHOWIT(RbIJ);
-    abrs_integrals<T> RLIJ = RSIJ.transform(B, nI, cI);
-    //SHOWIT(RLIJ);
-    abrs_integrals<T> RlIJ = RSIJ.transform(B, ni, ci);
-    //SHOWIT(RlIJ);
-    RSIJ.free();
-
-    abrs_integrals<T> ABIJ = RBIJ.transform(A, nA, cA);
-    //SHOWIT(ABIJ);
-    RBIJ.free();
-    ABIJ.transcribe(H.getAIBJ()({1,1},{1,1}), false, false, NONE);
-    ABIJ.free();
-
-    abrs_integrals<T> abIJ = RbIJ.transform(A, na, ca);
-    //SHOWIT(abIJ);
-    RbIJ.free();
-    abIJ.transcribe(H.getAIBJ()({0,1},{0,1}), false, false, NONE);
-    abIJ.free();
-
-    abrs_integrals<T> akIJ = RlIJ.transform(A, na, ca);
-    //SHOWIT(akIJ);
-    RlIJ.free();
-    akIJ.transcribe(H.getAIJK()({0,1},{0,1}), false, false, RS);
-    akIJ.free();
-
-    abrs_integrals<T> AKIJ = RLIJ.transform(A, nA, cA);
-    //SHOWIT(AKIJ);
-    abrs_integrals<T> KLIJ = RLIJ.transform(A, nI, cI);
-    //SHOWIT(KLIJ);
-    RLIJ.free();
-    AKIJ.transcribe(H.getAIJK()({1,1},{0,2}), false, true, NONE);
-    AKIJ.free();
-    KLIJ.transcribe(H.getIJKL()({0,2},{0,2}), true, true, NONE);
-    KLIJ.free();
+    #define SHOWIT(name) cout << #name ": " << absmax(name.ints) << endl;
 
-    /*
-     * Make <Ij|Kl>, <ij||kl>, <Ai|Jk>, <ai||jk>, <Ai|Bj>, and <ai|bj>
-     */
-    pqrs_integrals<T> rsij(ijrs);
-    rsij.collect(false);
-
-    abrs_integrals<T> RSij(rsij, true);
-    //SHOWIT(RSij);
-    abrs_integrals<T> RBij = RSij.transform(B, nA, cA);
-    //SHOWIT(RBij);
-    abrs_integrals<T> Rbij = RSij.transform(B, na, ca);
-    //SHOWIT(Rbij);
-    abrs_integrals<T> RLij = RSij.transform(B, nI, cI);
-    //SHOWIT(RLij);
-    abrs_integrals<T> Rlij = RSij.transform(B, ni, ci);
-    //SHOWIT(Rlij);
-    RSij.free();
-
-    abrs_integrals<T> ABij = RBij.transform(A, nA, cA);
-    //SHOWIT(ABij);
-    RBij.free();
-    ABij.transcribe(H.getAIBJ()({1,0},{1,0}), false, false, NONE);
-    ABij.free();
-
-    abrs_integrals<T> abij = Rbij.transform(A, na, ca);
-    //SHOWIT(abij);
-    Rbij.free();
-    abij.transcribe(H.getAIBJ()({0,0},{0,0}), false, false, NONE);
-    abij.free();
-
-    abrs_integrals<T> AKij = RLij.transform(A, nA, cA);
-    //SHOWIT(AKij);
-    abrs_integrals<T> KLij = RLij.transform(A, nI, cI);
-    //SHOWIT(KLij);
-    RLij.free();
-    AKij.transcribe(H.getAIJK()({1,0},{0,1}), false, false, NONE);
-    AKij.free();
-    KLij.transcribe(H.getIJKL()({0,1},{0,1}), false, false, NONE);
-    KLij.free();
-
-    abrs_integrals<T> akij = Rlij.transform(A, na, ca);
-    //SHOWIT(akij);
-    abrs_integrals<T> klij = Rlij.transform(A, ni, ci);
-    //SHOWIT(klij);
-    Rlij.free();
-    akij.transcribe(H.getAIJK()({0,0},{0,0}), false, true, NONE);
-    akij.free();
-    klij.transcribe(H.getIJKL()({0,0},{0,0}), true, true, NONE);
-    klij.free();
+    if (restricted)
+    {
+        this->log(arena) << "Restricted reference detected, using spin-adapted transformation" << endl;
+
+        /*
+         * Resort integrals so that each node has (pq|r_k s_l) where pq
+         * are dense blocks for each sparse rs pair
+         */
+        pqrs_integrals<T> pqrs(N, ints);
+
+        /*
+         * First quarter-transformation, done batch-wise as the (rs) pairs arrive
+         *
+         * With Calpha == Cbeta only the alpha coefficients are needed, and
+         * each beta or mixed-spin block is the same spatial integral as
+         * an alpha block
+         */
+        abrs_integrals<T> PArs(arena, ints.group);
+        abrs_integrals<T> PIrs(arena, ints.group);
+        pqrs.collect(true, nchunk,
+        [&](pqrs_integrals<T>& chunk)
+        {
+            abrs_integrals<T> PQrs(chunk, true);
+            PArs.append(PQrs.transform(B, nA, cA));
+            PIrs.append(PQrs.transform(B, nI, cI));
+            PQrs.free();
+        });
+
+        /*
+         * Second quarter-transformation
+         */
+        abrs_integrals<T> ABrs = PArs.transform(A, nA, cA);
+        PArs.free();
+        abrs_integrals<T> AIrs = PIrs.transform(A, nA, cA);
+        abrs_integrals<T> IJrs = PIrs.transform(A, nI, cI);
+        PIrs.free();
+
+        /*
+         * Make <AB||CD>, <Ab|Cd>, and <ab||cd>
+         */
+        pqrs_integrals<T> rsAB(ABrs);
+        rsAB.collect(false);
+
+        abrs_integrals<T> RSAB(rsAB, true);
+        abrs_integrals<T> RDAB = RSAB.transform(B, nA, cA);
+        RSAB.free();
+
+        abrs_integrals<T> CDAB = RDAB.transform(A, nA, cA);
+        RDAB.free();
+        CDAB.transcribe(H.getABCD()({2,0},{2,0}), true, true, NONE);
+        CDAB.transcribe(H.getABCD()({1,0},{1,0}), false, false, NONE);
+        CDAB.free();
+
+        H.getABCD()({0,0},{0,0})["abcd"] = H.getABCD()({2,0},{2,0})["abcd"];
+
+        /*
+         * Make <AB||CI>, <Ab|Ci>, <Ab|cI>, <ab||ci>, <AB|IJ>, and <Ab|Ij>
+         */
+        pqrs_integrals<T> rsAI(AIrs);
+        rsAI.collect(false);
+
+        abrs_integrals<T> RSAI(rsAI, true);
+        abrs_integrals<T> RCAI = RSAI.transform(B, nA, cA);
+        abrs_integrals<T> RJAI = RSAI.transform(B, nI, cI);
+        RSAI.free();
+
+        abrs_integrals<T> BCAI = RCAI.transform(A, nA, cA);
+        RCAI.free();
+        BCAI.transcribe(H.getABCI()({2,0},{1,1}), true, false, NONE);
+        BCAI.transcribe(H.getABCI()({1,0},{1,0}), false, false, NONE);
+        BCAI.transcribe(H.getABCI()({1,0},{0,1}), false, false, PQ);
+        BCAI.free();
+
+        H.getABCI()({0,0},{0,0})["abci"] = H.getABCI()({2,0},{1,1})["abci"];
+
+        abrs_integrals<T> BJAI = RJAI.transform(A, nA, cA);
+        RJAI.free();
+        BJAI.transcribe(ABIJ__, false, false, NONE);
+        BJAI.transcribe(H.getABIJ()({1,0},{0,1}), false, false, NONE);
+        BJAI.free();
+
+        abij__["abij"] = ABIJ__["abij"];
+
+        /*
+         * Make <IJ||KL>, <Ij|Kl>, <ij||kl>, the four <ai|jk>, and the four <ai|bj>
+         */
+        pqrs_integrals<T> rsIJ(IJrs);
+        rsIJ.collect(false);
+
+        abrs_integrals<T> RSIJ(rsIJ, true);
+        abrs_integrals<T> RBIJ = RSIJ.transform(B, nA, cA);
+        abrs_integrals<T> RLIJ = RSIJ.transform(B, nI, cI);
+        RSIJ.free();
+
+        abrs_integrals<T> ABIJ = RBIJ.transform(A, nA, cA);
+        RBIJ.free();
+        ABIJ.transcribe(H.getAIBJ()({1,1},{1,1}), false, false, NONE);
+        ABIJ.transcribe(H.getAIBJ()({0,1},{0,1}), false, false, NONE);
+        ABIJ.transcribe(H.getAIBJ()({1,0},{1,0}), false, false, NONE);
+        ABIJ.free();
+
+        H.getAIBJ()({0,0},{0,0})["aibj"] = H.getAIBJ()({1,1},{1,1})["aibj"];
+
+        abrs_integrals<T> AKIJ = RLIJ.transform(A, nA, cA);
+        abrs_integrals<T> KLIJ = RLIJ.transform(A, nI, cI);
+        RLIJ.free();
+        AKIJ.transcribe(H.getAIJK()({1,1},{0,2}), false, true, NONE);
+        AKIJ.transcribe(H.getAIJK()({0,1},{0,1}), false, false, RS);
+        AKIJ.transcribe(H.getAIJK()({1,0},{0,1}), false, false, NONE);
+        AKIJ.free();
+        KLIJ.transcribe(H.getIJKL()({0,2},{0,2}), true, true, NONE);
+        KLIJ.transcribe(H.getIJKL()({0,1},{0,1}), false, false, NONE);
+        KLIJ.free();
+
+        H.getAIJK()({0,0},{0,0})["aijk"] = H.getAIJK()({1,1},{0,2})["aijk"];
+        H.getIJKL()({0,0},{0,0})["ijkl"] = H.getIJKL()({0,2},{0,2})["ijkl"];
+    }
+    else
+    {
+        /*
+         * Resort integrals so that each node has (pq|r_k s_l) where pq
+         * are dense blocks for each sparse rs pair
+         */
+        pqrs_integrals<T> pqrs(N, ints);
+
+        /*
+         * First quarter-transformation, done batch-wise as the (rs) pairs arrive
+         */
+        abrs_integrals<T> PArs(arena, ints.group);
+        abrs_integrals<T> Pars(arena, ints.group);
+        abrs_integrals<T> PIrs(arena, ints.group);
+        abrs_integrals<T> Pirs(arena, ints.group);
+        pqrs.collect(true, nchunk,
+        [&](pqrs_integrals<T>& chunk)
+        {
+            abrs_integrals<T> PQrs(chunk, true);
+            //SHOWIT(PQrs);
+            PArs.append(PQrs.transform(B, nA, cA));
+            Pars.append(PQrs.transform(B, na, ca));
+            PIrs.append(PQrs.transform(B, nI, cI));
+            Pirs.append(PQrs.transform(B, ni, ci));
+            PQrs.free();
+        });
+        //SHOWIT(PArs);
+        //SHOWIT(Pars);
+        //SHOWIT(PIrs);
+        //SHOWIT(Pirs);
+
+        /*
+         * Second quarter-transformation
+         */
+        abrs_integrals<T> ABrs = PArs.transform(A, nA, cA);
+        //SHOWIT(ABrs);
+        PArs.free();
+        abrs_integrals<T> abrs = Pars.transform(A, na, ca);
+        //SHOWIT(abrs);
+        Pars.free();
+        abrs_integrals<T> AIrs = PIrs.transform(A, nA, cA);
+        //SHOWIT(AIrs);
+        abrs_integrals<T> IJrs = PIrs.transform(A, nI, cI);
+        //SHOWIT(IJrs);
+        PIrs.free();
+        abrs_integrals<T> airs = Pirs.transform(A, na, ca);
+        //SHOWIT(airs);
+        abrs_integrals<T> ijrs = Pirs.transform(A, ni, ci);
+        //SHOWIT(ijrs);
+        Pirs.free();
+
+        /*
+         * Make <AB||CD>
+         */
+        pqrs_integrals<T> rsAB(ABrs);
+        rsAB.collect(false);
+
+        abrs_integrals<T> RSAB(rsAB, true);
+        //SHOWIT(RSAB)<T>;
+        abrs_integrals<T> RDAB = RSAB.transform(B, nA, cA);
+        //SHOWIT(RDAB);
+        RSAB.free();
+
+        abrs_integrals<T> CDAB = RDAB.transform(A, nA, cA);
+        //SHOWIT(CDAB);
+        RDAB.free();
+        CDAB.transcribe(H.getABCD()({2,0},{2,0}), true, true, NONE);
+        CDAB.free();
+
+        /*
+         * Make <Ab|Cd> and <ab||cd>
+         */
+        pqrs_integrals<T> rsab(abrs);
+        rsab.collect(false);
+
+        abrs_integrals<T> RSab(rsab, true);
+        //SHOWIT(RSab);
+        abrs_integrals<T> RDab = RSab.transform(B, nA, cA);
+        //SHOWIT(RDab);
+        abrs_integrals<T> Rdab = RSab.transform(B, na, ca);
+        //SHOWIT(Rdab);
+        RSab.free();
+
+        abrs_integrals<T> CDab = RDab.transform(A, nA, cA);
+        //SHOWIT(CDab);
+        RDab.free();
+        CDab.transcribe(H.getABCD()({1,0},{1,0}), false, false, NONE);
+        CDab.free();
+
+        abrs_integrals<T> cdab = Rdab.transform(A, na, ca);
+        //SHOWIT(cdab);
+        Rdab.free();
+        cdab.transcribe(H.getABCD()({0,0},{0,0}), true, true, NONE);
+        cdab.free();
+
+        /*
+         * Make <AB||CI>, <Ab|cI>, and <AB|IJ>
+         */
+        pqrs_integrals<T> rsAI(AIrs);
+        rsAI.collect(false);
+
+        abrs_integrals<T> RSAI(rsAI, true);
+        //SHOWIT(RSAI);
+        abrs_integrals<T> RCAI = RSAI.transform(B, nA, cA);
+        //SHOWIT(RCAI);
+        abrs_integrals<T> RcAI = RSAI.transform(B, na, ca);
+        //SHOWIT(RcAI);
+        abrs_integrals<T> RJAI = RSAI.transform(B, nI, cI);
+        //SHOWIT(RJAI);
+        RSAI.free();
+
+        abrs_integrals<T> BCAI = RCAI.transform(A, nA, cA);
+        //SHOWIT(BCAI);
+        RCAI.free();
+        BCAI.transcribe(H.getABCI()({2,0},{1,1}), true, false, NONE);
+        BCAI.free();
+
+        abrs_integrals<T> bcAI = RcAI.transform(A, na, ca);
+        //SHOWIT(bcAI);
+        RcAI.free();
+        bcAI.transcribe(H.getABCI()({1,0},{0,1}), false, false, PQ);
+        bcAI.free();
+
+        abrs_integrals<T> BJAI = RJAI.transform(A, nA, cA);
+        //SHOWIT(BJAI);
+        RJAI.free();
+        BJAI.transcribe(ABIJ__, false, false, NONE);
+        BJAI.free();
+
+        /*
+         * Make <Ab|Ci>, <ab||ci>, <Ab|Ij>, and <ab|ij>
+         */
+        pqrs_integrals<T> rsai(airs);
+        rsai.collect(false);
+
+        abrs_integrals<T> RSai(rsai, true);
+        //SHOWIT(RSai);
+        abrs_integrals<T> RCai = RSai.transform(B, nA, cA);
+        //SHOWIT(RCai);
+        abrs_integrals<T> Rcai = RSai.transform(B, na, ca);
+        //SHOWIT(Rcai);
+        abrs_integrals<T> RJai = RSai.transform(B, nI, cI);
+        //SHOWIT(RJai);
+        abrs_integrals<T> Rjai = RSai.transform(B, ni, ci);
+        //SHOWIT(Rjai);
+        RSai.free();
+
+        abrs_integrals<T> BCai = RCai.transform(A, nA, cA);
+        //SHOWIT(BCai);
+        RCai.free();
+        BCai.transcribe(H.getABCI()({1,0},{1,0}), false, false, NONE);
+        BCai.free();
+
+        abrs_integrals<T> bcai = Rcai.transform(A, na, ca);
+        //SHOWIT(bcai);
+        Rcai.free();
+        bcai.transcribe(H.getABCI()({0,0},{0,0}), true, false, NONE);
+        bcai.free();
+
+        abrs_integrals<T> BJai = RJai.transform(A, nA, cA);
+        //SHOWIT(BJai);
+        RJai.free();
+        BJai.transcribe(H.getABIJ()({1,0},{0,1}), false, false, NONE);
+        BJai.free();
+
+        abrs_integrals<T> bjai = Rjai.transform(A, na, ca);
+        //SHOWIT(bjai);
+        Rjai.free();
+        bjai.transcribe(abij__, false, false, NONE);
+        bjai.free();
+
+        /*
+         * Make <IJ||KL>, <AI||JK>, <aI|Jk>, <aI|bJ>, and <AI|BJ>
+         */
+        pqrs_integrals<T> rsIJ(IJrs);
+        rsIJ.collect(false);
+
+        abrs_integrals<T> RSIJ(rsIJ, true);
+        //SHOWIT(RSIJ);
+        abrs_integrals<T> RBIJ = RSIJ.transform(B, nA, cA);
+        //SHOWIT(RBIJ);
+        abrs_integrals<T> RbIJ = RSIJ.transform(B, na, ca);
+        //SHOWIT(RbIJ);
+        abrs_integrals<T> RLIJ = RSIJ.transform(B, nI, cI);
+        //SHOWIT(RLIJ);
+        abrs_integrals<T> RlIJ = RSIJ.transform(B, ni, ci);
+        //SHOWIT(RlIJ);
+        RSIJ.free();
+
+        abrs_integrals<T> ABIJ = RBIJ.transform(A, nA, cA);
+        //SHOWIT(ABIJ);
+        RBIJ.free();
+        ABIJ.transcribe(H.getAIBJ()({1,1},{1,1}), false, false, NONE);
+        ABIJ.free();
+
+        abrs_integrals<T> abIJ = RbIJ.transform(A, na, ca);
+        //SHOWIT(abIJ);
+        RbIJ.free();
+        abIJ.transcribe(H.getAIBJ()({0,1},{0,1}), false, false, NONE);
+        abIJ.free();
+
+        abrs_integrals<T> akIJ = RlIJ.transform(A, na, ca);
+        //SHOWIT(akIJ);
+        RlIJ.free();
+        akIJ.transcribe(H.getAIJK()({0,1},{0,1}), false, false, RS);
+        akIJ.free();
+
+        abrs_integrals<T> AKIJ = RLIJ.transform(A, nA, cA);
+        //SHOWIT(AKIJ);
+        abrs_integrals<T> KLIJ = RLIJ.transform(A, nI, cI);
+        //SHOWIT(KLIJ);
+        RLIJ.free();
+        AKIJ.transcribe(H.getAIJK()({1,1},{0,2}), false, true, NONE);
+        AKIJ.free();
+        KLIJ.transcribe(H.getIJKL()({0,2},{0,2}), true, true, NONE);
+        KLIJ.free();
+
+        /*
+         * Make <Ij|Kl>, <ij||kl>, <Ai|Jk>, <ai||jk>, <Ai|Bj>, and <ai|bj>
+         */
+        pqrs_integrals<T> rsij(ijrs);
+        rsij.collect(false);
+
+        abrs_integrals<T> RSij(rsij, true);
+        //SHOWIT(RSij);
+        abrs_integrals<T> RBij = RSij.transform(B, nA, cA);
+        //SHOWIT(RBij);
+        abrs_integrals<T> Rbij = RSij.transform(B, na, ca);
+        //SHOWIT(Rbij);
+        abrs_integrals<T> RLij = RSij.transform(B, nI, cI);
+        //SHOWIT(RLij);
+        abrs_integrals<T> Rlij = RSij.transform(B, ni, ci);
+        //SHOWIT(Rlij);
+        RSij.free();
+
+        abrs_integrals<T> ABij = RBij.transform(A, nA, cA);
+        //SHOWIT(ABij);
+        RBij.free();
+        ABij.transcribe(H.getAIBJ()({1,0},{1,0}), false, false, NONE);
+        ABij.free();
+
+        abrs_integrals<T> abij = Rbij.transform(A, na, ca);
+        //SHOWIT(abij);
+        Rbij.free();
+        abij.transcribe(H.getAIBJ()({0,0},{0,0}), false, false, NONE);
+        abij.free();
+
+        abrs_integrals<T> AKij = RLij.transform(A, nA, cA);
+        //SHOWIT(AKij);
+        abrs_integrals<T> KLij = RLij.transform(A, nI, cI);
+        //SHOWIT(KLij);
+        RLij.free();
+        AKij.transcribe(H.getAIJK()({1,0},{0,1}), false, false, NONE);
+        AKij.free();
+        KLij.transcribe(H.getIJKL()({0,1},{0,1}), false, false, NONE);
+        KLij.free();
+
+        abrs_integrals<T> akij = Rlij.transform(A, na, ca);
+        //SHOWIT(akij);
+        abrs_integrals<T> klij = Rlij.transform(A, ni, ci);
+        //SHOWIT(klij);
+        Rlij.free();
+        akij.transcribe(H.getAIJK()({0,0},{0,0}), false, true, NONE);
+        akij.free();
+        klij.transcribe(H.getIJKL()({0,0},{0,0}), true, true, NONE);
+        klij.free();
+    }
 
     /*
      * Make <AI||BJ> and <ai||bj>
@@ -1452,7 +1772,18 @@ bool AOMOIntegrals<T>::run(TaskDAG& dag, const Arena& arena)
 }
 }
 
+static const char* spec = R"!(
+
+collect_batches?
+    int 4,
+spin_adapt?
+    bool true,
+restricted_tolerance?
+    double 1e-10
+
+)!";
+
 INSTANTIATE_SPECIALIZATIONS(aquarius::op::pqrs_integrals);
 INSTANTIATE_SPECIALIZATIONS(aquarius::op::abrs_integrals);
 INSTANTIATE_SPECIALIZATIONS(aquarius::op::AOMOIntegrals);
-REGISTER_TASK(aquarius::op::AOMOIntegrals<double>,"aomoints");
+REGISTER_TASK(aquarius::op::AOMOIntegrals<double>,"aomoints",spec);
@@ -48,6 +48,13 @@ struct pqrs_integrals : Distributed
      */
     void collect(bool rles);
 
+    /*
+     * Redistribute integrals as in collect(), but in nchunk batches of rs
+     * pairs. Each batch is handed to process() as soon as it arrives while
+     * the next batch is still in flight. The integrals are consumed.
+     */
+    void collect(bool rles, int nchunk, const std::function<void(pqrs_integrals&)>& process);
+
     /*
      * Transform (ab|rs) -> (cb|rs) (index = A) or (ab|rs) -> (ac|rs) (index = B)
      *
@@ -88,6 +95,12 @@ struct abrs_integrals : Distributed
 
     void free();
 
+    /*
+     * Append the rs pairs of other, which must all come after those
+     * already present
+     */
+    void append(abrs_integrals&& other);
+
     size_t getNumAB(idx2_t rs);
 
     size_t getNumAB(idx2_t rs, vector<size_t>& offab);
@@ -100,6 +113,10 @@ class AOMOIntegrals : public MOIntegrals<T>
         AOMOIntegrals(const string& name, input::Config& config);
 
     protected:
+        int nchunk;
+        bool spin_adapt;
+        double restricted_tol;
+
         bool run(task::TaskDAG& dag, const Arena& arena);
 };
 
@@ -86,6 +86,18 @@ class DeexcitationOperator
             return s;
         }
 
+        void localDots(T alpha, bool conja, const vector<const op::DeexcitationOperator<T,np,nh>*>& A, bool conjb,
+                       vector<T>& vals) const
+        {
+            vector<const tensor::SpinorbitalTensor<T>*> A_(A.size());
+
+            for (int i = abs(np-nh);i <= max(np,nh);i++)
+            {
+                for (int k = 0;k < A.size();k++) A_[k] = &(*A[k])(i);
+                (*this)(i).localDots(alpha/(T)factorial(i)/(T)factorial(i-abs(np-nh)), conja, A_, conjb, vals);
+            }
+        }
+
         /*
          * Return the largest p-norm of the constituent operators
          */
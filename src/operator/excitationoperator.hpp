@@ -62,6 +62,27 @@ class ExcitationOperator
             }
         }
 
+        /*
+         * Approximate storage in bytes per process of an operator over the
+         * given spaces, assuming the symmetry-packed blocks are evenly divided
+         * among the irreps and processes
+         */
+        static int64_t estimateSize(const Arena& arena, const Space& occ, const Space& vrt)
+        {
+            int64_t nocc = sum(occ.nalpha)+sum(occ.nbeta);
+            int64_t nvrt = sum(vrt.nalpha)+sum(vrt.nbeta);
+
+            int64_t size = 0;
+            for (int ex = 0;ex <= min(np,nh);ex++)
+            {
+                int nv = ex+(np > nh ? np-nh : 0);
+                int no = ex+(nh > np ? nh-np : 0);
+                size += binom(nvrt, (int64_t)nv)*binom(nocc, (int64_t)no);
+            }
+
+            return size/occ.group.getNumIrreps()/arena.size*sizeof(T);
+        }
+
         void weight(const Denominator<T>& d, double shift = 0)
         {
             vector<const vector<vector<T>>*> da{&d.getDA(), &d.getDI()};
@@ -86,6 +107,18 @@ class ExcitationOperator
             return s;
         }
 
+        void localDots(T alpha, bool conja, const vector<const op::ExcitationOperator<T,np,nh>*>& A, bool conjb,
+                       vector<T>& vals) const
+        {
+            vector<const tensor::SpinorbitalTensor<T>*> A_(A.size());
+
+            for (int i = abs(np-nh);i <= max(np,nh);i++)
+            {
+                for (int k = 0;k < A.size();k++) A_[k] = &(*A[k])(i);
+                (*this)(i).localDots(alpha/(T)factorial(i)/(T)factorial(i-abs(np-nh)), conja, A_, conjb, vals);
+            }
+        }
+
         /*
          * Return the largest p-norm of the constituent operators
          */
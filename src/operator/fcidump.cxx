@@ -1,5 +1,9 @@
 #include "fcidump.hpp"
 
+#include <cstring>
+
+#include "task/checkpoint.hpp"
+
 using namespace aquarius::input;
 using namespace aquarius::tensor;
 using namespace aquarius::task;
@@ -7,421 +11,1155 @@ using namespace aquarius::symmetry;
 
 using namespace std::regex_constants;
 
-static constexpr int BUFFER_SIZE = 10000000;
+/*
+ * Bytes of text parsed by each process between collective writes of the
+ * integrals into the tensors
+ */
+static constexpr int64_t CHUNK_SIZE = 1<<24;
+
+static const char* BINARY_TAG = "fcidump";
 
 namespace aquarius
 {
 namespace op
 {
 
-template <typename T>
-bool writeIntegrals(vector<kv_pair>& buf, CTFTensor<T>& tensor)
+/*
+ * Allocation-free parsing of the fields of an integral line. Values whose
+ * mantissa fits in 53 bits and whose decimal exponent is at most 22 are
+ * converted exactly with a single multiplication or division; anything else
+ * falls back to strtod. Fortran-style D exponents are accepted.
+ */
+
+static inline bool isDigit(char c)
 {
-    size_t len = buf.size();
-    tensor.writeRemoteData(buf);
-    buf.clear();
-    tensor.arena.comm().Allreduce(&len, 1, MPI_MAX);
-    return len > 0;
+    return c >= '0' && c <= '9';
 }
 
-template <typename T>
-void writeIntegral(int64_t key, double val, vector<kv_pair>& buf, CTFTensor<T>& tensor)
+static inline const char* skipSpace(const char* p, const char* end)
 {
-    buf.emplace_back(key, val);
-    if (buf.size() == BUFFER_SIZE) writeIntegrals(buf, tensor);
+    while (p < end && (*p == ' ' || *p == '\t' || *p == '\r')) p++;
+    return p;
 }
 
-template <typename T>
-FCIDUMP<T>::FCIDUMP(const string& name, Config& config)
-: Task(name, config), path(config.get<string>("filename")),
-  semi(config.get<bool>("semicanonical")), full_fock(config.get<string>("1eints") == "full")
+static const char* parseInt(const char* p, const char* end, int64_t& val)
 {
-    addProduct("moints", "H");
+    p = skipSpace(p, end);
+
+    bool neg = false;
+    if (p < end && (*p == '-' || *p == '+')) neg = (*p++ == '-');
+    if (p == end || !isDigit(*p)) return NULL;
+
+    val = 0;
+    while (p < end && isDigit(*p)) val = 10*val+(*p++-'0');
+    if (neg) val = -val;
+
+    return p;
 }
 
-template <typename T>
-bool FCIDUMP<T>::run(TaskDAG& dag, const Arena& arena)
+static const char* parseDouble(const char* p, const char* end, double& val)
 {
-    ifstream ifs(path);
-    string header, line;
-    smatch m;
-    int norb, nelec, no, nv;
+    static const double pow10[] =
+        {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9, 1e10, 1e11,
+         1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+    p = skipSpace(p, end);
+    const char* token = p;
 
-    while (getline(ifs, line))
+    bool neg = false;
+    if (p < end && (*p == '-' || *p == '+')) neg = (*p++ == '-');
+
+    uint64_t mant = 0;
+    int ndigit = 0;
+    int exp = 0;
+    bool any = false;
+
+    for (;p < end && isDigit(*p);p++)
     {
-        header = header + " " + line;
-        if (regex_search(line, regex("(/|[$&]END)", icase))) break;
+        any = true;
+        if (ndigit < 19)
+        {
+            mant = 10*mant+(*p-'0');
+            if (mant > 0) ndigit++;
+        }
+        else exp++;
     }
 
-    regex_search(header, m, regex("NORB\\s*=\\s*([0-9]+)", icase));
-    istringstream(m[1]) >> norb;
+    if (p < end && *p == '.')
+    {
+        for (p++;p < end && isDigit(*p);p++)
+        {
+            any = true;
+            if (ndigit < 19)
+            {
+                mant = 10*mant+(*p-'0');
+                if (mant > 0) ndigit++;
+                exp--;
+            }
+        }
+    }
 
-    regex_search(header, m, regex("NELEC\\s*=\\s*([0-9]+)", icase));
-    istringstream(m[1]) >> nelec;
+    if (!any) return NULL;
 
-    no = nelec/2;
-    nv = norb-no;
+    if (p < end && (*p == 'e' || *p == 'E' || *p == 'd' || *p == 'D'))
+    {
+        const char* q = p+1;
+        bool eneg = false;
+        if (q < end && (*q == '-' || *q == '+')) eneg = (*q++ == '-');
 
-    this->log(arena) << "There are " << no << " occupied and " << nv << " virtual orbitals." << endl;
+        if (q < end && isDigit(*q))
+        {
+            int e = 0;
+            for (;q < end && isDigit(*q);q++)
+                if (e < 10000) e = 10*e+(*q-'0');
+            exp += (eneg ? -e : e);
+            p = q;
+        }
+    }
 
-    const PointGroup& group = PointGroup::C1();
-    Space occ(group, {no}, {no});
-    Space vrt(group, {nv}, {nv});
+    if (mant <= (uint64_t(1)<<53) && exp >= -22 && exp <= 22)
+    {
+        val = (exp < 0 ? double(mant)/pow10[-exp] : double(mant)*pow10[exp]);
+    }
+    else
+    {
+        char tmp[64];
+        if (p-token >= (ptrdiff_t)sizeof(tmp)) return NULL;
 
-    auto& H = this->put("H", new TwoElectronOperator<T>("H", arena, occ, vrt));
+        for (int i = 0;i < p-token;i++)
+            tmp[i] = (token[i] == 'd' || token[i] == 'D' ? 'e' : token[i]);
+        tmp[p-token] = 0;
 
-    double escf = 0;
-
-    matrix<double> fij(no, no);
-    matrix<double> fia(no, nv);
-    matrix<double> fai(nv, no);
-    matrix<double> fab(nv, nv);
-    vector<kv_pair> ijkl_buf; ijkl_buf.reserve(BUFFER_SIZE);
-    vector<kv_pair> aijk_buf; aijk_buf.reserve(BUFFER_SIZE);
-    vector<kv_pair> abij_buf; abij_buf.reserve(BUFFER_SIZE);
-    vector<kv_pair> aibj_buf; aibj_buf.reserve(BUFFER_SIZE);
-    vector<kv_pair> abci_buf; abci_buf.reserve(BUFFER_SIZE);
-    vector<kv_pair> abcd_buf; abcd_buf.reserve(BUFFER_SIZE);
-
-    CTFTensor<T>& fIJ = H.getIJ()({0,1},{0,1})({0,0});
-    CTFTensor<T>& fAI = H.getAI()({1,0},{0,1})({0,0});
-    CTFTensor<T>& fIA = H.getIA()({0,1},{1,0})({0,0});
-    CTFTensor<T>& fAB = H.getAB()({1,0},{1,0})({0,0});
-    CTFTensor<T>& VIJKL = H.getIJKL()({0,1},{0,1})({0,0,0,0});
-    CTFTensor<T>& VAIJK = H.getAIJK()({1,0},{0,1})({0,0,0,0});
-    CTFTensor<T>& VABIJ = H.getABIJ()({1,0},{0,1})({0,0,0,0});
-    CTFTensor<T>& VAIBJ = H.getAIBJ()({1,0},{1,0})({0,0,0,0});
-    CTFTensor<T>& VABCI = H.getABCI()({1,0},{1,0})({0,0,0,0});
-    CTFTensor<T>& VABCD = H.getABCD()({1,0},{1,0})({0,0,0,0});
-
-    //vector<int> orbmap{0, 1, 2, 5, 6, 7, 8, 11, 3, 9, 4, 10};
-
-    long lineno = 0;
-    while (getline(ifs, line))
-    {
-        if (lineno++ % arena.size != arena.rank) continue;
+        val = strtod(tmp, NULL);
+        neg = false;
+    }
 
-        double val;
-        int64_t p, q, r, s;
+    if (neg) val = -val;
 
-        istringstream(line) >> val >> p >> q >> r >> s;
-        //p = orbmap[p];
-        //q = orbmap[q];
-        //r = orbmap[r];
-        //s = orbmap[s];
+    return p;
+}
 
-        if (p == 0)
+/*
+ * Integrals read from an FCIDUMP file: the Fock matrix and SCF energy are
+ * accumulated in full on each process, while the two-electron integrals are
+ * buffered as key-value pairs for each block of H, with keys over all
+ * orbitals regardless of symmetry. When tensors are attached, the buffers are
+ * sorted into their irrep blocks and written as reading proceeds; otherwise
+ * they are kept, e.g. to be saved in binary form.
+ *
+ * Orbital irreps are numbered as in ORBSYM, counting from zero, so that the
+ * product of irreps i and j is i^j. Orbitals are numbered with the occupied
+ * ones first, and order, if not empty, gives this position for each orbital
+ * of a text file; orbsym is in the new order.
+ */
+template <typename T>
+class FCIDUMPIntegrals
+{
+    public:
+        enum {IJKL, AIJK, ABIJ, AIBJ, ABCI, ABCD, NBLOCK};
+
+        int no, nv;
+        bool full_fock;
+        int isym;
+        vector<int> orbsym;
+        vector<int> order;
+        vector<int> occ_irrep, occ_index, vrt_irrep, vrt_index;
+        double escf;
+        matrix<double> fij, fia, fai, fab;
+        vector<kv_pair> buf[NBLOCK];
+        SymmetryBlockedTensor<T>* tensor[NBLOCK];
+        vector<int> irrep_map;
+
+        FCIDUMPIntegrals(int no, int nv, bool full_fock, int isym, const vector<int>& orbsym,
+                         const vector<int>& order = {})
+        : no(no), nv(nv), full_fock(full_fock), isym(isym), orbsym(orbsym), order(order),
+          occ_irrep(no), occ_index(no), vrt_irrep(nv), vrt_index(nv), escf(0),
+          fij(no, no), fia(no, nv), fai(nv, no), fab(nv, nv)
         {
-            escf += val;
+            assert((int)orbsym.size() == no+nv);
+            assert(order.empty() || (int)order.size() == no+nv);
+
+            fill(tensor, tensor+NBLOCK, (SymmetryBlockedTensor<T>*)NULL);
+
+            vector<int> count(8, 0);
+            for (int i = 0;i < no;i++)
+            {
+                occ_irrep[i] = orbsym[i]-1;
+                occ_index[i] = count[occ_irrep[i]]++;
+            }
+
+            count.assign(8, 0);
+            for (int a = 0;a < nv;a++)
+            {
+                vrt_irrep[a] = orbsym[no+a]-1;
+                vrt_index[a] = count[vrt_irrep[a]]++;
+            }
         }
-        else if (q == 0)
+
+        /*
+         * Attach the tensors of H, given the irrep of the point group of H
+         * for each irrep of ORBSYM
+         */
+        void setTensors(TwoElectronOperator<T>& H, const vector<int>& irrep_map)
         {
-            continue;
+            this->irrep_map = irrep_map;
+            tensor[IJKL] = &H.getIJKL()({0,1},{0,1});
+            tensor[AIJK] = &H.getAIJK()({1,0},{0,1});
+            tensor[ABIJ] = &H.getABIJ()({1,0},{0,1});
+            tensor[AIBJ] = &H.getAIBJ()({1,0},{1,0});
+            tensor[ABCI] = &H.getABCI()({1,0},{1,0});
+            tensor[ABCD] = &H.getABCD()({1,0},{1,0});
         }
-        else if (r == 0)
+
+        void add(double val, int64_t p, int64_t q, int64_t r, int64_t s);
+
+        /*
+         * Map an orbital of the file (counting from one, or zero for none)
+         * to the numbering with the occupied orbitals first
+         */
+        bool renumber(int64_t& p) const
         {
-            bool p_is_vrt = --p >= no; if (p_is_vrt) p -= no;
-            bool q_is_vrt = --q >= no; if (q_is_vrt) q -= no;
+            if (p < 0 || p > no+nv) return false;
+            if (p > 0 && !order.empty()) p = order[p-1]+1;
+            return true;
+        }
+
+        /*
+         * Return false if the line is neither blank nor an integral
+         */
+        bool parseLine(const char* p, const char* end)
+        {
+            double val;
+            int64_t i, j, k, l;
+
+            if (skipSpace(p, end) == end) return true;
+
+            if (!(p = parseDouble(p, end, val))) return false;
+            if (!(p = parseInt(p, end, i))) return false;
+            if (!(p = parseInt(p, end, j))) return false;
+            if (!(p = parseInt(p, end, k))) return false;
+            if (!(p = parseInt(p, end, l))) return false;
 
-            if (p_is_vrt)
+            if (!renumber(i) || !renumber(j) || !renumber(k) || !renumber(l)) return false;
+
+            add(val, i, j, k, l);
+            return true;
+        }
+
+        /*
+         * Sort the buffered integrals into the irrep blocks of the attached
+         * tensors and write them; collective over the arena of the tensors.
+         * Elements which vanish by symmetry are dropped.
+         */
+        void flush(const Arena& arena)
+        {
+            static const bool is_vrt[NBLOCK][4] =
             {
-                if (q_is_vrt)
+                {false, false, false, false}, //IJKL
+                { true, false, false, false}, //AIJK
+                { true,  true, false, false}, //ABIJ
+                { true, false,  true, false}, //AIBJ
+                { true,  true,  true, false}, //ABCI
+                { true,  true,  true,  true}  //ABCD
+            };
+
+            if (!tensor[0]) return;
+
+            int n = irrep_map.size();
+            vector<vector<kv_pair>> blocks(n*n*n*n);
+            vector<int64_t> count(n*n*n*n);
+
+            for (int t = 0;t < NBLOCK;t++)
+            {
+                const vector<vector<int>>& len = tensor[t]->getLengths();
+
+                for (const kv_pair& pair : buf[t])
                 {
-                    fab[p][q] += val;
-                    if (p != q && !full_fock) fab[q][p] += val;
+                    int64_t key = pair.k;
+                    int irrep[4], idx[4], prod = 0;
+
+                    for (int d = 0;d < 4;d++)
+                    {
+                        int sym;
+                        if (is_vrt[t][d])
+                        {
+                            int64_t a = key%nv; key /= nv;
+                            sym = vrt_irrep[a];
+                            idx[d] = vrt_index[a];
+                        }
+                        else
+                        {
+                            int64_t i = key%no; key /= no;
+                            sym = occ_irrep[i];
+                            idx[d] = occ_index[i];
+                        }
+                        prod ^= sym;
+                        irrep[d] = irrep_map[sym];
+                    }
+
+                    if (prod != 0) continue;
+
+                    int64_t local = 0;
+                    for (int d = 3;d >= 0;d--) local = local*len[d][irrep[d]]+idx[d];
+
+                    blocks[((irrep[3]*n+irrep[2])*n+irrep[1])*n+irrep[0]].emplace_back(local, pair.d);
                 }
-                else
+
+                buf[t].clear();
+
+                for (int b = 0;b < n*n*n*n;b++) count[b] = blocks[b].size();
+                arena.comm().Allreduce(count.data(), count.size(), MPI_MAX);
+
+                for (int b = 0;b < n*n*n*n;b++)
                 {
-                    fai[p][q] += val;
-                    if (!full_fock) fia[q][p] += val;
+                    if (count[b] == 0) continue;
+                    tensor[t]->writeRemoteData({b%n, (b/n)%n, (b/n/n)%n, b/n/n/n}, blocks[b]);
+                    blocks[b].clear();
                 }
             }
+        }
+
+        void readText(const Arena& arena, const string& path, int64_t start);
+
+        /*
+         * Sum the Fock matrix onto rank 0 and the SCF energy onto all ranks
+         */
+        void reduce(const Arena& arena)
+        {
+            arena.comm().Allreduce(&escf, 1, MPI_SUM);
+
+            if (arena.rank == 0)
+            {
+                arena.comm().Reduce(fab.data(), nv*nv, MPI_SUM);
+                arena.comm().Reduce(fai.data(), nv*no, MPI_SUM);
+                arena.comm().Reduce(fia.data(), no*nv, MPI_SUM);
+                arena.comm().Reduce(fij.data(), no*no, MPI_SUM);
+            }
             else
             {
-                if (q_is_vrt)
-                {
-                    fia[p][q] += val;
-                    if (!full_fock) fai[q][p] += val;
-                }
-                else
-                {
-                    if (p == q) escf += 2*val;
-                    fij[p][q] += val;
-                    if (p != q && !full_fock) fij[q][p] += val;
-                }
+                arena.comm().Reduce(fab.data(), nv*nv, MPI_SUM, 0);
+                arena.comm().Reduce(fai.data(), nv*no, MPI_SUM, 0);
+                arena.comm().Reduce(fia.data(), no*nv, MPI_SUM, 0);
+                arena.comm().Reduce(fij.data(), no*no, MPI_SUM, 0);
+            }
+        }
+
+        static void readBinaryHeader(Checkpoint& chk, const string& path, int& no, int& nv,
+                                     int& isym, vector<int>& orbsym)
+        {
+            vector<char> tag;
+            chk.readAll(tag);
+            if (string(tag.begin(), tag.end()) != BINARY_TAG)
+                throw CheckpointError(path, "not a binary FCIDUMP file");
+
+            chk.readAll(no);
+            chk.readAll(nv);
+            chk.readAll(isym);
+            chk.readAll(orbsym);
+        }
+
+        /*
+         * Read the remainder of a binary file after readBinaryHeader; each
+         * process reads an even share of every block straight into the
+         * attached tensors
+         */
+        void readBinary(const Arena& arena, Checkpoint& chk)
+        {
+            vector<double> f;
+
+            chk.readAll(escf);
+            chk.readAll(f); copy(f.begin(), f.end(), fij.data());
+            chk.readAll(f); copy(f.begin(), f.end(), fia.data());
+            chk.readAll(f); copy(f.begin(), f.end(), fai.data());
+            chk.readAll(f); copy(f.begin(), f.end(), fab.data());
+
+            for (int i = 0;i < NBLOCK;i++) chk.readShare(buf[i]);
+            flush(arena);
+        }
+
+        /*
+         * Write the integrals after reduce
+         */
+        void writeBinary(Checkpoint& chk)
+        {
+            chk.writeAll(vector<char>(BINARY_TAG, BINARY_TAG+strlen(BINARY_TAG)));
+            chk.writeAll(no);
+            chk.writeAll(nv);
+            chk.writeAll(isym);
+            chk.writeAll(orbsym);
+            chk.writeAll(escf);
+            chk.writeAll(vector<double>(fij.data(), fij.data()+no*no));
+            chk.writeAll(vector<double>(fia.data(), fia.data()+no*nv));
+            chk.writeAll(vector<double>(fai.data(), fai.data()+nv*no));
+            chk.writeAll(vector<double>(fab.data(), fab.data()+nv*nv));
+
+            for (int i = 0;i < NBLOCK;i++) chk.write(buf[i]);
+        }
+};
+
+template <typename T>
+void FCIDUMPIntegrals<T>::add(double val, int64_t p, int64_t q, int64_t r, int64_t s)
+{
+    if (p == 0)
+    {
+        escf += val;
+    }
+    else if (q == 0)
+    {
+        return;
+    }
+    else if (r == 0)
+    {
+        bool p_is_vrt = --p >= no; if (p_is_vrt) p -= no;
+        bool q_is_vrt = --q >= no; if (q_is_vrt) q -= no;
+
+        if (p_is_vrt)
+        {
+            if (q_is_vrt)
+            {
+                fab[p][q] += val;
+                if (p != q && !full_fock) fab[q][p] += val;
+            }
+            else
+            {
+                fai[p][q] += val;
+                if (!full_fock) fia[q][p] += val;
             }
         }
         else
         {
-            /*
-             * Switch to <pq|rs> with p>=r, q>=s, pr>=qs.
-             */
-            if (p < q) swap(p, q);
-            if (r < s) swap(r, s);
-            if (p < r || (p == r && q < s))
+            if (q_is_vrt)
             {
-                continue;
-                //swap(p, r);
-                //swap(q, s);
+                fia[p][q] += val;
+                if (!full_fock) fai[q][p] += val;
             }
-            swap(q, r);
+            else
+            {
+                if (p == q) escf += 2*val;
+                fij[p][q] += val;
+                if (p != q && !full_fock) fij[q][p] += val;
+            }
+        }
+    }
+    else
+    {
+        /*
+         * Switch to <pq|rs> with p>=r, q>=s, pr>=qs.
+         */
+        if (p < q) swap(p, q);
+        if (r < s) swap(r, s);
+        if (p < r || (p == r && q < s))
+        {
+            return;
+            //swap(p, r);
+            //swap(q, s);
+        }
+        swap(q, r);
 
-            bool p_is_vrt = --p >= no; if (p_is_vrt) p -= no;
-            bool q_is_vrt = --q >= no; if (q_is_vrt) q -= no;
-            bool r_is_vrt = --r >= no; if (r_is_vrt) r -= no;
-            bool s_is_vrt = --s >= no; if (s_is_vrt) s -= no;
+        bool p_is_vrt = --p >= no; if (p_is_vrt) p -= no;
+        bool q_is_vrt = --q >= no; if (q_is_vrt) q -= no;
+        bool r_is_vrt = --r >= no; if (r_is_vrt) r -= no;
+        bool s_is_vrt = --s >= no; if (s_is_vrt) s -= no;
 
-            bool pr_eq_qs = min(p,r) == min(q,s) && max(p,r) == max(q,s);
+        bool pr_eq_qs = min(p,r) == min(q,s) && max(p,r) == max(q,s);
 
-            for (int pr = 0;pr < 2;pr++)
+        for (int pr = 0;pr < 2;pr++)
+        {
+            for (int qs = 0;qs < 2;qs++)
             {
-                for (int qs = 0;qs < 2;qs++)
+                for (int prqs = 0;prqs < 2;prqs++)
                 {
-                    for (int prqs = 0;prqs < 2;prqs++)
+                    if (r_is_vrt)
                     {
-                        if (r_is_vrt)
+                        if (s_is_vrt)
                         {
-                            if (s_is_vrt)
-                            {
-                                /*
-                                 * VVVV
-                                 */
-                                writeIntegral(((s*nv+r)*nv+q)*nv+p, val, abcd_buf, VABCD);
-                            }
-                            else if (q_is_vrt)
-                            {
-                                /*
-                                 * VVVO
-                                 */
-                                writeIntegral(((s*nv+r)*nv+q)*nv+p, val, abci_buf, VABCI);
-                            }
-                            else
-                            {
-                                /*
-                                 * VOVO
-                                 */
-                                if (q == s) fab[p][r] += 2*val;
-                                writeIntegral(((s*nv+r)*no+q)*nv+p, val, aibj_buf, VAIBJ);
-                            }
+                            /*
+                             * VVVV
+                             */
+                            buf[ABCD].emplace_back(((s*nv+r)*nv+q)*nv+p, val);
                         }
-                        else if (p_is_vrt)
+                        else if (q_is_vrt)
                         {
-                            if (s_is_vrt)
-                            {
-                                /*
-                                 * VVOV
-                                 */
-                                writeIntegral(((r*nv+s)*nv+p)*nv+q, val, abci_buf, VABCI);
-                            }
-                            else if (q_is_vrt)
-                            {
-                                /*
-                                 * VVOO
-                                 */
-                                if (r == s) fab[p][q] -= val;
-                                writeIntegral(((s*no+r)*nv+q)*nv+p, val, abij_buf, VABIJ);
-                            }
-                            else
-                            {
-                                /*
-                                 * VOOO
-                                 */
-                                if (q == s) fai[p][r] += 2*val;
-                                if (q == s) fia[r][p] += 2*val;
-                                if (q == r) fai[p][s] -= val;
-                                if (q == r) fia[s][p] -= val;
-                                writeIntegral(((s*no+r)*no+q)*nv+p, val, aijk_buf, VAIJK);
-                            }
+                            /*
+                             * VVVO
+                             */
+                            buf[ABCI].emplace_back(((s*nv+r)*nv+q)*nv+p, val);
                         }
                         else
                         {
-                            if (s_is_vrt)
-                            {
-                                /*
-                                 * OVOV
-                                 */
-                                abort();
-                            }
-                            else if (q_is_vrt)
-                            {
-                                /*
-                                 * OVOO
-                                 */
-                                abort();
-                            }
-                            else
-                            {
-                                /*
-                                 * OOOO
-                                 */
-                                if (q == s) fij[p][r] += 2*val;
-                                if (q == r) fij[p][s] -= val;
-                                if (p == r && q == s) escf += 2*val;
-                                if (p == s && q == r) escf -= val;
-                                writeIntegral(((s*no+r)*no+q)*no+p, val, ijkl_buf, VIJKL);
-                            }
+                            /*
+                             * VOVO
+                             */
+                            if (q == s) fab[p][r] += 2*val;
+                            buf[AIBJ].emplace_back(((s*nv+r)*no+q)*nv+p, val);
                         }
-
-                        if (pr_eq_qs || p_is_vrt != q_is_vrt || r_is_vrt != s_is_vrt) break;
-                        swap(p, q);
-                        swap(r, s);
                     }
-                    if (q == s || q_is_vrt != s_is_vrt) break;
-                    swap(q, s);
+                    else if (p_is_vrt)
+                    {
+                        if (s_is_vrt)
+                        {
+                            /*
+                             * VVOV
+                             */
+                            buf[ABCI].emplace_back(((r*nv+s)*nv+p)*nv+q, val);
+                        }
+                        else if (q_is_vrt)
+                        {
+                            /*
+                             * VVOO
+                             */
+                            if (r == s) fab[p][q] -= val;
+                            buf[ABIJ].emplace_back(((s*no+r)*nv+q)*nv+p, val);
+                        }
+                        else
+                        {
+                            /*
+                             * VOOO
+                             */
+                            if (q == s) fai[p][r] += 2*val;
+                            if (q == s) fia[r][p] += 2*val;
+                            if (q == r) fai[p][s] -= val;
+                            if (q == r) fia[s][p] -= val;
+                            buf[AIJK].emplace_back(((s*no+r)*no+q)*nv+p, val);
+                        }
+                    }
+                    else
+                    {
+                        if (s_is_vrt)
+                        {
+                            /*
+                             * OVOV
+                             */
+                            abort();
+                        }
+                        else if (q_is_vrt)
+                        {
+                            /*
+                             * OVOO
+                             */
+                            abort();
+                        }
+                        else
+                        {
+                            /*
+                             * OOOO
+                             */
+                            if (q == s) fij[p][r] += 2*val;
+                            if (q == r) fij[p][s] -= val;
+                            if (p == r && q == s) escf += 2*val;
+                            if (p == s && q == r) escf -= val;
+                            buf[IJKL].emplace_back(((s*no+r)*no+q)*no+p, val);
+                        }
+                    }
+
+                    if (pr_eq_qs || p_is_vrt != q_is_vrt || r_is_vrt != s_is_vrt) break;
+                    swap(p, q);
+                    swap(r, s);
                 }
-                if (p == r || p_is_vrt != r_is_vrt) break;
-                swap(p, r);
+                if (q == s || q_is_vrt != s_is_vrt) break;
+                swap(q, s);
             }
+            if (p == r || p_is_vrt != r_is_vrt) break;
+            swap(p, r);
         }
     }
+}
+
+/*
+ * Scan the integral lines of a text FCIDUMP starting at byte offset start,
+ * calling parse(p, end) on each line and, collectively, flush() after each
+ * chunk. parse returns false for a malformed line, and the first one in the
+ * file is reported on all processes.
+ */
+template <typename Parse, typename Flush>
+static void scanText(const Arena& arena, const string& path, int64_t start,
+                     Parse&& parse, Flush&& flush)
+{
+    ifstream ifs(path, ifstream::binary);
+    ifs.seekg(0, ifstream::end);
+    int64_t end = ifs.tellg();
+
+    /*
+     * Each process reads an even byte range of the integral lines, with the
+     * boundaries moved forward to the start of the next line
+     */
+    auto align = [&](int64_t pos) -> int64_t
+    {
+        if (pos <= start) return start;
+        if (pos >= end) return end;
+
+        ifs.seekg(pos-1);
+        ifs.ignore(numeric_limits<streamsize>::max(), '\n');
+        if (!ifs)
+        {
+            ifs.clear();
+            return end;
+        }
+        return ifs.tellg();
+    };
+
+    int64_t first = align(start+(end-start)*arena.rank/arena.size);
+    int64_t last = align(start+(end-start)*(arena.rank+1)/arena.size);
+
+    int64_t nchunk = (last-first+CHUNK_SIZE-1)/CHUNK_SIZE;
+    arena.comm().Allreduce(&nchunk, 1, MPI_MAX);
+
+    vector<char> chunk;
+    chunk.reserve(CHUNK_SIZE);
+    size_t leftover = 0;
+    int64_t pos = first;
+    int64_t nline = 0, bad = -1;
+    ifs.seekg(first);
 
-    while (writeIntegrals(abcd_buf, VABCD)) continue;
-    while (writeIntegrals(abci_buf, VABCI)) continue;
-    while (writeIntegrals(abij_buf, VABIJ)) continue;
-    while (writeIntegrals(aibj_buf, VAIBJ)) continue;
-    while (writeIntegrals(aijk_buf, VAIJK)) continue;
-    while (writeIntegrals(ijkl_buf, VIJKL)) continue;
+    for (int64_t i = 0;i < nchunk;i++)
+    {
+        int64_t n = min(CHUNK_SIZE, last-pos);
+        chunk.resize(leftover+n);
+        ifs.read(chunk.data()+leftover, n);
+        pos += n;
+
+        const char* p = chunk.data();
+        const char* bufend = p+chunk.size();
+        while (p < bufend)
+        {
+            const char* eol = static_cast<const char*>(memchr(p, '\n', bufend-p));
 
-    arena.comm().Allreduce(&escf, 1, MPI_SUM);
+            /*
+             * A partial line is finished by the next chunk, unless this is
+             * the last line of the file
+             */
+            if (eol == NULL && pos < last) break;
+            if (eol == NULL) eol = bufend;
+
+            if (!parse(p, eol) && bad == -1) bad = nline;
+            nline++;
+            p = (eol < bufend ? eol+1 : bufend);
+        }
+
+        leftover = bufend-p;
+        std::copy(p, bufend, chunk.data());
+        chunk.resize(leftover);
+
+        flush();
+    }
+
+    /*
+     * Report the first malformed line of the file, numbered from the lines
+     * of the header and of the byte ranges of the preceding processes
+     */
+    vector<int64_t> nlines(arena.size);
+    nlines[arena.rank] = nline;
+    arena.comm().Allreduce(nlines.data(), arena.size, MPI_SUM);
+
+    int64_t line = numeric_limits<int64_t>::max();
+    if (bad != -1)
+    {
+        ifs.clear();
+        ifs.seekg(0);
+        line = bad+1;
+        for (int64_t i = 0;i < start;i++) if (ifs.get() == '\n') line++;
+        for (int r = 0;r < arena.rank;r++) line += nlines[r];
+    }
+    arena.comm().Allreduce(&line, 1, MPI_MIN);
+
+    if (line != numeric_limits<int64_t>::max())
+        throw runtime_error(path + ": could not parse integral on line " + to_string(line));
+}
+
+template <typename T>
+void FCIDUMPIntegrals<T>::readText(const Arena& arena, const string& path, int64_t start)
+{
+    scanText(arena, path, start,
+             [this](const char* p, const char* end) { return parseLine(p, end); },
+             [this,&arena] { flush(arena); });
+}
+
+template <typename T>
+FCIDUMP<T>::FCIDUMP(const string& name, Config& config)
+: Task(name, config), path(config.get<string>("filename")),
+  binary(config.get<string>("format") == "binary"),
+  semi(config.get<bool>("semicanonical")), full_fock(config.get<string>("1eints") == "full"),
+  group_name(config.get<string>("point_group"))
+{
+    if (config.exists("occupation")) occupation = config.get<vector<int>>("occupation");
+
+    addProduct("moints", "H");
+}
+
+/*
+ * Read the namelist header of a text FCIDUMP on rank 0 and return the offset
+ * of the first integral line. ORBSYM is left empty if it is not given.
+ */
+static int64_t readHeader(const Arena& arena, const string& path, int& norb, int& nelec,
+                          int& isym, vector<int>& orbsym)
+{
+    vector<int64_t> header{-1, -1, 1, 0, 0};
 
     if (arena.rank == 0)
     {
-        arena.comm().Reduce(fab.data(), nv*nv, MPI_SUM);
-        arena.comm().Reduce(fai.data(), nv*no, MPI_SUM);
-        arena.comm().Reduce(fia.data(), no*nv, MPI_SUM);
-        arena.comm().Reduce(fij.data(), no*no, MPI_SUM);
+        ifstream ifs(path);
+        string text, line;
+        smatch m;
+
+        while (getline(ifs, line))
+        {
+            text = text + " " + line;
+            if (regex_search(line, regex("(/|[$&]END)", icase))) break;
+        }
 
-        double norm_ij = 0;
-        vector<kv_pair> ij_buf;
-        for (int i = 0;i < no;i++)
+        if (ifs)
         {
-            for (int j = 0;j < no;j++)
+            header[3] = ifs.tellg();
+
+            if (regex_search(text, m, regex("NORB\\s*=\\s*([0-9]+)", icase)))
+                istringstream(m[1]) >> header[0];
+
+            if (regex_search(text, m, regex("NELEC\\s*=\\s*([0-9]+)", icase)))
+                istringstream(m[1]) >> header[1];
+
+            if (regex_search(text, m, regex("\\bISYM\\s*=\\s*([0-9]+)", icase)))
+                istringstream(m[1]) >> header[2];
+
+            if (regex_search(text, m, regex("ORBSYM\\s*=\\s*([0-9,\\s]*)", icase)))
             {
-                if (i != j) norm_ij = max(norm_ij, fabs(fij[i][j]));
-                ij_buf.emplace_back(i+j*no, fij[i][j]);
+                string list = m[1];
+                std::replace(list.begin(), list.end(), ',', ' ');
+                istringstream iss(list);
+                for (int irrep;iss >> irrep;) orbsym.push_back(irrep);
+                header[4] = orbsym.size();
             }
         }
+    }
+
+    arena.comm().Bcast(header, 0);
+
+    if (header[0] < 0 || header[1] < 0)
+        throw runtime_error(path + ": could not read FCIDUMP header");
+
+    norb = header[0];
+    nelec = header[1];
+    isym = header[2];
+    orbsym.resize(header[4]);
+    if (!orbsym.empty()) arena.comm().Bcast(orbsym, 0);
+
+    return header[3];
+}
+
+/*
+ * Check ORBSYM against the number of orbitals, filling it with the totally
+ * symmetric irrep if it was not given
+ */
+static void checkOrbsym(const string& path, int norb, vector<int>& orbsym)
+{
+    if (orbsym.empty()) orbsym.assign(norb, 1);
+
+    if ((int)orbsym.size() != norb)
+        throw runtime_error(path + ": ORBSYM does not have NORB entries");
+
+    for (int irrep : orbsym)
+        if (irrep < 1 || irrep > 8)
+            throw runtime_error(path + ": invalid irrep in ORBSYM");
+}
 
-        double norm_ia = 0;
-        vector<kv_pair> ia_buf;
-        for (int i = 0;i < no;i++)
+/*
+ * Choose the doubly occupied orbitals of a text FCIDUMP and return the
+ * position of each orbital of the file when the occupied ones are put first,
+ * keeping the order of the file otherwise. ORBSYM is reordered to match.
+ *
+ * Files blocked by symmetry, as written by MOLPRO or PySCF, do not list the
+ * occupied orbitals first. Given the number of occupied orbitals in each
+ * ORBSYM irrep, the lowest ones of each irrep in the file are taken;
+ * otherwise, if there is more than one irrep, the orbitals are filled in
+ * order of the diagonal of the Fock matrix, made self-consistent using
+ * h(pp), (pp|qq), and (pq|qp) from an extra pass over the file.
+ */
+static vector<int> occupiedOrbitals(const Arena& arena, const string& path, int64_t start,
+                                    int norb, int no, const vector<int>& occupation,
+                                    vector<int>& orbsym)
+{
+    vector<bool> occupied(norb, false);
+
+    if (!occupation.empty())
+    {
+        if ((int)occupation.size() > 8)
+            throw runtime_error(path + ": occupation has more than 8 irreps");
+
+        int total = 0;
+        for (int n : occupation) total += n;
+        if (total != no)
+            throw runtime_error(path + ": occupation does not have NELEC/2 orbitals");
+
+        vector<int> left(occupation);
+        left.resize(8, 0);
+        for (int p = 0;p < norb;p++)
         {
-            for (int a = 0;a < nv;a++)
+            if (left[orbsym[p]-1] > 0)
             {
-                norm_ia = max(norm_ia, fabs(fia[i][a]));
-                ia_buf.emplace_back(i+a*no, fia[i][a]);
+                occupied[p] = true;
+                left[orbsym[p]-1]--;
             }
         }
 
-        double norm_ai = 0;
-        vector<kv_pair> ai_buf;
-        for (int a = 0;a < nv;a++)
+        for (int n : left)
+            if (n > 0)
+                throw runtime_error(path + ": occupation has more orbitals than ORBSYM in some irrep");
+    }
+    else if (*std::max_element(orbsym.begin(), orbsym.end()) > 1)
+    {
+        vector<double> h(norb), J(norb*norb), K(norb*norb);
+
+        scanText(arena, path, start,
+        [&](const char* p, const char* end)
         {
-            for (int i = 0;i < no;i++)
+            double val;
+            int64_t i, j, k, l;
+
+            if (skipSpace(p, end) == end) return true;
+
+            if (!(p = parseDouble(p, end, val))) return false;
+            if (!(p = parseInt(p, end, i))) return false;
+            if (!(p = parseInt(p, end, j))) return false;
+            if (!(p = parseInt(p, end, k))) return false;
+            if (!(p = parseInt(p, end, l))) return false;
+
+            if (i < 0 || i > norb || j < 0 || j > norb ||
+                k < 0 || k > norb || l < 0 || l > norb) return false;
+
+            if (i == 0 || j == 0) return true;
+            i--; j--;
+
+            if (k == 0)
             {
-                norm_ai = max(norm_ai, fabs(fai[a][i]));
-                ai_buf.emplace_back(a+i*nv, fai[a][i]);
+                if (i == j) h[i] = val;
+                return true;
             }
-        }
+            k--; l--;
 
-        double norm_ab = 0;
-        vector<kv_pair> ab_buf;
-        for (int a = 0;a < nv;a++)
+            if (i == j && k == l) J[i*norb+k] = J[k*norb+i] = val;
+            if ((i == k && j == l) || (i == l && j == k)) K[i*norb+j] = K[j*norb+i] = val;
+
+            return true;
+        },
+        []{});
+
+        arena.comm().Allreduce(h.data(), norb, MPI_SUM);
+        arena.comm().Allreduce(J.data(), norb*norb, MPI_SUM);
+        arena.comm().Allreduce(K.data(), norb*norb, MPI_SUM);
+
+        vector<double> f(h);
+        vector<int> idx(norb);
+        for (int iter = 0;;iter++)
         {
-            for (int b = 0;b < nv;b++)
+            for (int p = 0;p < norb;p++) idx[p] = p;
+            stable_sort(idx.begin(), idx.end(), [&](int p, int q) { return f[p] < f[q]; });
+
+            vector<bool> aufbau(norb, false);
+            for (int i = 0;i < no;i++) aufbau[idx[i]] = true;
+            if (aufbau == occupied) break;
+
+            if (iter == 50)
+                throw runtime_error(path + ": no consistent aufbau occupation; give the occupation explicitly");
+
+            occupied = aufbau;
+
+            for (int p = 0;p < norb;p++)
             {
-                if (a != b) norm_ab = max(norm_ab, fabs(fab[a][b]));
-                ab_buf.emplace_back(a+b*nv, fab[a][b]);
+                f[p] = h[p];
+                for (int i = 0;i < norb;i++)
+                    if (occupied[i]) f[p] += 2*J[p*norb+i]-K[p*norb+i];
             }
         }
+    }
+    else
+    {
+        for (int i = 0;i < no;i++) occupied[i] = true;
+    }
 
-        fIJ.writeRemoteData(ij_buf);
-        fAI.writeRemoteData(ai_buf);
-        fIA.writeRemoteData(ia_buf);
-        fAB.writeRemoteData(ab_buf);
+    vector<int> order(norb);
+    vector<int> new_orbsym(norb);
+    int i = 0, a = no;
+    for (int p = 0;p < norb;p++)
+    {
+        order[p] = (occupied[p] ? i++ : a++);
+        new_orbsym[order[p]] = orbsym[p];
+    }
+    orbsym = new_orbsym;
+
+    return order;
+}
 
-        log(arena) << "E(SCF): " << printToAccuracy(escf, 1e-12) << endl;
-        //log(arena) << "norm IJ: " << norm_ij << endl;
-        //log(arena) << "norm IA: " << norm_ia << endl;
-        //log(arena) << "norm AI: " << norm_ai << endl;
-        //log(arena) << "norm AB: " << norm_ab << endl;
+/*
+ * Find the abelian point group named by the input, or the smallest one which
+ * accommodates ORBSYM for "auto", along with the irrep of the group for each
+ * ORBSYM irrep. ORBSYM follows the MOLPRO ordering of the irreps, in which
+ * products are given by XOR; the orderings used here have the same property,
+ * so only a relabelling is needed.
+ */
+static const PointGroup& pointGroup(const string& path, const string& name,
+                                    vector<int>& orbsym, vector<int>& irrep_map)
+{
+    static const struct
+    {
+        const char* name;
+        const PointGroup& (*group)();
+        vector<int> map;
+    } groups[] =
+    {
+        { "C1",  &PointGroup::C1, {0}},
+        { "Cs",  &PointGroup::Cs, {0,1}},
+        { "Ci",  &PointGroup::Ci, {0,1}},
+        { "C2",  &PointGroup::C2, {0,1}},
+        {"C2v", &PointGroup::C2v, {0,2,3,1}},
+        {"C2h", &PointGroup::C2h, {0,2,3,1}},
+        { "D2",  &PointGroup::D2, {0,3,2,1}},
+        {"D2h", &PointGroup::D2h, {0,7,6,1,5,2,3,4}}
+    };
+
+    int maxsym = *std::max_element(orbsym.begin(), orbsym.end());
+
+    string group = name;
+    if (group == "auto")
+    {
+        group = (maxsym == 1 ? "C1" :
+                 maxsym == 2 ? "Cs" :
+                 maxsym <= 4 ? "C2v" : "D2h");
+    }
+
+    for (auto& g : groups)
+    {
+        if (group != g.name) continue;
+
+        if (group == "C1")
+        {
+            orbsym.assign(orbsym.size(), 1);
+        }
+        else if (maxsym > (int)g.map.size())
+        {
+            throw runtime_error(path + ": ORBSYM has more irreps than " + group);
+        }
+
+        irrep_map = g.map;
+        return g.group();
+    }
+
+    throw runtime_error("unknown point group " + group);
+}
+
+template <typename T>
+bool FCIDUMP<T>::run(TaskDAG& dag, const Arena& arena)
+{
+    int no, nv, isym;
+    vector<int> orbsym;
+    int64_t start = 0;
+    unique_ptr<Checkpoint> chk;
+
+    if (binary)
+    {
+        chk.reset(new Checkpoint(arena, path, Checkpoint::READ));
+        FCIDUMPIntegrals<T>::readBinaryHeader(*chk, path, no, nv, isym, orbsym);
     }
     else
     {
-        arena.comm().Reduce(fab.data(), nv*nv, MPI_SUM, 0);
-        arena.comm().Reduce(fai.data(), nv*no, MPI_SUM, 0);
-        arena.comm().Reduce(fia.data(), no*nv, MPI_SUM, 0);
-        arena.comm().Reduce(fij.data(), no*no, MPI_SUM, 0);
-
-        fIJ.writeRemoteData();
-        fAI.writeRemoteData();
-        fIA.writeRemoteData();
-        fAB.writeRemoteData();
+        int norb, nelec;
+        start = readHeader(arena, path, norb, nelec, isym, orbsym);
+        no = nelec/2;
+        nv = norb-no;
     }
 
-    if (semi)
+    if (isym != 1)
+        throw runtime_error(path + ": only a totally symmetric reference (ISYM=1) is supported");
+
+    checkOrbsym(path, no+nv, orbsym);
+
+    vector<int> order;
+    if (!binary) order = occupiedOrbitals(arena, path, start, no+nv, no, occupation, orbsym);
+
+    vector<int> irrep_map;
+    const PointGroup& group = pointGroup(path, group_name, orbsym, irrep_map);
+    int nirrep = group.getNumIrreps();
+
+    vector<int> nocc(nirrep, 0), nvrt(nirrep, 0);
+    for (int i = 0;i < no;i++) nocc[irrep_map[orbsym[i]-1]]++;
+    for (int a = 0;a < nv;a++) nvrt[irrep_map[orbsym[no+a]-1]]++;
+
+    this->log(arena) << "There are " << no << " occupied and " << nv << " virtual orbitals." << endl;
+    if (nirrep > 1)
     {
-        int info;
+        this->log(arena) << "Point group: " << group.getName() << endl;
+        for (int h = 0;h < nirrep;h++)
+            this->log(arena) << group.getIrrepName(h) << ": " << nocc[h] << " occupied, "
+                             << nvrt[h] << " virtual" << endl;
+    }
 
-        CTFTensor<T> CAB("C(AB)", arena, 2, {nv,nv}, {NS,NS});
-        CTFTensor<T> CIJ("C(IJ)", arena, 2, {no,no}, {NS,NS});
+    Space occ(group, nocc, nocc);
+    Space vrt(group, nvrt, nvrt);
 
-        vector<double> e_occ(no);
-        vector<double> e_vrt(nv);
+    auto& H = this->put("H", new TwoElectronOperator<T>("H", arena, occ, vrt));
+
+    FCIDUMPIntegrals<T> ints(no, nv, full_fock, isym, orbsym, order);
+    ints.setTensors(H, irrep_map);
+
+    if (binary)
+    {
+        ints.readBinary(arena, *chk);
+        chk.reset();
+    }
+    else
+    {
+        ints.readText(arena, path, start);
+        ints.reduce(arena);
+    }
+
+    double escf = ints.escf;
+    matrix<double>& fij = ints.fij;
+    matrix<double>& fia = ints.fia;
+    matrix<double>& fai = ints.fai;
+    matrix<double>& fab = ints.fab;
+
+    SymmetryBlockedTensor<T>& fIJ = H.getIJ()({0,1},{0,1});
+    SymmetryBlockedTensor<T>& fAI = H.getAI()({1,0},{0,1});
+    SymmetryBlockedTensor<T>& fIA = H.getIA()({0,1},{1,0});
+    SymmetryBlockedTensor<T>& fAB = H.getAB()({1,0},{1,0});
+    SymmetryBlockedTensor<T>& VIJKL = *ints.tensor[ints.IJKL];
+    SymmetryBlockedTensor<T>& VAIJK = *ints.tensor[ints.AIJK];
+    SymmetryBlockedTensor<T>& VABIJ = *ints.tensor[ints.ABIJ];
+    SymmetryBlockedTensor<T>& VAIBJ = *ints.tensor[ints.AIBJ];
+    SymmetryBlockedTensor<T>& VABCI = *ints.tensor[ints.ABCI];
+    SymmetryBlockedTensor<T>& VABCD = *ints.tensor[ints.ABCD];
+
+    /*
+     * Orbitals of each irrep, in the order of the file
+     */
+    vector<vector<int>> oidx(nirrep), vidx(nirrep);
+    for (int i = 0;i < no;i++) oidx[irrep_map[orbsym[i]-1]].push_back(i);
+    for (int a = 0;a < nv;a++) vidx[irrep_map[orbsym[no+a]-1]].push_back(a);
+
+    for (int h = 0;h < nirrep;h++)
+    {
+        int noh = nocc[h];
+        int nvh = nvrt[h];
 
         if (arena.rank == 0)
         {
-            info = heev('V', 'U', no, fij.data(), no, e_occ.data());
-            assert(info == 0);
+            vector<kv_pair> ij_buf;
+            for (int i = 0;i < noh;i++)
+                for (int j = 0;j < noh;j++)
+                    ij_buf.emplace_back(i+j*noh, fij[oidx[h][i]][oidx[h][j]]);
 
-            info = heev('V', 'U', nv, fab.data(), nv, e_vrt.data());
-            assert(info == 0);
+            vector<kv_pair> ia_buf;
+            for (int i = 0;i < noh;i++)
+                for (int a = 0;a < nvh;a++)
+                    ia_buf.emplace_back(i+a*noh, fia[oidx[h][i]][vidx[h][a]]);
 
-            vector<kv_pair> ij_buf;
-            for (int i = 0;i < no;i++)
-                for (int j = 0;j < no;j++)
-                    ij_buf.emplace_back(i+j*no, fij[j][i]);
+            vector<kv_pair> ai_buf;
+            for (int a = 0;a < nvh;a++)
+                for (int i = 0;i < noh;i++)
+                    ai_buf.emplace_back(a+i*nvh, fai[vidx[h][a]][oidx[h][i]]);
 
             vector<kv_pair> ab_buf;
-            for (int a = 0;a < nv;a++)
-                for (int b = 0;b < nv;b++)
-                    ab_buf.emplace_back(a+b*nv, fab[b][a]);
-
-            CAB.writeRemoteData(ab_buf);
-            CIJ.writeRemoteData(ij_buf);
+            for (int a = 0;a < nvh;a++)
+                for (int b = 0;b < nvh;b++)
+                    ab_buf.emplace_back(a+b*nvh, fab[vidx[h][a]][vidx[h][b]]);
+
+            fIJ.writeRemoteData({h,h}, ij_buf);
+            fAI.writeRemoteData({h,h}, ai_buf);
+            fIA.writeRemoteData({h,h}, ia_buf);
+            fAB.writeRemoteData({h,h}, ab_buf);
         }
         else
         {
-            CAB.writeRemoteData();
-            CIJ.writeRemoteData();
+            fIJ.writeRemoteData({h,h});
+            fAI.writeRemoteData({h,h});
+            fIA.writeRemoteData({h,h});
+            fAB.writeRemoteData({h,h});
+        }
+    }
+
+    log(arena) << "E(SCF): " << printToAccuracy(escf, 1e-12) << endl;
+
+    if (semi)
+    {
+        int info;
+
+        SymmetryBlockedTensor<T> CAB("C(AB)", arena, group, 2, {nvrt,nvrt}, {NS,NS});
+        SymmetryBlockedTensor<T> CIJ("C(IJ)", arena, group, 2, {nocc,nocc}, {NS,NS});
+
+        /*
+         * Diagonalize the occupied and virtual blocks of each irrep
+         */
+        for (int h = 0;h < nirrep;h++)
+        {
+            int noh = nocc[h];
+            int nvh = nvrt[h];
+
+            if (arena.rank == 0)
+            {
+                vector<double> f_occ(noh*noh), e_occ(noh);
+                for (int i = 0;i < noh;i++)
+                    for (int j = 0;j < noh;j++)
+                        f_occ[i+j*noh] = fij[oidx[h][j]][oidx[h][i]];
+
+                vector<double> f_vrt(nvh*nvh), e_vrt(nvh);
+                for (int a = 0;a < nvh;a++)
+                    for (int b = 0;b < nvh;b++)
+                        f_vrt[a+b*nvh] = fab[vidx[h][b]][vidx[h][a]];
+
+                if (noh > 0)
+                {
+                    info = heev('V', 'U', noh, f_occ.data(), noh, e_occ.data());
+                    assert(info == 0);
+                }
+
+                if (nvh > 0)
+                {
+                    info = heev('V', 'U', nvh, f_vrt.data(), nvh, e_vrt.data());
+                    assert(info == 0);
+                }
+
+                vector<kv_pair> ij_buf;
+                for (int i = 0;i < noh*noh;i++)
+                    ij_buf.emplace_back(i, f_occ[i]);
+
+                vector<kv_pair> ab_buf;
+                for (int a = 0;a < nvh*nvh;a++)
+                    ab_buf.emplace_back(a, f_vrt[a]);
+
+                CAB.writeRemoteData({h,h}, ab_buf);
+                CIJ.writeRemoteData({h,h}, ij_buf);
+            }
+            else
+            {
+                CAB.writeRemoteData({h,h});
+                CIJ.writeRemoteData({h,h});
+            }
         }
 
         {
-            CTFTensor<T> tmp("tmp", arena, 2, {nv,nv}, {NS,NS});
+            SymmetryBlockedTensor<T> tmp("tmp", arena, group, 2, {nvrt,nvrt}, {NS,NS});
             tmp["AQ"] = fAB["PQ"]*CAB["PA"];
             fAB["AB"] = tmp["AQ"]*CAB["QB"];
         }
 
         {
-            CTFTensor<T> tmp("tmp", arena, 2, {nv,no}, {NS,NS});
+            SymmetryBlockedTensor<T> tmp("tmp", arena, group, 2, {nvrt,nocc}, {NS,NS});
             tmp["AQ"] = fAI["PQ"]*CAB["PA"];
             fAI["AI"] = tmp["AQ"]*CIJ["QI"];
         }
 
         {
-            CTFTensor<T> tmp("tmp", arena, 2, {no,nv}, {NS,NS});
+            SymmetryBlockedTensor<T> tmp("tmp", arena, group, 2, {nocc,nvrt}, {NS,NS});
             tmp["IQ"] = fIA["PQ"]*CIJ["PI"];
             fIA["IA"] = tmp["IQ"]*CAB["QA"];
         }
 
         {
-            CTFTensor<T> tmp("tmp", arena, 2, {no,no}, {NS,NS});
+            SymmetryBlockedTensor<T> tmp("tmp", arena, group, 2, {nocc,nocc}, {NS,NS});
             tmp["IQ"] = fIJ["PQ"]*CIJ["PI"];
             fIJ["IJ"] = tmp["IQ"]*CIJ["QJ"];
         }
 
         {
-            CTFTensor<T> tmp("tmp", arena, 4, {nv,nv,nv,nv}, {NS,NS,NS,NS});
+            SymmetryBlockedTensor<T> tmp("tmp", arena, group, 4, {nvrt,nvrt,nvrt,nvrt}, {NS,NS,NS,NS});
               tmp["AQRS"] = VABCD["PQRS"]*CAB["PA"];
             VABCD["ABRS"] =   tmp["AQRS"]*CAB["QB"];
               tmp["ABCS"] = VABCD["ABRS"]*CAB["RC"];
@@ -429,7 +1167,7 @@ bool FCIDUMP<T>::run(TaskDAG& dag, const Arena& arena)
         }
 
         {
-            CTFTensor<T> tmp("tmp", arena, 4, {nv,nv,nv,no}, {NS,NS,NS,NS});
+            SymmetryBlockedTensor<T> tmp("tmp", arena, group, 4, {nvrt,nvrt,nvrt,nocc}, {NS,NS,NS,NS});
               tmp["AQRS"] = VABCI["PQRS"]*CAB["PA"];
             VABCI["ABRS"] =   tmp["AQRS"]*CAB["QB"];
               tmp["ABCS"] = VABCI["ABRS"]*CAB["RC"];
@@ -437,7 +1175,7 @@ bool FCIDUMP<T>::run(TaskDAG& dag, const Arena& arena)
         }
 
         {
-            CTFTensor<T> tmp("tmp", arena, 4, {nv,nv,no,no}, {NS,NS,NS,NS});
+            SymmetryBlockedTensor<T> tmp("tmp", arena, group, 4, {nvrt,nvrt,nocc,nocc}, {NS,NS,NS,NS});
               tmp["AQRS"] = VABIJ["PQRS"]*CAB["PA"];
             VABIJ["ABRS"] =   tmp["AQRS"]*CAB["QB"];
               tmp["ABIS"] = VABIJ["ABRS"]*CIJ["RI"];
@@ -445,7 +1183,7 @@ bool FCIDUMP<T>::run(TaskDAG& dag, const Arena& arena)
         }
 
         {
-            CTFTensor<T> tmp("tmp", arena, 4, {nv,no,nv,no}, {NS,NS,NS,NS});
+            SymmetryBlockedTensor<T> tmp("tmp", arena, group, 4, {nvrt,nocc,nvrt,nocc}, {NS,NS,NS,NS});
               tmp["AQRS"] = VAIBJ["PQRS"]*CAB["PA"];
             VAIBJ["AIRS"] =   tmp["AQRS"]*CIJ["QI"];
               tmp["AIBS"] = VAIBJ["AIRS"]*CAB["RB"];
@@ -453,7 +1191,7 @@ bool FCIDUMP<T>::run(TaskDAG& dag, const Arena& arena)
         }
 
         {
-            CTFTensor<T> tmp("tmp", arena, 4, {nv,no,no,no}, {NS,NS,NS,NS});
+            SymmetryBlockedTensor<T> tmp("tmp", arena, group, 4, {nvrt,nocc,nocc,nocc}, {NS,NS,NS,NS});
               tmp["AQRS"] = VAIJK["PQRS"]*CAB["PA"];
             VAIJK["AIRS"] =   tmp["AQRS"]*CIJ["QI"];
               tmp["AIJS"] = VAIJK["AIRS"]*CIJ["RJ"];
@@ -461,7 +1199,7 @@ bool FCIDUMP<T>::run(TaskDAG& dag, const Arena& arena)
         }
 
         {
-            CTFTensor<T> tmp("tmp", arena, 4, {no,no,no,no}, {NS,NS,NS,NS});
+            SymmetryBlockedTensor<T> tmp("tmp", arena, group, 4, {nocc,nocc,nocc,nocc}, {NS,NS,NS,NS});
               tmp["IQRS"] = VIJKL["PQRS"]*CIJ["PI"];
             VIJKL["IJRS"] =   tmp["IQRS"]*CIJ["QJ"];
               tmp["IJKS"] = VIJKL["IJRS"]*CIJ["RK"];
@@ -516,6 +1254,36 @@ bool FCIDUMP<T>::run(TaskDAG& dag, const Arena& arena)
     return true;
 }
 
+ConvertFCIDUMP::ConvertFCIDUMP(const string& name, Config& config)
+: Task(name, config), path(config.get<string>("filename")),
+  binary_path(config.get<string>("binary_filename")),
+  full_fock(config.get<string>("1eints") == "full")
+{
+    if (config.exists("occupation")) occupation = config.get<vector<int>>("occupation");
+}
+
+bool ConvertFCIDUMP::run(TaskDAG& dag, const Arena& arena)
+{
+    int norb, nelec, isym;
+    vector<int> orbsym;
+    int64_t start = readHeader(arena, path, norb, nelec, isym, orbsym);
+    checkOrbsym(path, norb, orbsym);
+
+    int no = nelec/2;
+    vector<int> order = occupiedOrbitals(arena, path, start, norb, no, occupation, orbsym);
+
+    FCIDUMPIntegrals<double> ints(no, norb-no, full_fock, isym, orbsym, order);
+    ints.readText(arena, path, start);
+    ints.reduce(arena);
+
+    Checkpoint chk(arena, binary_path, Checkpoint::WRITE);
+    ints.writeBinary(chk);
+
+    log(arena) << "Wrote binary FCIDUMP " << binary_path << endl;
+
+    return true;
+}
+
 }
 }
 
@@ -523,12 +1291,34 @@ static const char* spec = R"!(
 
 filename?
     string FCIDUMP,
+format?
+    enum { text, binary },
 semicanonical?
     bool false,
 1eints?
-    enum { symmetric, full }
+    enum { symmetric, full },
+point_group?
+    enum { auto, C1, Cs, Ci, C2, C2v, C2h, D2, D2h },
+# number of occupied orbitals in each ORBSYM irrep of a text file, e.g. [3,1,1,0]
+occupation?
+    string
+
+)!";
+
+static const char* convert_spec = R"!(
+
+filename?
+    string FCIDUMP,
+binary_filename
+    string,
+1eints?
+    enum { symmetric, full },
+# number of occupied orbitals in each ORBSYM irrep, e.g. [3,1,1,0]
+occupation?
+    string
 
 )!";
 
 INSTANTIATE_SPECIALIZATIONS(aquarius::op::FCIDUMP);
 REGISTER_TASK(aquarius::op::FCIDUMP<double>,"fcidump",spec);
+REGISTER_TASK(aquarius::op::ConvertFCIDUMP,"fcidump_convert",convert_spec);
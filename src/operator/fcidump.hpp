@@ -18,8 +18,11 @@ class FCIDUMP : public task::Task
 {
     protected:
         string path;
+        bool binary;
         bool semi;
         bool full_fock;
+        string group_name;
+        vector<int> occupation;
 
     public:
         FCIDUMP(const string& name, input::Config& config);
@@ -28,6 +31,28 @@ class FCIDUMP : public task::Task
         bool run(task::TaskDAG& dag, const Arena& arena);
 };
 
+/*
+ * Convert a text FCIDUMP file to the binary format, which holds the Fock
+ * matrix and the integrals already sorted into the blocks of H, so that it
+ * can be read back with collective MPI-IO and no parsing. ORBSYM and ISYM
+ * are kept, and the symmetry blocking is done when the file is read. The
+ * occupied orbitals are chosen here and stored first.
+ */
+class ConvertFCIDUMP : public task::Task
+{
+    protected:
+        string path;
+        string binary_path;
+        bool full_fock;
+        vector<int> occupation;
+
+    public:
+        ConvertFCIDUMP(const string& name, input::Config& config);
+
+    protected:
+        bool run(task::TaskDAG& dag, const Arena& arena);
+};
+
 }
 }
 
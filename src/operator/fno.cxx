@@ -0,0 +1,315 @@
+#include "fno.hpp"
+
+using namespace aquarius::tensor;
+using namespace aquarius::input;
+using namespace aquarius::task;
+using namespace aquarius::symmetry;
+
+namespace aquarius
+{
+namespace op
+{
+
+template <typename T>
+FNO<T>::FNO(const string& name, Config& config)
+: Task(name, config),
+  by_fraction(config.get<string>("truncation") == "fraction"),
+  threshold(config.get<double>("threshold")),
+  fraction(config.get<double>("fraction"))
+{
+    vector<Requirement> reqs;
+    reqs.emplace_back("moints", "Hfull");
+    addProduct("moints", "H", reqs);
+    addProduct("double", "mp2", reqs);
+    addProduct("double", "mp2_correction", reqs);
+}
+
+/*
+ * MP2 energy of H, leaving the first-order amplitudes in T
+ */
+template <typename T>
+static double mp2Energy(const TwoElectronOperator<T>& H, ExcitationOperator<T,2>& T1)
+{
+    Denominator<T> D(H);
+
+    T1(0) = (T)0.0;
+    T1(1) = H.getAI();
+    T1(2) = H.getABIJ();
+
+    T1.weight(D);
+
+    SpinorbitalTensor<T> Tau("Tau", H.getABIJ());
+    Tau["abij"]  = T1(2)["abij"];
+    Tau["abij"] += 0.5*T1(1)["ai"]*T1(1)["bj"];
+
+    return real(scalar(H.getAI()*T1(1))) + 0.25*real(scalar(H.getABIJ()*Tau));
+}
+
+/*
+ * B = A with index i transformed by C[i] (full x truncated), or copied if
+ * C[i] is NULL
+ */
+template <typename T>
+static void transformBlock(const SymmetryBlockedTensor<T>& A, SymmetryBlockedTensor<T>& B,
+                           const vector<const SymmetryBlockedTensor<T>*>& C)
+{
+    int ndim = C.size();
+    string idx = string("abcd").substr(0, ndim);
+    vector<vector<int>> len = A.getLengths();
+
+    unique_ptr<SymmetryBlockedTensor<T>> tmp;
+    const SymmetryBlockedTensor<T>* src = &A;
+
+    for (int i = 0;i < ndim;i++)
+    {
+        if (!C[i]) continue;
+
+        string next = idx;
+        next[i] = 'A'+i;
+        len[i] = C[i]->getLengths()[1];
+
+        auto dst = new SymmetryBlockedTensor<T>("tmp", A.arena, A.getGroup(), ndim, len,
+                                                vector<int>(ndim, NS));
+        (*dst)[next] = (*src)[idx]*(*C[i])[string{idx[i], next[i]}];
+
+        tmp.reset(dst);
+        src = tmp.get();
+        idx = next;
+    }
+
+    if (src == &A)
+    {
+        B[idx] = A[idx];
+        return;
+    }
+
+    /*
+     * Writing into the antisymmetric indices of B antisymmetrizes the
+     * already antisymmetric result again, so divide by the number of terms
+     */
+    double factor = 1;
+    const vector<int>& sym = B.getSymmetry();
+    for (int i = 0, nas = 1;i < ndim;i++)
+    {
+        if (sym[i] == AS) factor /= ++nas;
+        else nas = 1;
+    }
+
+    B[idx] = factor*(*src)[idx];
+}
+
+/*
+ * Transform every spin case of A from the full to the truncated virtual
+ * space, where CA and Ca are the alpha and beta transformations
+ */
+template <typename T>
+static void transform(const SpinorbitalTensor<T>& A, SpinorbitalTensor<T>& B,
+                      const SymmetryBlockedTensor<T>& CA, const SymmetryBlockedTensor<T>& Ca)
+{
+    const vector<int>& nout = A.getNumOut();
+    const vector<int>& nin = A.getNumIn();
+
+    for (int vout = 0;vout <= nout[0];vout++)
+    {
+        for (int oout = 0;oout <= nout[1];oout++)
+        {
+            for (int vin = 0;vin <= nin[0];vin++)
+            {
+                for (int oin = 0;oin <= nin[1];oin++)
+                {
+                    if (vout+oout != vin+oin) continue;
+
+                    vector<const SymmetryBlockedTensor<T>*> C;
+                    for (int i = 0;i < nout[0];i++) C.push_back(i < vout ? &CA : &Ca);
+                    for (int i = 0;i < nout[1];i++) C.push_back(NULL);
+                    for (int i = 0;i < nin[0];i++) C.push_back(i < vin ? &CA : &Ca);
+                    for (int i = 0;i < nin[1];i++) C.push_back(NULL);
+
+                    transformBlock(A({vout,oout},{vin,oin}), B({vout,oout},{vin,oin}), C);
+                }
+            }
+        }
+    }
+}
+
+template <typename T>
+bool FNO<T>::run(TaskDAG& dag, const Arena& arena)
+{
+    const auto& H = this->template get<TwoElectronOperator<T>>("Hfull");
+
+    const Space& occ = H.occ;
+    const Space& vrt = H.vrt;
+    const PointGroup& group = occ.group;
+    int nirrep = group.getNumIrreps();
+
+    /*
+     * MP2 virtual-virtual density, D(ab) = 1/2 t(ac,ij) t(bc,ij)
+     */
+    SpinorbitalTensor<T> DAB("D(ab)", arena, group, {vrt,occ}, {1,0}, {1,0});
+
+    double mp2;
+    {
+        ExcitationOperator<T,2> T1("T", arena, occ, vrt);
+        mp2 = mp2Energy(H, T1);
+        DAB["ab"] = 0.5*T1(2)["acij"]*T1(2)["bcij"];
+    }
+
+    this->log(arena) << "MP2 energy = " << setprecision(15) << mp2 << endl;
+
+    /*
+     * Find the natural orbitals of each spin and irrep, keep those with the
+     * largest occupations, and semicanonicalize them in the kept space
+     */
+    vector<int> nkeep[2];
+    vector<vector<T>> C[2];
+
+    for (int spin = 0;spin < 2;spin++)
+    {
+        const vector<int>& nv = (spin == 0 ? vrt.nalpha : vrt.nbeta);
+        const SymmetryBlockedTensor<T>& D = (spin == 0 ? DAB({1,0},{1,0}) : DAB({0,0},{0,0}));
+        const SymmetryBlockedTensor<T>& F = (spin == 0 ? H.getAB()({1,0},{1,0})
+                                                       : H.getAB()({0,0},{0,0}));
+
+        vector<vector<T>> d(nirrep), f(nirrep);
+        for (int h = 0;h < nirrep;h++)
+        {
+            D.getAllData({h,h}, d[h]);
+            F.getAllData({h,h}, f[h]);
+        }
+
+        nkeep[spin].assign(nirrep, 0);
+        C[spin].resize(nirrep);
+
+        if (arena.rank == 0)
+        {
+            vector<vector<double>> n(nirrep);
+            vector<pair<double,int>> all;
+            double total = 0;
+
+            for (int h = 0;h < nirrep;h++)
+            {
+                n[h].resize(nv[h]);
+                if (nv[h] == 0) continue;
+
+                int info = heev('V', 'U', nv[h], d[h].data(), nv[h], n[h].data());
+                assert(info == 0);
+
+                for (int a = 0;a < nv[h];a++)
+                {
+                    all.emplace_back(n[h][a], h);
+                    total += n[h][a];
+                }
+            }
+
+            /*
+             * The occupations come out in ascending order, so the kept
+             * orbitals are the last nkeep of each irrep
+             */
+            std::sort(all.begin(), all.end(), std::greater<pair<double,int>>());
+
+            double kept = 0;
+            for (auto& no : all)
+            {
+                if (by_fraction ? kept >= fraction*total : no.first < threshold) break;
+                kept += no.first;
+                nkeep[spin][no.second]++;
+            }
+
+            for (int h = 0;h < nirrep;h++)
+            {
+                int m = nv[h];
+                int k = nkeep[spin][h];
+                if (k == 0) continue;
+
+                const T* V = d[h].data()+(m-k)*m;
+
+                vector<T> FV(m*k), Fk(k*k);
+                vector<double> e(k);
+                gemm('N', 'N', m, k, m, 1.0, f[h].data(), m, V, m, 0.0, FV.data(), m);
+                gemm('T', 'N', k, k, m, 1.0, V, m, FV.data(), m, 0.0, Fk.data(), k);
+
+                int info = heev('V', 'U', k, Fk.data(), k, e.data());
+                assert(info == 0);
+
+                C[spin][h].resize(m*k);
+                gemm('N', 'N', m, k, k, 1.0, V, m, Fk.data(), k, 0.0, C[spin][h].data(), m);
+            }
+
+            this->log(arena) << "Keeping " << sum(nkeep[spin]) << " of " << sum(nv) << " "
+                             << (spin == 0 ? "alpha" : "beta") << " virtual orbitals ("
+                             << setprecision(4) << 100*kept/total << "% of the NO occupation)" << endl;
+        }
+
+        arena.comm().Bcast(nkeep[spin], 0);
+    }
+
+    SymmetryBlockedTensor<T> CA("C(A)", arena, group, 2, {vrt.nalpha, nkeep[0]}, {NS,NS});
+    SymmetryBlockedTensor<T> Ca("C(a)", arena, group, 2, {vrt.nbeta, nkeep[1]}, {NS,NS});
+
+    for (int h = 0;h < nirrep;h++)
+    {
+        if (arena.rank == 0)
+        {
+            vector<kv_pair> A_buf, a_buf;
+            for (size_t i = 0;i < C[0][h].size();i++) A_buf.emplace_back(i, C[0][h][i]);
+            for (size_t i = 0;i < C[1][h].size();i++) a_buf.emplace_back(i, C[1][h][i]);
+            CA.writeRemoteData({h,h}, A_buf);
+            Ca.writeRemoteData({h,h}, a_buf);
+        }
+        else
+        {
+            CA.writeRemoteData({h,h});
+            Ca.writeRemoteData({h,h});
+        }
+    }
+
+    Space fno(group, nkeep[0], nkeep[1]);
+
+    auto& Hfno = this->put("H", new TwoElectronOperator<T>("H", arena, occ, fno));
+
+    transform(H.getAB(), Hfno.getAB(), CA, Ca);
+    transform(H.getAI(), Hfno.getAI(), CA, Ca);
+    transform(H.getIA(), Hfno.getIA(), CA, Ca);
+    transform(H.getIJ(), Hfno.getIJ(), CA, Ca);
+
+    transform(H.getIJKL(), Hfno.getIJKL(), CA, Ca);
+    transform(H.getAIJK(), Hfno.getAIJK(), CA, Ca);
+    transform(H.getIJAK(), Hfno.getIJAK(), CA, Ca);
+    transform(H.getABIJ(), Hfno.getABIJ(), CA, Ca);
+    transform(H.getIJAB(), Hfno.getIJAB(), CA, Ca);
+    transform(H.getAIBJ(), Hfno.getAIBJ(), CA, Ca);
+    transform(H.getAIBC(), Hfno.getAIBC(), CA, Ca);
+    transform(H.getABCI(), Hfno.getABCI(), CA, Ca);
+    transform(H.getABCD(), Hfno.getABCD(), CA, Ca);
+
+    double mp2_fno;
+    {
+        ExcitationOperator<T,2> T1("T", arena, occ, fno);
+        mp2_fno = mp2Energy(Hfno, T1);
+    }
+
+    this->log(arena) << "MP2 energy (FNO) = " << setprecision(15) << mp2_fno << endl;
+    this->log(arena) << "MP2 correction   = " << setprecision(15) << mp2-mp2_fno << endl;
+
+    this->put("mp2", new T(mp2));
+    this->put("mp2_correction", new T(mp2-mp2_fno));
+
+    return true;
+}
+
+}
+}
+
+static const char* spec = R"!(
+
+truncation?
+    enum { threshold, fraction },
+threshold?
+    double 1e-5,
+fraction?
+    double 0.99
+
+)!";
+
+INSTANTIATE_SPECIALIZATIONS(aquarius::op::FNO);
+REGISTER_TASK(aquarius::op::FNO<double>,"fno",spec);
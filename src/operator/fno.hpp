@@ -0,0 +1,45 @@
+#ifndef _AQUARIUS_OPERATOR_FNO_HPP_
+#define _AQUARIUS_OPERATOR_FNO_HPP_
+
+#include "util/global.hpp"
+
+#include "task/task.hpp"
+
+#include "2eoperator.hpp"
+#include "excitationoperator.hpp"
+#include "denominator.hpp"
+
+namespace aquarius
+{
+namespace op
+{
+
+/*
+ * Frozen natural orbitals: the virtual space of H is truncated to the
+ * natural orbitals of the MP2 virtual-virtual density with the largest
+ * occupations, which are then semicanonicalized, giving a smaller H for the
+ * correlated calculation. The MP2 energy lost in the truncation is given as
+ * mp2_correction, to be added to the correlation energy in the reduced space.
+ *
+ * Since other tasks find the full H first, they must be pointed at the
+ * truncated one explicitly, e.g. ccsd { using H from fno }.
+ */
+template <typename T>
+class FNO : public task::Task
+{
+    protected:
+        bool by_fraction;
+        double threshold;
+        double fraction;
+
+    public:
+        FNO(const string& name, input::Config& config);
+
+    protected:
+        bool run(task::TaskDAG& dag, const Arena& arena);
+};
+
+}
+}
+
+#endif
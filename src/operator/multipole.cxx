@@ -1,9 +1,13 @@
 #include "multipole.hpp"
 
+#include "integrals/moments.hpp"
+#include "integrals/nai.hpp"
+
 using namespace aquarius::tensor;
 using namespace aquarius::integrals;
-using namespace aquarius::scf;
 using namespace aquarius::input;
+using namespace aquarius::task;
+using namespace aquarius::symmetry;
 
 namespace aquarius
 {
@@ -11,63 +15,304 @@ namespace op
 {
 
 template <typename T>
-Multipole<T>::Multipole(const string& name, const UHF<T>& uhf, int Lmin_, int Lmax_)
-: MOOperator<T>(uhf), CompositeTensor<Multipole<T>,
-  OneElectronOperator<T>,T>(name, Lmax_ == -1 ? (Lmin_+1)*(Lmin_+2)/2 :
-          (Lmax_+1)*(Lmax_+2)*(Lmax_+3)/6-Lmin_*(Lmin_+1)*(Lmin_+2)/6),
+Multipole<T>::Multipole(const string& name, const MOSpace<T>& occ, const MOSpace<T>& vrt,
+                        const vector<SymmetryBlockedTensor<T>*>& ao, int Lmin_, int Lmax_)
+: MOOperator(occ.arena, occ, vrt), CompositeTensor<Multipole<T>,OneElectronOperator<T>,T>(name),
   Lmin(Lmin_), Lmax(Lmax_ == -1 ? Lmin_ : Lmax_)
 {
-    Context context;
-    const Molecule& m = uhf.getMolecule();
-    vector<int> N = m.getNumOrbitals();
+    assert(ao.size() == OSMoments::getNumMoments(Lmax)-OSMoments::getNumMoments(Lmin-1));
+
+    for (auto a : ao) addTensor(new OneElectronOperator<T>(name, occ, vrt, *a, *a));
+}
+
+template <typename T>
+const OneElectronOperator<T>& Multipole<T>::operator()(int L, int xyz) const
+{
+    assert(L >= Lmin && L <= Lmax);
+    assert(xyz >= 0 && xyz < (L+1)*(L+2)/2);
+    return (*this)(L*(L+1)*(L+2)/6-Lmin*(Lmin+1)*(Lmin+2)/6+xyz);
+}
+
+template <typename T>
+const OneElectronOperator<T>& Multipole<T>::operator()(int x, int y, int z) const
+{
+    return (*this)(x+y+z, XYZ(x,y,z));
+}
+
+template <typename T>
+PropertyIntegrals<T>::PropertyIntegrals(const string& name, Config& config)
+: Task(name, config), lmin(config.get<int>("lmin")), lmax(config.get<int>("lmax")),
+  kinetic(config.get<bool>("kinetic")), nuclear(config.get<bool>("nuclear"))
+{
+    if (lmin < 0 || lmax < lmin)
+        throw runtime_error("Invalid range of multipole orders");
+
+    vector<Requirement> reqs;
+    reqs.emplace_back("molecule", "molecule");
+    reqs.emplace_back("occspace", "occ");
+    reqs.emplace_back("vrtspace", "vrt");
+    addProduct("multipole", "multipole", reqs);
+    if (kinetic) addProduct("mokei", "T", reqs);
+    if (nuclear) addProduct("monai", "G", reqs);
+}
+
+template <typename T>
+bool PropertyIntegrals<T>::run(TaskDAG& dag, const Arena& arena)
+{
+    const auto& molecule = get<Molecule>("molecule");
+    const auto& occ = get<MOSpace<T>>("occ");
+    const auto& vrt = get<MOSpace<T>>("vrt");
+
+    const PointGroup& group = molecule.getGroup();
 
-    SymmetryBlockedTensor<T> ao(uhf.arena, m.getGroup(), 2, {N,N}, {NS,NS}, false);
+    if (group.getOrder() != 1)
+        throw runtime_error("Property integrals require C1 symmetry (use subgroup = C1)");
 
-    int xyztot = 0;
-    for (int L = Lmin;L <= Lmax;L++)
+    Context ctx(Context::ISCF);
+
+    const vector<int>& N = molecule.getNumOrbitals();
+
+    vector<vector<int>> idx = Shell::setupIndices(ctx, molecule);
+    vector<Shell> shells(molecule.getShellsBegin(), molecule.getShellsEnd());
+
+    /*
+     * Moments are about the center of nuclear charge
+     */
+    vector<Center> centers;
+    vec3 origin(0, 0, 0);
+    double charge = 0;
+    for (auto& atom : molecule.getAtoms())
     {
-        vector<vector<tkv_pair<T>>> pairs;
+        const Center& c = atom.getCenter();
+        centers.push_back(c);
+        origin += c.getCenter(0)*c.getElement().getCharge();
+        charge += c.getElement().getCharge();
+    }
+    origin /= charge;
 
-        int ij = 0;
-        for (Molecule::const_shell_iterator i = m.getShellsBegin();i != m.getShellsEnd();++i)
+    /*
+     * Components lmin through lmax of the moments, then T and G
+     */
+    int first = OSMoments::getNumMoments(lmin-1);
+    int nmom = OSMoments::getNumMoments(lmax)-first;
+    int ncomp = nmom+(kinetic ? 1 : 0)+(nuclear ? 1 : 0);
+
+    vector<vector<tkv_pair<T>>> pairs(ncomp);
+
+    int block = 0;
+    for (int a = 0;a < shells.size();++a)
+    {
+        for (int b = 0;b <= a;++b)
         {
-            for (Molecule::const_shell_iterator j = i;j != m.getShellsEnd();++j)
+            if (block++%arena.size != arena.rank) continue;
+
+            OSMoments s(shells[a], shells[b], origin, lmax, kinetic);
+            s.run();
+
+            unique_ptr<IshidaNAI> g;
+            if (nuclear)
             {
-                if (i < j) continue;
+                g.reset(new IshidaNAI(shells[a], shells[b], centers));
+                g->run();
+            }
 
-                if (ij%this->arena.nproc == this->arena.rank)
+            vector<const double*> ints;
+            for (int comp = 0;comp < nmom;comp++) ints.push_back(s.getIntegrals(first+comp));
+            if (kinetic) ints.push_back(s.getIntegrals(s.getNumComponents()-1));
+            if (nuclear) ints.push_back(g->getIntegrals().data());
+
+            int fsa = shells[a].getNFunc(), ma = shells[a].getNContr();
+            int fsb = shells[b].getNFunc(), mb = shells[b].getNContr();
+
+            size_t m = 0;
+            for (int j = 0;j < fsb;j++)
+            {
+                for (int i = 0;i < fsa;i++)
                 {
-                    //calc integrals
+                    for (int f = 0;f < mb;f++)
+                    {
+                        for (int e = 0;e < ma;e++, m++)
+                        {
+                            int p = shells[a].getIndex(ctx, idx[a], i, e, 0);
+                            int q = shells[b].getIndex(ctx, idx[b], j, f, 0);
 
-                    //put into pairs
-                }
+                            if (a == b && p < q) continue;
 
-                ij++;
+                            for (int comp = 0;comp < ncomp;comp++)
+                            {
+                                            pairs[comp].emplace_back(p*N[0]+q, ints[comp][m]);
+                                if (p != q) pairs[comp].emplace_back(q*N[0]+p, ints[comp][m]);
+                            }
+                        }
+                    }
+                }
             }
         }
+    }
+
+    vector<SymmetryBlockedTensor<T>*> ao;
+    for (int comp = 0;comp < ncomp;comp++)
+    {
+        ao.push_back(new SymmetryBlockedTensor<T>("ao", arena, group, 2, {N,N}, {NS,NS}, true));
+        ao.back()->writeRemoteData({0,0}, pairs[comp]);
+        vector<tkv_pair<T>>().swap(pairs[comp]);
+    }
+
+    put("multipole", new Multipole<T>("M", occ, vrt,
+        vector<SymmetryBlockedTensor<T>*>(ao.begin(), ao.begin()+nmom), lmin, lmax));
+
+    int comp = nmom;
+    if (kinetic)
+    {
+        put("T", new OneElectronOperator<T>("T", occ, vrt, *ao[comp], *ao[comp]));
+        comp++;
+    }
+    if (nuclear)
+    {
+        put("G", new OneElectronOperator<T>("G", occ, vrt, *ao[comp], *ao[comp]));
+    }
 
-        for (int xyz = 0;xyz < (L+1)*(L+2)/2;xyz++)
+    for (auto a : ao) delete a;
+
+    return true;
+}
+
+/*
+ * Expectation value of A in the reference determinant, i.e. the trace of its
+ * occupied-occupied block over both spins
+ */
+template <typename T>
+static T occupiedTrace(const OneElectronOperator<T>& A)
+{
+    T trace = 0;
+
+    for (int spin = 0;spin < 2;spin++)
+    {
+        vector<int> alpha = {0, (spin == 0 ? 1 : 0)};
+        const SymmetryBlockedTensor<T>& IJ = A.getIJ()(alpha, alpha);
+
+        for (int h = 0;h < A.occ.group.getNumIrreps();h++)
         {
-            ao = (T)0;
-            //ao.writeRemoteData(pairs[xyz]);
-            this->tensors[xyztot++].tensor = new OneElectronOperator<T>(name, uhf, ao);
+            int n = (spin == 0 ? A.occ.nalpha[h] : A.occ.nbeta[h]);
+            if (n == 0) continue;
+
+            vector<T> data;
+            IJ.getAllData({h,h}, data);
+            for (int i = 0;i < n;i++) trace += data[i+n*i];
         }
     }
+
+    return trace;
 }
 
 template <typename T>
-const OneElectronOperator<T>& Multipole<T>::operator()(int L, int xyz) const
+SCFProperties<T>::SCFProperties(const string& name, Config& config)
+: Task(name, config), integrals(config.get<string>("integrals"))
 {
-    assert(L >= Lmin && L <= Lmax);
-    assert(xyz >= 0 && xyz < (L+1)*(L+2)/2);
-    return (*this)(L*(L+1)*(L+2)/6-Lmin*(Lmin+1)*(Lmin+2)/6+xyz);
+    vector<Requirement> reqs;
+    if (integrals == "propints")
+    {
+        reqs.emplace_back("multipole", "M");
+        reqs.emplace_back("mokei", "T");
+        reqs.emplace_back("monai", "G");
+    }
+    else
+    {
+        reqs.emplace_back("occspace", "occ");
+        reqs.emplace_back("vrtspace", "vrt");
+        reqs.emplace_back("kei", "T");
+        reqs.emplace_back("nai", "G");
+    }
+
+    addProduct("double", "kinetic", reqs);
+    addProduct("double", "potential", reqs);
+    if (integrals == "propints")
+    {
+        addProduct("double", "electrons", reqs);
+        addProduct("double", "dipole", reqs);
+    }
 }
 
 template <typename T>
-const OneElectronOperator<T>& Multipole<T>::operator()(int x, int y, int z) const
+bool SCFProperties<T>::run(TaskDAG& dag, const Arena& arena)
 {
-    int L = x+y+z;
-    assert(L >= Lmin && L <= Lmax);
-    int xyz = z+(L+1-x)*(L+2-x)/2;
-    return (*this)(L, xyz);
+    double kinetic, potential;
+
+    if (integrals == "propints")
+    {
+        kinetic = real(occupiedTrace(get<OneElectronOperator<T>>("T")));
+        potential = real(occupiedTrace(get<OneElectronOperator<T>>("G")));
+    }
+    else
+    {
+        const auto& occ = get<MOSpace<T>>("occ");
+        const auto& vrt = get<MOSpace<T>>("vrt");
+        const auto& Tao = get<SymmetryBlockedTensor<T>>("T");
+        const auto& Gao = get<SymmetryBlockedTensor<T>>("G");
+
+        kinetic = real(occupiedTrace(OneElectronOperator<T>("T", occ, vrt, Tao, Tao)));
+        potential = real(occupiedTrace(OneElectronOperator<T>("G", occ, vrt, Gao, Gao)));
+    }
+
+    log(arena) << printos("kinetic energy:     %18.12f", kinetic) << endl;
+    log(arena) << printos("nuclear attraction: %18.12f", potential) << endl;
+
+    put("kinetic", new double(kinetic));
+    put("potential", new double(potential));
+
+    if (integrals == "propints")
+    {
+        const auto& M = get<Multipole<T>>("M");
+
+        if (M.getLmin() > 0 || M.getLmax() < 1)
+            throw runtime_error("The dipole moment needs multipole orders 0 and 1");
+
+        double electrons = real(occupiedTrace(M(0,0)));
+
+        /*
+         * The moments are about the center of nuclear charge, so only the
+         * electrons contribute to the dipole moment
+         */
+        vec3 mu;
+        for (int xyz = 0;xyz < 3;xyz++) mu[xyz] = -real(occupiedTrace(M(1,xyz)));
+
+        log(arena) << printos("electrons:          %18.12f", electrons) << endl;
+        log(arena) << printos("dipole moment:      %18.12f %18.12f %18.12f", mu[0], mu[1], mu[2]) << endl;
+
+        put("electrons", new double(electrons));
+        put("dipole", new double(norm(mu)));
+    }
+
+    return true;
+}
+
+}
 }
+
+static const char* spec = R"!(
+
+lmin?
+    int 0,
+lmax?
+    int 3,
+kinetic?
+    bool true,
+nuclear?
+    bool true
+
+)!";
+
+static const char* props_spec = R"!(
+
+# source of the kinetic energy and nuclear attraction integrals; the number
+# of electrons and the dipole moment are only found with propints
+integrals?
+    enum { propints, 1eints }
+
+)!";
+
+INSTANTIATE_SPECIALIZATIONS(aquarius::op::Multipole);
+INSTANTIATE_SPECIALIZATIONS(aquarius::op::PropertyIntegrals);
+INSTANTIATE_SPECIALIZATIONS(aquarius::op::SCFProperties);
+REGISTER_TASK(aquarius::op::PropertyIntegrals<double>,"propints",spec);
+REGISTER_TASK(aquarius::op::SCFProperties<double>,"scfprops",props_spec);
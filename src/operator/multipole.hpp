@@ -1,9 +1,10 @@
 #ifndef _AQUARIUS_OPERATOR_MULTIPOLE_HPP_
 #define _AQUARIUS_OPERATOR_MULTIPOLE_HPP_
 
-#include "../scf/uhf.hpp"
 #include "util/global.hpp"
 
+#include "task/task.hpp"
+
 #include "1eoperator.hpp"
 
 namespace aquarius
@@ -11,20 +12,69 @@ namespace aquarius
 namespace op
 {
 
+/*
+ * Cartesian multipole moment operators of orders Lmin through Lmax in the MO
+ * basis, transformed from AO integrals given in the order of the components.
+ */
 template <typename T>
-class Multipole : public MOOperator<T>, public tensor::CompositeTensor<Multipole<T>,OneElectronOperator<T>,T>
+class Multipole : public MOOperator, public tensor::CompositeTensor<Multipole<T>,OneElectronOperator<T>,T>
 {
+    INHERIT_FROM_COMPOSITE_TENSOR(Multipole<T>,OneElectronOperator<T>,T)
+
     protected:
         int Lmin, Lmax;
 
     public:
-        Multipole(const string& name, const scf::UHF<T>& uhf, int Lmin, int Lmax=-1);
+        Multipole(const string& name, const MOSpace<T>& occ, const MOSpace<T>& vrt,
+                  const vector<tensor::SymmetryBlockedTensor<T>*>& ao, int Lmin, int Lmax=-1);
+
+        int getLmin() const { return Lmin; }
+
+        int getLmax() const { return Lmax; }
 
         const OneElectronOperator<T>& operator()(int L, int xyz) const;
 
         const OneElectronOperator<T>& operator()(int x, int y, int z) const;
 };
 
+/*
+ * Property integrals in one pass over the shell pairs: all multipole
+ * moments up to lmax and the kinetic energy integrals from the shared
+ * recursion tables of OSMoments, and the nuclear attraction integrals,
+ * each gathered into a single batch of updates to its AO tensor before
+ * being transformed to the MO basis.
+ */
+template <typename T>
+class PropertyIntegrals : public task::Task
+{
+    protected:
+        int lmin, lmax;
+        bool kinetic, nuclear;
+
+    public:
+        PropertyIntegrals(const string& name, input::Config& config);
+
+        bool run(task::TaskDAG& dag, const Arena& arena);
+};
+
+/*
+ * One-electron properties of the SCF reference: the kinetic energy and
+ * nuclear attraction energy, from either the products of PropertyIntegrals
+ * or the AO integrals of 1eints transformed to the MO basis, and with
+ * PropertyIntegrals the number of electrons and the dipole moment.
+ */
+template <typename T>
+class SCFProperties : public task::Task
+{
+    protected:
+        string integrals;
+
+    public:
+        SCFProperties(const string& name, input::Config& config);
+
+        bool run(task::TaskDAG& dag, const Arena& arena);
+};
+
 }
 }
 
@@ -18,6 +18,8 @@ template <typename T>
 RHFAOMOIntegrals<T>::RHFAOMOIntegrals(const string& name, Config& config)
 : Task(name, config)
 {
+    nchunk = config.get<int>("collect_batches");
+
     vector<Requirement> reqs;
     reqs += Requirement("occspace", "occ");
     reqs += Requirement("vrtspace", "vrt");
@@ -83,15 +85,20 @@ bool RHFAOMOIntegrals<T>::run(TaskDAG& dag, const Arena& arena)
      * are dense blocks for each sparse rs pair
      */
     pqrs_integrals<T> pqrs(N, ints);
-    pqrs.collect(true);
-    abrs_integrals<T> PQrs(pqrs, true);
 
     /*
-     * First quarter-transformation
+     * First quarter-transformation, done batch-wise as the (rs) pairs arrive
      */
-    abrs_integrals<T> PArs = PQrs.transform(B, nA, cA);
-    abrs_integrals<T> PIrs = PQrs.transform(B, nI, cI);
-    PQrs.free();
+    abrs_integrals<T> PArs(arena, ints.group);
+    abrs_integrals<T> PIrs(arena, ints.group);
+    pqrs.collect(true, nchunk,
+    [&](pqrs_integrals<T>& chunk)
+    {
+        abrs_integrals<T> PQrs(chunk, true);
+        PArs.append(PQrs.transform(B, nA, cA));
+        PIrs.append(PQrs.transform(B, nI, cI));
+        PQrs.free();
+    });
 
     /*
      * Second quarter-transformation
@@ -182,5 +189,12 @@ bool RHFAOMOIntegrals<T>::run(TaskDAG& dag, const Arena& arena)
 }
 }
 
+static const char* spec = R"!(
+
+collect_batches?
+    int 4
+
+)!";
+
 INSTANTIATE_SPECIALIZATIONS(aquarius::op::RHFAOMOIntegrals);
-REGISTER_TASK(aquarius::op::RHFAOMOIntegrals<double>,"rhfaomoints");
+REGISTER_TASK(aquarius::op::RHFAOMOIntegrals<double>,"rhfaomoints",spec);
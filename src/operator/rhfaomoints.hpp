@@ -21,6 +21,8 @@ class RHFAOMOIntegrals : public task::Task
         RHFAOMOIntegrals(const string& name, input::Config& config);
 
     protected:
+        int nchunk;
+
         bool run(task::TaskDAG& dag, const Arena& arena);
 };
 
@@ -22,6 +22,19 @@ namespace op
 template <typename U>
 class STTwoElectronOperator : public TwoElectronOperator<U>
 {
+    protected:
+        /*
+         * When the four-virtual block is implicit, abcd refers to the bare
+         * integrals of X and the dressing
+         *
+         * W(ab,ef) = <ab||ef> + 1/2 Taub(ab,mn) <mn||ef> - P(ab) W(am,ef) T(b,m)
+         *
+         * with Taub(ab,ij) = T(ab,ij) - P(ab) T(a,i) T(b,j) is applied whenever
+         * the block is contracted, using the already-dressed W(am,ef)
+         */
+        shared_ptr<tensor::SpinorbitalTensor<U>> taubar;
+        shared_ptr<tensor::SpinorbitalTensor<U>> t1;
+
     public:
         template <int N>
         STTwoElectronOperator(const string& name, const OneElectronOperator<U>& X, const ExcitationOperator<U,N>& T)
@@ -50,11 +63,19 @@ class STTwoElectronOperator : public TwoElectronOperator<U>
             }
         }
 
+        /*
+         * If implicit is true (only allowed for isHbar) the four-virtual block
+         * shares storage with X instead of being copied and dressed, so X must
+         * outlive this operator
+         */
         template <int N>
-        STTwoElectronOperator(const string& name, const TwoElectronOperator<U>& X, const ExcitationOperator<U,N>& T, bool isHbar=false)
-        : TwoElectronOperator<U>(name, X)
+        STTwoElectronOperator(const string& name, const TwoElectronOperator<U>& X, const ExcitationOperator<U,N>& T,
+                              bool isHbar=false, bool implicit=false)
+        : TwoElectronOperator<U>(name, const_cast<TwoElectronOperator<U>&>(X),
+                                 implicit ? ~TwoElectronOperator<U>::ABCD : ~0)
         {
             assert(N >= 2 && N <= 4);
+            assert(isHbar || !implicit);
 
             tensor::SpinorbitalTensor<U> Tau(T(2));
             Tau["abij"] += 0.5*T(1)["ai"]*T(1)["bj"];
@@ -125,8 +146,17 @@ class STTwoElectronOperator : public TwoElectronOperator<U>
 
             this->aibj["amei"] -= 0.5*this->ijak["nmei"]*T(1)["an"];
 
-            this->abcd["abef"] += 0.5*this->ijab["mnef"]*Tau["abmn"];
-            this->abcd["abef"] -= this->aibc["amef"]*T(1)["bm"];
+            if (implicit)
+            {
+                taubar.reset(new tensor::SpinorbitalTensor<U>("Taubar", T(2)));
+                (*taubar)["abij"] -= 0.5*T(1)["ai"]*T(1)["bj"];
+                t1.reset(new tensor::SpinorbitalTensor<U>("T1", T(1)));
+            }
+            else
+            {
+                this->abcd["abef"] += 0.5*this->ijab["mnef"]*Tau["abmn"];
+                this->abcd["abef"] -= this->aibc["amef"]*T(1)["bm"];
+            }
 
             this->aibc["amef"] -= this->ijab["nmef"]*T(1)["an"];
 
@@ -151,6 +181,62 @@ class STTwoElectronOperator : public TwoElectronOperator<U>
                 this->abij["abij"] += 0.25*this->ijab["mnef"]*T(4)["abefijmn"];
             }
         }
+
+        bool isImplicit() const { return bool(taubar); }
+
+        /*
+         * The four-virtual block may only be accessed directly when it is
+         * stored explicitly; otherwise use contractABCD
+         */
+        tensor::SpinorbitalTensor<U>& getABCD()
+        {
+            if (isImplicit()) throw logic_error("ABCD block of " + this->name + " is implicit");
+            return this->abcd;
+        }
+
+        const tensor::SpinorbitalTensor<U>& getABCD() const
+        {
+            if (isImplicit()) throw logic_error("ABCD block of " + this->name + " is implicit");
+            return this->abcd;
+        }
+
+        /*
+         * Z(ab,ij) += alpha W(ab,ef) X(ef,ij)
+         */
+        void contractABCD(U alpha, const tensor::SpinorbitalTensor<U>& X, tensor::SpinorbitalTensor<U>& Z) const
+        {
+            Z["abij"] += alpha*this->abcd["abef"]*X["efij"];
+
+            if (!isImplicit()) return;
+
+            tensor::SpinorbitalTensor<U> Y("Y", this->arena, this->occ.group, {this->vrt, this->occ}, {0,2}, {0,2});
+            tensor::SpinorbitalTensor<U> G("G", this->arena, this->occ.group, {this->vrt, this->occ}, {1,1}, {0,2});
+
+            Y["mnij"]  = this->ijab["mnef"]*X["efij"];
+            G["amij"]  = this->aibc["amef"]*X["efij"];
+
+            Z["abij"] += 0.5*alpha*(*taubar)["abmn"]*Y["mnij"];
+            Z["abij"] -= alpha*G["amij"]*(*t1)["bm"];
+        }
+
+        /*
+         * Z(ij,ab) += alpha X(ij,ef) W(ef,ab)
+         */
+        void contractABCDLeft(U alpha, const tensor::SpinorbitalTensor<U>& X, tensor::SpinorbitalTensor<U>& Z) const
+        {
+            Z["ijab"] += alpha*X["ijef"]*this->abcd["efab"];
+
+            if (!isImplicit()) return;
+
+            tensor::SpinorbitalTensor<U> Y("Y", this->arena, this->occ.group, {this->vrt, this->occ}, {0,2}, {0,2});
+            tensor::SpinorbitalTensor<U> G("G", this->arena, this->occ.group, {this->vrt, this->occ}, {0,2}, {1,1});
+
+            Y["ijmn"]  = X["ijef"]*(*taubar)["efmn"];
+            G["ijem"]  = X["ijef"]*(*t1)["fm"];
+
+            Z["ijab"] += 0.5*alpha*Y["ijmn"]*this->ijab["mnab"];
+            Z["ijab"] -= 2*alpha*G["ijem"]*this->aibc["emab"];
+        }
 };
 
 }
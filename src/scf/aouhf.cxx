@@ -267,6 +267,8 @@ static const char* spec = R"(
 
     frozen_core?
         bool false,
+    guess?
+        enum { CORE, AUFBAU, PROJECT },
     convergence?
         double 1e-12,
     max_iterations?
@@ -1,5 +1,7 @@
 #include "uhf.hpp"
 
+#include "integrals/ovi.hpp"
+
 using namespace aquarius::tensor;
 using namespace aquarius::input;
 using namespace aquarius::integrals;
@@ -16,16 +18,29 @@ namespace scf
 template <typename T>
 UHF<T>::UHF(const string& name, Config& config)
 : Iterative<T>(name, config), frozen_core(config.get<bool>("frozen_core")),
-  diis(config.get("diis"), 2)
+  guess(config.get<string>("guess")), diis(config.get("diis"), 2)
 {
     vector<Requirement> reqs;
     reqs += Requirement("molecule", "molecule");
     reqs += Requirement("ovi", "S");
     reqs += Requirement("1ehamiltonian", "H");
+
+    /*
+     * The projection guess needs the molecule (i.e. basis) and densities of
+     * a previous SCF, which should be hooked up explicitly with e.g.
+     * "using guess_molecule from small.molecule:molecule"
+     */
+    if (guess == "PROJECT")
+    {
+        reqs += Requirement("molecule", "guess_molecule");
+        reqs += Requirement("Da", "guess_Da");
+        reqs += Requirement("Db", "guess_Db");
+    }
     this->addProduct(Product("double", "energy", reqs));
     this->addProduct(Product("double", "convergence", reqs));
     this->addProduct(Product("double", "S2", reqs));
     this->addProduct(Product("double", "multiplicity", reqs));
+    this->addProduct(Product("double", "iterations", reqs));
     this->addProduct(Product("occspace", "occ", reqs));
     this->addProduct(Product("vrtspace", "vrt", reqs));
     this->addProduct(Product("Ea", "Ea", reqs));
@@ -74,6 +89,7 @@ bool UHF<T>::run(TaskDAG& dag, const Arena& arena)
     }
 
     calcSMinusHalf();
+    calcGuess();
 
     CTF_Timer_epoch ep(this->name.c_str());
     ep.begin();
@@ -87,6 +103,7 @@ bool UHF<T>::run(TaskDAG& dag, const Arena& arena)
 
     this->put("energy", new T(this->energy()));
     this->put("convergence", new T(this->conv()));
+    this->put("iterations", new T(this->iter()-1));
 
     int nfrozen = 0;
     if (frozen_core)
@@ -198,10 +215,19 @@ void UHF<T>::iterate(const Arena& arena)
     int nalpha = molecule.getNumAlphaElectrons();
     int nbeta = molecule.getNumBetaElectrons();
 
+    PROFILE_SECTION(scf_fock)
     buildFock();
+    PROFILE_STOP
+
+    PROFILE_SECTION(scf_diis)
     DIISExtrap();
+    PROFILE_STOP
+
     calcEnergy();
+
+    PROFILE_SECTION(scf_diagonalize)
     diagonalizeFock();
+    PROFILE_STOP
 
     vector<pair<real_type_t<T>,int>> E_alpha_sorted;
     vector<pair<real_type_t<T>,int>> E_beta_sorted;
@@ -233,7 +259,9 @@ void UHF<T>::iterate(const Arena& arena)
 
     Logger::log(arena) << "Iteration " << this->iter() << " occupation = " << occ_alpha << ", " << occ_beta << endl;
 
+    PROFILE_SECTION(scf_density)
     calcDensity();
+    PROFILE_STOP
 
     auto& dDa = this->template gettmp<SymmetryBlockedTensor<T>>("dDa");
     auto& dDb = this->template gettmp<SymmetryBlockedTensor<T>>("dDb");
@@ -287,6 +315,234 @@ void UHF<T>::calcS2()
     this->put("multiplicity", new T(sqrt(4*S2+1)));
 }
 
+template <typename T>
+void UHF<T>::calcGuess()
+{
+    if (guess == "AUFBAU")
+    {
+        atomicOccupationGuess();
+    }
+    else if (guess == "PROJECT")
+    {
+        projectedDensityGuess();
+    }
+}
+
+/*
+ * Superposition of atomic aufbau occupations (not a true SAD guess, since no
+ * atomic SCF is done), with each atom's electrons placed in its contracted
+ * functions in aufbau order. The k-th contraction of angular
+ * momentum L on an atom is taken as the (L+k+1)L atomic orbital, and each
+ * function gets an equal share of the shell's occupation. The result is
+ * diagonal in the SO basis since symmetry-equivalent atoms have the same
+ * occupations.
+ */
+template <typename T>
+void UHF<T>::atomicOccupationGuess()
+{
+    const Molecule& molecule = this->template get<Molecule>("molecule");
+
+    const vector<int>& norb = molecule.getNumOrbitals();
+    int nirrep = molecule.getGroup().getNumIrreps();
+    int nelec = molecule.getNumElectrons();
+    int nalpha = molecule.getNumAlphaElectrons();
+    int nbeta = molecule.getNumBetaElectrons();
+
+    auto& Da = this->template get<SymmetryBlockedTensor<T>>("Da");
+    auto& Db = this->template get<SymmetryBlockedTensor<T>>("Db");
+
+    vector<vector<tkv_pair<T>>> pairs(nirrep);
+
+    if (Da.arena.rank == 0)
+    {
+        Context ctx(Context::ISCF);
+        vector<vector<int>> idx = Shell::setupIndices(ctx, molecule);
+
+        vector<int> start(nirrep, 0);
+        for (int i = 1;i < nirrep;i++) start[i] = start[i-1]+norb[i-1];
+
+        vector<vector<double>> occ(nirrep);
+        for (int i = 0;i < nirrep;i++) occ[i].resize(norb[i], 0.0);
+
+        vector<const Shell*> shells;
+        for (auto s = molecule.getShellsBegin();s != molecule.getShellsEnd();++s) shells.push_back(&*s);
+
+        double nassigned = 0;
+        int shell = 0;
+
+        for (auto& atom : molecule.getAtoms())
+        {
+            /*
+             * (n+L, n, shell, contraction) for each atomic orbital
+             */
+            vector<tuple<int,int,int,int>> aos;
+            vector<int> nL;
+
+            for (auto s = atom.getShellsBegin();s != atom.getShellsEnd();++s, ++shell)
+            {
+                int L = s->getL();
+                if (nL.size() <= L) nL.resize(L+1, 0);
+
+                for (int c = 0;c < s->getNContr();c++)
+                {
+                    int n = L+1+nL[L]++;
+                    aos.emplace_back(n+L, n, shell, c);
+                }
+            }
+
+            sort(aos.begin(), aos.end());
+
+            double left = atom.getCenter().getElement().getAtomicNumber();
+
+            for (auto& ao : aos)
+            {
+                if (left <= 0) break;
+
+                const Shell& s = *shells[get<2>(ao)];
+                int c = get<3>(ao);
+                double nocc = min(left, 2.0*(2*s.getL()+1));
+                left -= nocc;
+
+                for (int f = 0;f < s.getNFunc();f++)
+                {
+                    for (int d = 0;d < s.getDegeneracy();d++)
+                    {
+                        int irrep = s.getIrrepOfFunc(f, d);
+                        int i = s.getIndex(ctx, idx[get<2>(ao)], f, c, d)-start[irrep];
+                        occ[irrep][i] += nocc/s.getNFunc();
+                    }
+                }
+
+                nassigned += nocc*s.getDegeneracy();
+            }
+        }
+
+        /*
+         * Renormalize to the actual number of electrons, which accounts for
+         * the molecular charge and for atoms whose basis is too small
+         */
+        double scale = (nassigned > 0 ? nelec/nassigned : 0.0);
+
+        for (int i = 0;i < nirrep;i++)
+        {
+            for (int j = 0;j < norb[i];j++)
+            {
+                if (occ[i][j] == 0.0) continue;
+                pairs[i].push_back(tkv_pair<T>(j+j*norb[i], scale*occ[i][j]));
+            }
+        }
+    }
+
+    for (int i = 0;i < nirrep;i++)
+    {
+        vector<int> irreps(2,i);
+        Da.writeRemoteData(irreps, pairs[i]);
+        Db.writeRemoteData(irreps, pairs[i]);
+    }
+
+    Da *= (T)nalpha/(T)max(nelec, 1);
+    Db *= (T)nbeta/(T)max(nelec, 1);
+}
+
+/*
+ * Project the densities of a previous SCF in another basis (usually a smaller
+ * one) onto this basis:
+ *
+ *        -1             -1
+ *   D = S   S(b,g) D(g) S(g,b) S
+ */
+template <typename T>
+void UHF<T>::projectedDensityGuess()
+{
+    const Molecule& molecule = this->template get<Molecule>("molecule");
+    const Molecule& guess_molecule = this->template get<Molecule>("guess_molecule");
+    const PointGroup& group = molecule.getGroup();
+
+    if (!(group == guess_molecule.getGroup()))
+        throw runtime_error("Guess molecule must have the same point group");
+
+    const vector<int>& norb = molecule.getNumOrbitals();
+    const vector<int>& norb_g = guess_molecule.getNumOrbitals();
+    int nirrep = group.getNumIrreps();
+
+    auto& Smhalf = this->template gettmp<SymmetryBlockedTensor<T>>("S^-1/2");
+    auto& Da     = this->template get   <SymmetryBlockedTensor<T>>("Da");
+    auto& Db     = this->template get   <SymmetryBlockedTensor<T>>("Db");
+    auto& Da_g   = this->template get   <SymmetryBlockedTensor<T>>("guess_Da");
+    auto& Db_g   = this->template get   <SymmetryBlockedTensor<T>>("guess_Db");
+
+    const Arena& arena = Da.arena;
+
+    Context ctx(Context::ISCF);
+    vector<vector<int>> idx = Shell::setupIndices(ctx, molecule);
+    vector<vector<int>> idx_g = Shell::setupIndices(ctx, guess_molecule);
+    vector<Shell> shells(molecule.getShellsBegin(), molecule.getShellsEnd());
+    vector<Shell> shells_g(guess_molecule.getShellsBegin(), guess_molecule.getShellsEnd());
+
+    vector<int> irrep, irrep_g;
+    for (int i = 0;i < nirrep;i++) irrep += vector<int>(norb[i],i);
+    for (int i = 0;i < nirrep;i++) irrep_g += vector<int>(norb_g[i],i);
+
+    vector<int> start(nirrep,0), start_g(nirrep,0);
+    for (int i = 1;i < nirrep;i++) start[i] = start[i-1]+norb[i-1];
+    for (int i = 1;i < nirrep;i++) start_g[i] = start_g[i-1]+norb_g[i-1];
+
+    vector<vector<tkv_pair<T>>> pairs(nirrep);
+
+    int block = 0;
+    for (int a = 0;a < shells.size();a++)
+    {
+        for (int b = 0;b < shells_g.size();b++, block++)
+        {
+            if (block%arena.size != arena.rank) continue;
+
+            IshidaOVI s(shells[a], shells_g[b]);
+            s.run();
+
+            size_t nint = s.getIntegrals().size();
+            vector<double> ints(nint);
+            vector<idx2_t> idxs(nint);
+
+            size_t nproc = s.process(ctx, idx[a], idx_g[b], nint, ints.data(), idxs.data());
+            for (int k = 0;k < nproc;k++)
+            {
+                int irr = irrep[idxs[k].i];
+                assert(irr == irrep_g[idxs[k].j]);
+
+                int i = idxs[k].i-start[irr];
+                int j = idxs[k].j-start_g[irr];
+
+                pairs[irr].push_back(tkv_pair<T>(i+j*norb[irr], ints[k]));
+            }
+        }
+    }
+
+    SymmetryBlockedTensor<T> Sbg("S(b,g)", arena, group, 2, {norb,norb_g}, {NS,NS}, true);
+
+    for (int i = 0;i < nirrep;i++)
+    {
+        vector<int> irreps(2,i);
+        Sbg.writeRemoteData(irreps, pairs[i]);
+    }
+
+    SymmetryBlockedTensor<T> Sinv("S^-1", arena, group, 2, {norb,norb}, {NS,NS}, false);
+    SymmetryBlockedTensor<T> tmp1("tmp", arena, group, 2, {norb,norb_g}, {NS,NS}, false);
+    SymmetryBlockedTensor<T> tmp2("tmp", arena, group, 2, {norb,norb}, {NS,NS}, false);
+    SymmetryBlockedTensor<T> tmp3("tmp", arena, group, 2, {norb,norb}, {NS,NS}, false);
+
+    Sinv["ab"] = Smhalf["ac"]*Smhalf["cb"];
+
+    tmp1["ai"] =  Sbg["aj"]*Da_g["ji"];
+    tmp2["ab"] = tmp1["ai"]* Sbg["bi"];
+    tmp3["ab"] = Sinv["ac"]*tmp2["cb"];
+      Da["ab"] = tmp3["ac"]*Sinv["cb"];
+
+    tmp1["ai"] =  Sbg["aj"]*Db_g["ji"];
+    tmp2["ab"] = tmp1["ai"]* Sbg["bi"];
+    tmp3["ab"] = Sinv["ac"]*tmp2["cb"];
+      Db["ab"] = tmp3["ac"]*Sinv["cb"];
+}
+
 template <typename T>
 void UHF<T>::calcEnergy()
 {
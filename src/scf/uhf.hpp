@@ -22,6 +22,7 @@ class UHF : public Iterative<T>
 {
     protected:
         bool frozen_core;
+        string guess;
         T damping;
         vector<int> occ_alpha, occ_beta;
         vector<vector<real_type_t<T>>> E_alpha, E_beta;
@@ -43,6 +44,12 @@ class UHF : public Iterative<T>
 
         virtual void buildFock() = 0;
 
+        void calcGuess();
+
+        void atomicOccupationGuess();
+
+        void projectedDensityGuess();
+
         void calcEnergy();
 
         void calcDensity();
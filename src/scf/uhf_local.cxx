@@ -23,11 +23,14 @@ void LocalUHF<T>::calcSMinusHalf()
     const Molecule& molecule = this->template get<Molecule>("molecule");
 
     const vector<int>& norb = molecule.getNumOrbitals();
+    int nirrep = molecule.getGroup().getNumIrreps();
 
     auto& S = this->template get<SymmetryBlockedTensor<T>>("S");
     auto& Smhalf = this->template gettmp<SymmetryBlockedTensor<T>>("S^-1/2");
 
-    for (int i = 0;i < molecule.getGroup().getNumIrreps();i++)
+    const Arena& arena = S.arena;
+
+    for (int i = 0;i < nirrep;i++)
     {
         //cout << "S " << (i+1) << endl;
         //vector<T> vals;
@@ -35,45 +38,70 @@ void LocalUHF<T>::calcSMinusHalf()
         //printmatrix(norb[i], norb[i], vals.data(), 6, 3, 108);
     }
 
-    for (int i = 0;i < molecule.getGroup().getNumIrreps();i++)
+    /*
+     * Irreps are assigned to ranks round-robin: first gather each block onto
+     * its owner, then let every rank work on its own blocks concurrently,
+     * and finally write all of the results back
+     */
+    vector<vector<T>> smhalf(nirrep);
+
+    for (int i = 0;i < nirrep;i++)
     {
         if (norb[i] == 0) continue;
 
         vector<int> irreps(2,i);
-        vector<real_type_t<T>> E(norb[i]);
+        int owner = i%arena.size;
 
-        if (S.arena.rank == 0)
+        if (arena.rank == owner)
+        {
+            S.getAllData(irreps, smhalf[i], owner);
+            assert(smhalf[i].size() == norb[i]*norb[i]);
+        }
+        else
         {
-            vector<T> s;
-            vector<T> smhalf(norb[i]*norb[i]);
+            S.getAllData(irreps, owner);
+        }
+    }
 
-            S.getAllData(irreps, s, 0);
-            assert(s.size() == norb[i]*norb[i]);
+    for (int i = 0;i < nirrep;i++)
+    {
+        if (norb[i] == 0 || i%arena.size != arena.rank) continue;
 
-            //PROFILE_FLOPS(26*norb[i]*norb[i]*norb[i]);
-            int info = heev('V', 'U', norb[i], s.data(), norb[i], E.data());
-            assert(info == 0);
+        vector<T> s(smhalf[i]);
+        vector<real_type_t<T>> E(norb[i]);
 
-            fill(smhalf.begin(), smhalf.end(), (T)0);
-            //PROFILE_FLOPS(2*norb[i]*norb[i]*norb[i]);
-            for (int j = 0;j < norb[i];j++)
-            {
-                ger(norb[i], norb[i], 1/sqrt(E[j]), &s[j*norb[i]], 1, &s[j*norb[i]], 1, smhalf.data(), norb[i]);
-            }
+        //PROFILE_FLOPS(26*norb[i]*norb[i]*norb[i]);
+        int info = heev('V', 'U', norb[i], s.data(), norb[i], E.data());
+        assert(info == 0);
+
+        fill(smhalf[i].begin(), smhalf[i].end(), (T)0);
+        //PROFILE_FLOPS(2*norb[i]*norb[i]*norb[i]);
+        for (int j = 0;j < norb[i];j++)
+        {
+            ger(norb[i], norb[i], 1/sqrt(E[j]), &s[j*norb[i]], 1, &s[j*norb[i]], 1, smhalf[i].data(), norb[i]);
+        }
+    }
+
+    for (int i = 0;i < nirrep;i++)
+    {
+        if (norb[i] == 0) continue;
+
+        vector<int> irreps(2,i);
 
+        if (i%arena.size == arena.rank)
+        {
             vector<tkv_pair<T>> pairs(norb[i]*norb[i]);
 
             for (int j = 0;j < norb[i]*norb[i];j++)
             {
                 pairs[j].k = j;
-                pairs[j].d = smhalf[j];
+                pairs[j].d = smhalf[i][j];
             }
 
             Smhalf.writeRemoteData(irreps, pairs);
         }
         else
         {
-            S.getAllData(irreps, 0);
             Smhalf.writeRemoteData(irreps);
         }
     }
@@ -85,6 +113,7 @@ void LocalUHF<T>::diagonalizeFock()
     const Molecule& molecule = this->template get<Molecule>("molecule");
 
     const vector<int>& norb = molecule.getNumOrbitals();
+    int nirrep = molecule.getGroup().getNumIrreps();
 
     auto& S  = this->template get   <SymmetryBlockedTensor<T>>("S");
     auto& Fa = this->template get   <SymmetryBlockedTensor<T>>("Fa");
@@ -92,7 +121,9 @@ void LocalUHF<T>::diagonalizeFock()
     auto& Ca = this->template gettmp<SymmetryBlockedTensor<T>>("Ca");
     auto& Cb = this->template gettmp<SymmetryBlockedTensor<T>>("Cb");
 
-    for (int i = 0;i < molecule.getGroup().getNumIrreps();i++)
+    const Arena& arena = S.arena;
+
+    for (int i = 0;i < nirrep;i++)
     {
         //cout << "F " << (i+1) << endl;
         //vector<T> vals;
@@ -100,69 +131,102 @@ void LocalUHF<T>::diagonalizeFock()
         //printmatrix(norb[i], norb[i], vals.data(), 6, 3, 108);
     }
 
-    for (int i = 0;i < molecule.getGroup().getNumIrreps();i++)
+    /*
+     * The generalized eigenproblem for irrep i and spin s is solved on rank
+     * (2*i+s)%nproc; gathers, solves, and write-backs are done in separate
+     * sweeps so that the solves on different ranks overlap
+     */
+    vector<vector<T>> s(2*nirrep), fock(2*nirrep);
+
+    for (int i = 0;i < nirrep;i++)
     {
         if (norb[i] == 0) continue;
 
         vector<int> irreps(2,i);
 
-        if (S.arena.rank == 0)
+        for (int spin : {0,1})
         {
-            vector<T> s;
-            S.getAllData(irreps, s, 0);
-            assert(s.size() == norb[i]*norb[i]);
+            auto& F = (spin == 0 ? Fa : Fb);
+            int owner = (2*i+spin)%arena.size;
 
-            for (int spin : {0,1})
+            if (arena.rank == owner)
             {
-                auto& F = (spin == 0 ? Fa : Fb);
-                auto& C = (spin == 0 ? Ca : Cb);
-                auto& E = (spin == 0 ? E_alpha[i] : E_beta[i]);
+                S.getAllData(irreps, s[2*i+spin], owner);
+                F.getAllData(irreps, fock[2*i+spin], owner);
+                assert(s[2*i+spin].size() == norb[i]*norb[i]);
+                assert(fock[2*i+spin].size() == norb[i]*norb[i]);
+            }
+            else
+            {
+                S.getAllData(irreps, owner);
+                F.getAllData(irreps, owner);
+            }
+        }
+    }
 
-                int info;
-                vector<T> fock, ctsc(norb[i]*norb[i]);
-                vector<tkv_pair<T>> pairs(norb[i]*norb[i]);
-                vector<T> tmp(s);
+    for (int i = 0;i < nirrep;i++)
+    {
+        if (norb[i] == 0) continue;
 
-                F.getAllData(irreps, fock, 0);
-                assert(fock.size() == norb[i]*norb[i]);
-                //PROFILE_FLOPS(9*norb[i]*norb[i]*norb[i]);
-                info = hegv(AXBX, 'V', 'U', norb[i], fock.data(), norb[i], tmp.data(), norb[i], E.data());
-                assert(info == 0);
-                S.arena.comm().Bcast(E);
+        for (int spin : {0,1})
+        {
+            if ((2*i+spin)%arena.size != arena.rank) continue;
+
+            auto& E = (spin == 0 ? E_alpha[i] : E_beta[i]);
+            auto& C = fock[2*i+spin];
+            auto& tmp = s[2*i+spin];
+
+            //PROFILE_FLOPS(9*norb[i]*norb[i]*norb[i]);
+            int info = hegv(AXBX, 'V', 'U', norb[i], C.data(), norb[i], tmp.data(), norb[i], E.data());
+            assert(info == 0);
 
-                for (int j = 0;j < norb[i];j++)
+            for (int j = 0;j < norb[i];j++)
+            {
+                T sign = 0;
+                for (int k = 0;k < norb[i];k++)
                 {
-                    T sign = 0;
-                    for (int k = 0;k < norb[i];k++)
+                    if (aquarius::abs(C[k+j*norb[i]]) > 1e-10)
                     {
-                        if (aquarius::abs(fock[k+j*norb[i]]) > 1e-10)
-                        {
-                            sign = (fock[k+j*norb[i]] < 0 ? -1 : 1);
-                            break;
-                        }
+                        sign = (C[k+j*norb[i]] < 0 ? -1 : 1);
+                        break;
                     }
-                    //PROFILE_FLOPS(norb[i]);
-                    scal(norb[i], sign, &fock[j*norb[i]], 1);
                 }
+                //PROFILE_FLOPS(norb[i]);
+                scal(norb[i], sign, &C[j*norb[i]], 1);
+            }
+        }
+    }
+
+    for (int i = 0;i < nirrep;i++)
+    {
+        if (norb[i] == 0) continue;
+
+        vector<int> irreps(2,i);
+
+        for (int spin : {0,1})
+        {
+            auto& C = (spin == 0 ? Ca : Cb);
+            auto& E = (spin == 0 ? E_alpha[i] : E_beta[i]);
+            int owner = (2*i+spin)%arena.size;
+
+            if (arena.rank == owner)
+            {
+                vector<tkv_pair<T>> pairs(norb[i]*norb[i]);
 
                 for (int j = 0;j < norb[i]*norb[i];j++)
                 {
                     pairs[j].k = j;
-                    pairs[j].d = fock[j];
+                    pairs[j].d = fock[2*i+spin][j];
                 }
 
                 C.writeRemoteData(irreps, pairs);
             }
-        }
-        else
-        {
-            S.getAllData(irreps, 0);
-            Fa.getAllData(irreps, 0);
-            S.arena.comm().Bcast(E_alpha[i], 0);
-            Ca.writeRemoteData(irreps);
-            Fb.getAllData(irreps, 0);
-            S.arena.comm().Bcast(E_beta[i], 0);
-            Cb.writeRemoteData(irreps);
+            else
+            {
+                C.writeRemoteData(irreps);
+            }
+
+            arena.comm().Bcast(E, owner);
         }
     }
 }
@@ -0,0 +1,187 @@
+#include "checkpoint.hpp"
+
+namespace aquarius
+{
+namespace task
+{
+
+static const char magic[8] = {'A','Q','C','H','K','0','0','1'};
+
+/*
+ * MPI-IO takes an int count, so large records are moved in chunks
+ */
+static const int64_t max_chunk = 1<<30;
+
+Checkpoint::Checkpoint(const Arena& arena, const string& file, Mode mode)
+: arena(arena), file(file), mode(mode), offset(0)
+{
+    string name = (mode == WRITE ? file + ".tmp" : file);
+    int amode = (mode == WRITE ? MPI_MODE_WRONLY|MPI_MODE_CREATE : MPI_MODE_RDONLY);
+
+    if (MPI_File_open(MPI_Comm(arena.comm()), const_cast<char*>(name.c_str()),
+                      amode, MPI_INFO_NULL, &fh) != MPI_SUCCESS)
+        throw CheckpointError(name, "could not open file");
+
+    if (mode == WRITE)
+    {
+        MPI_File_set_size(fh, 0);
+        writeAllBytes(magic, sizeof(magic));
+        nwriters = arena.size;
+        writeAll(nwriters);
+    }
+    else
+    {
+        char m[sizeof(magic)];
+        readAllBytes(m, sizeof(magic));
+        if (!std::equal(m, m+sizeof(magic), magic))
+            throw CheckpointError(file, "not a checkpoint file");
+
+        readAll(nwriters);
+    }
+}
+
+Checkpoint::~Checkpoint()
+{
+    MPI_File_close(&fh);
+
+    if (mode == WRITE)
+    {
+        arena.comm().Barrier();
+        if (arena.rank == 0) std::rename((file + ".tmp").c_str(), file.c_str());
+        arena.comm().Barrier();
+    }
+}
+
+bool Checkpoint::exists(const Arena& arena, const string& file)
+{
+    int found = 0;
+    if (arena.rank == 0) found = ifstream(file).good();
+    arena.comm().Bcast(&found, 1, 0);
+    return found;
+}
+
+void Checkpoint::writeBytes(const void* data, int64_t nbytes)
+{
+    MPI_Comm comm = MPI_Comm(arena.comm());
+
+    int64_t before = 0, total, nchunk;
+    MPI_Exscan(&nbytes, &before, 1, MPI_INT64_T, MPI_SUM, comm);
+    if (arena.rank == 0) before = 0;
+    MPI_Allreduce(&nbytes, &total, 1, MPI_INT64_T, MPI_SUM, comm);
+
+    int64_t mychunk = (nbytes+max_chunk-1)/max_chunk;
+    MPI_Allreduce(&mychunk, &nchunk, 1, MPI_INT64_T, MPI_MAX, comm);
+
+    MPI_File_write_at_all(fh, offset+arena.rank*sizeof(int64_t), &nbytes, 1,
+                          MPI_INT64_T, MPI_STATUS_IGNORE);
+
+    MPI_Offset start = offset+arena.size*sizeof(int64_t)+before;
+    const char* p = static_cast<const char*>(data);
+    for (int64_t i = 0;i < nchunk;i++)
+    {
+        /*
+         * Ranks with fewer chunks still join the collective, with an empty
+         * read or write at the end of their (possibly empty) buffer
+         */
+        int64_t pos = min(i*max_chunk, nbytes);
+        int64_t n = min(max_chunk, nbytes-pos);
+        MPI_File_write_at_all(fh, start+i*max_chunk, const_cast<char*>(p+pos),
+                              n, MPI_BYTE, MPI_STATUS_IGNORE);
+    }
+
+    offset += arena.size*sizeof(int64_t)+total;
+}
+
+void Checkpoint::readBytes(vector<char>& data)
+{
+    if (nwriters != arena.size)
+        throw CheckpointError(file, "written with a different number of processes");
+
+    MPI_Comm comm = MPI_Comm(arena.comm());
+
+    int64_t nbytes;
+    MPI_File_read_at_all(fh, offset+arena.rank*sizeof(int64_t), &nbytes, 1,
+                         MPI_INT64_T, MPI_STATUS_IGNORE);
+
+    int64_t before = 0, total, nchunk;
+    MPI_Exscan(&nbytes, &before, 1, MPI_INT64_T, MPI_SUM, comm);
+    if (arena.rank == 0) before = 0;
+    MPI_Allreduce(&nbytes, &total, 1, MPI_INT64_T, MPI_SUM, comm);
+
+    int64_t mychunk = (nbytes+max_chunk-1)/max_chunk;
+    MPI_Allreduce(&mychunk, &nchunk, 1, MPI_INT64_T, MPI_MAX, comm);
+
+    data.resize(nbytes);
+
+    MPI_Offset start = offset+arena.size*sizeof(int64_t)+before;
+    for (int64_t i = 0;i < nchunk;i++)
+    {
+        int64_t pos = min(i*max_chunk, nbytes);
+        int64_t n = min(max_chunk, nbytes-pos);
+        MPI_File_read_at_all(fh, start+i*max_chunk, data.data()+pos,
+                             n, MPI_BYTE, MPI_STATUS_IGNORE);
+    }
+
+    offset += arena.size*sizeof(int64_t)+total;
+}
+
+void Checkpoint::readShareBytes(vector<char>& data, int64_t align)
+{
+    vector<int64_t> counts(nwriters);
+    readAllBytes(counts.data(), nwriters*sizeof(int64_t));
+
+    int64_t total = 0;
+    for (int64_t count : counts) total += count;
+    if (total%align != 0)
+        throw CheckpointError(file, "record size mismatch");
+
+    /*
+     * Split on element boundaries
+     */
+    int64_t nelem = total/align;
+    int64_t first = (nelem*arena.rank/arena.size)*align;
+    int64_t last = (nelem*(arena.rank+1)/arena.size)*align;
+    int64_t nbytes = last-first;
+
+    int64_t mychunk = (nbytes+max_chunk-1)/max_chunk, nchunk;
+    MPI_Allreduce(&mychunk, &nchunk, 1, MPI_INT64_T, MPI_MAX, MPI_Comm(arena.comm()));
+
+    data.resize(nbytes);
+
+    for (int64_t i = 0;i < nchunk;i++)
+    {
+        int64_t pos = min(i*max_chunk, nbytes);
+        int64_t n = min(max_chunk, nbytes-pos);
+        MPI_File_read_at_all(fh, offset+first+i*max_chunk, data.data()+pos,
+                             n, MPI_BYTE, MPI_STATUS_IGNORE);
+    }
+
+    offset += total;
+}
+
+void Checkpoint::writeAllBytes(const void* data, int64_t nbytes)
+{
+    for (int64_t i = 0;i < nbytes;i += max_chunk)
+    {
+        int64_t n = (arena.rank == 0 ? min(max_chunk, nbytes-i) : 0);
+        MPI_File_write_at_all(fh, offset+i, const_cast<char*>(static_cast<const char*>(data)+i),
+                              n, MPI_BYTE, MPI_STATUS_IGNORE);
+    }
+
+    offset += nbytes;
+}
+
+void Checkpoint::readAllBytes(void* data, int64_t nbytes)
+{
+    for (int64_t i = 0;i < nbytes;i += max_chunk)
+    {
+        int64_t n = min(max_chunk, nbytes-i);
+        MPI_File_read_at_all(fh, offset+i, static_cast<char*>(data)+i,
+                             n, MPI_BYTE, MPI_STATUS_IGNORE);
+    }
+
+    offset += nbytes;
+}
+
+}
+}
@@ -0,0 +1,134 @@
+#ifndef _AQUARIUS_TASK_CHECKPOINT_HPP_
+#define _AQUARIUS_TASK_CHECKPOINT_HPP_
+
+#include "util/global.hpp"
+
+namespace aquarius
+{
+namespace task
+{
+
+class CheckpointError : public runtime_error
+{
+    public:
+        CheckpointError(const string& file, const string& what_arg)
+        : runtime_error(file + ": " + what_arg) {}
+};
+
+/*
+ * A checkpoint file, written and read collectively with MPI-IO.
+ *
+ * Distributed records (write/read) are stored as the local data of each rank
+ * one after the other, preceded by the byte count of every rank, so that
+ * tensors can be saved in their native distribution without any gather.
+ * Reading such a record back with read requires the same number of
+ * processes, while readShare gives each process an even share of the
+ * concatenated data for any number of processes.
+ *
+ * Replicated records (writeAll/readAll) hold data which is the same on
+ * every rank; it is written by rank 0 and read by everybody.
+ *
+ * Files are written to a temporary name and renamed when closed, so that an
+ * interrupted write never replaces a good checkpoint.
+ */
+class Checkpoint
+{
+    public:
+        enum Mode {READ, WRITE};
+
+    protected:
+        Arena arena;
+        string file;
+        Mode mode;
+        MPI_File fh;
+        MPI_Offset offset;
+        int64_t nwriters;
+
+        Checkpoint(const Checkpoint& other);
+
+        Checkpoint& operator=(const Checkpoint& other);
+
+        void writeBytes(const void* data, int64_t nbytes);
+
+        void readBytes(vector<char>& data);
+
+        void readShareBytes(vector<char>& data, int64_t align);
+
+        void writeAllBytes(const void* data, int64_t nbytes);
+
+        void readAllBytes(void* data, int64_t nbytes);
+
+    public:
+        Checkpoint(const Arena& arena, const string& file, Mode mode);
+
+        ~Checkpoint();
+
+        static bool exists(const Arena& arena, const string& file);
+
+        template <typename T>
+        void write(const vector<T>& data)
+        {
+            writeBytes(data.data(), data.size()*sizeof(T));
+        }
+
+        template <typename T>
+        void read(vector<T>& data)
+        {
+            vector<char> bytes;
+            readBytes(bytes);
+            if (bytes.size()%sizeof(T) != 0)
+                throw CheckpointError(file, "record size mismatch");
+            data.resize(bytes.size()/sizeof(T));
+            copy(bytes.begin(), bytes.end(), reinterpret_cast<char*>(data.data()));
+        }
+
+        template <typename T>
+        void readShare(vector<T>& data)
+        {
+            vector<char> bytes;
+            readShareBytes(bytes, sizeof(T));
+            data.resize(bytes.size()/sizeof(T));
+            copy(bytes.begin(), bytes.end(), reinterpret_cast<char*>(data.data()));
+        }
+
+        template <typename T>
+        void writeAll(const T& data)
+        {
+            writeAllBytes(&data, sizeof(T));
+        }
+
+        template <typename T>
+        void writeAll(const vector<T>& data)
+        {
+            writeAll<int64_t>(data.size());
+            writeAllBytes(data.data(), data.size()*sizeof(T));
+        }
+
+        template <typename T>
+        void readAll(T& data)
+        {
+            readAllBytes(&data, sizeof(T));
+        }
+
+        template <typename T>
+        void readAll(vector<T>& data)
+        {
+            int64_t n;
+            readAll(n);
+            data.resize(n);
+            readAllBytes(data.data(), n*sizeof(T));
+        }
+
+        template <typename T>
+        T readAll()
+        {
+            T data;
+            readAll(data);
+            return data;
+        }
+};
+
+}
+}
+
+#endif
@@ -1,5 +1,11 @@
 #include "task.hpp"
 
+#include <sys/resource.h>
+
+#include "util/memory.hpp"
+
+#include "threads.hpp"
+
 using namespace aquarius::time;
 using namespace aquarius::input;
 
@@ -121,8 +127,10 @@ Requirement::Requirement(const string& type, const string& name)
 
 void Requirement::fulfil(const Product& product)
 {
+    if (this->product) --*this->product->consumers;
     this->product.set(new Product(product));
     *this->product->used = true;
+    ++*this->product->consumers;
 }
 
 bool Requirement::exists() const
@@ -138,10 +146,29 @@ Product& Requirement::get()
 }
 
 Product::Product(const string& type, const string& name)
-: type(type), name(name), requirements(new vector<Requirement>()), used(new bool(false)) {}
+: type(type), name(name), requirements(new vector<Requirement>()),
+  retained(new vector<Product>()), used(new bool(false)), consumers(new int(0)) {}
 
 Product::Product(const string& type, const string& name, const vector<Requirement>& reqs)
-: type(type), name(name), requirements(new vector<Requirement>(reqs)), used(new bool(false)) {}
+: type(type), name(name), requirements(new vector<Requirement>(reqs)),
+  retained(new vector<Product>()), used(new bool(false)), consumers(new int(0)) {}
+
+void Product::retain(const Product& other)
+{
+    retained->push_back(other);
+    ++*other.consumers;
+}
+
+void Product::release()
+{
+    assert(*consumers > 0);
+    if (--*consumers > 0) return;
+
+    data.set(NULL);
+
+    for (Product& p : *retained) p.release();
+    retained->clear();
+}
 
 void Product::addRequirement(Requirement&& req)
 {
@@ -242,13 +269,60 @@ void TaskDAG::parseTasks(const string& context, Config& input)
     }
 }
 
+/*
+ * 64-bit FNV-1a, which (unlike std::hash) gives the same checkpoint file
+ * names with every compiler and standard library
+ */
+static uint64_t fnv1a(const string& text)
+{
+    uint64_t h = 0xcbf29ce484222325ull;
+    for (unsigned char c : text)
+    {
+        h ^= c;
+        h *= 0x100000001b3ull;
+    }
+    return h;
+}
+
 TaskDAG::TaskDAG(const string& file)
+: input_file(file), checkpoint_iterations(1), checkpoint_seconds(0), retune_threads(false)
 {
     ifstream ifs(file);
-    Config input(ifs);
+    string text((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+    input_hash = str("%016llx", (unsigned long long)fnv1a(text));
+
+    istringstream iss(text);
+    Config input(iss);
     parseTasks("", input);
 }
 
+void TaskDAG::setCheckpointInterval(const string& interval)
+{
+    istringstream iss(interval);
+    double n;
+    string unit;
+
+    if (!(iss >> n) || n <= 0 || (iss >> unit && unit != "s") || !iss.eof())
+        throw runtime_error("Invalid checkpoint interval: " + interval);
+
+    if (unit == "s")
+    {
+        checkpoint_seconds = n;
+    }
+    else
+    {
+        if (n != (int)n) throw runtime_error("Invalid checkpoint interval: " + interval);
+        checkpoint_iterations = (int)n;
+        checkpoint_seconds = 0;
+    }
+}
+
+string TaskDAG::getCheckpointFile(const string& task) const
+{
+    if (checkpoint_dir.empty()) return "";
+    return checkpoint_dir + "/" + input_hash + "." + task + ".chk";
+}
+
 Task& TaskDAG::addTask(const Arena& arena, const string& type, const string& context, Config& config)
 {
     string name;
@@ -492,10 +566,66 @@ void TaskDAG::satisfyExplicitRequirements(const Arena& world)
     }
 }
 
+/*
+ * Bytes in MB, maximized over all ranks
+ */
+static double megabytes(const Arena& arena, int64_t bytes)
+{
+    arena.comm().Allreduce(&bytes, 1, MPI_MAX);
+    return bytes/1048576.0;
+}
+
+/*
+ * High-water mark of the resident set size in MB, maximized over all ranks
+ */
+static double peakMemory(const Arena& arena)
+{
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return megabytes(arena, int64_t(usage.ru_maxrss)*1024);
+}
+
+string jsonString(const string& s)
+{
+    string quoted = "\"";
+    for (char c : s)
+    {
+        if (c == '"' || c == '\\')
+        {
+            quoted += '\\';
+            quoted += c;
+        }
+        else if ((unsigned char)c < 0x20)
+        {
+            quoted += str("\\u%04x", (int)c);
+        }
+        else
+        {
+            quoted += c;
+        }
+    }
+    return quoted + "\"";
+}
+
 void TaskDAG::execute(const Arena& world)
 {
     satisfyExplicitRequirements(world);
 
+    vector<string> report;
+
+    unique_ptr<ThreadProfile> threads;
+    if (!thread_profile.empty())
+    {
+        threads.reset(new ThreadProfile(world));
+        if (retune_threads || !threads->load(world, thread_profile))
+        {
+            Logger::log(world) << "Benchmarking thread counts for " << thread_profile << endl;
+            threads->tune(world);
+            threads->save(world, thread_profile);
+        }
+        threads->print(Logger::log(world));
+    }
+
     //TODO: check for cycles
 
     /*
@@ -527,12 +657,39 @@ void TaskDAG::execute(const Arena& world)
                 ran_something = true;
 
                 Logger::log(world) << "Starting task: " << t.getName() << endl;
+
+                string name = t.getName();
+                string type = t.getType();
+
+                if (threads)
+                {
+                    int nthread = threads->getNumThreads(type);
+                    threads->apply(nthread);
+                    Logger::log(world) << "Task: " << name << " using " << nthread <<
+                               " thread" << (nthread > 1 ? "s" : "") << endl;
+                }
+
+                int64_t estimate = t.getMemoryEstimate(world);
+                if (estimate > 0)
+                {
+                    int64_t available = Memory::available(world);
+                    if (estimate > available)
+                        Logger::warn(world) << "Task " << name << " is estimated to need " <<
+                                   estimate/1048576 << " MB per process, but only " <<
+                                   available/1048576 << " MB are available" << endl;
+                }
+
                 Timer timer;
 
                 bool success = true;
                 bool done = false;
                 string error;
 
+                Memory::resetPeak();
+
+                double rss_before = (report_file.empty() ? 0 : peakMemory(world));
+
+                TRACE_TASK(name);
                 timer.start();
                 //try
                 //{
@@ -544,12 +701,14 @@ void TaskDAG::execute(const Arena& world)
                 //    error = e.what();
                 //}
                 timer.stop();
+                TRACE_TASK("");
 
                 double dt = timer.seconds(world);
                 double gflops = timer.gflops(world);
-                Logger::log(world) << "Finished task: " << t.getName() <<
+                double peak = megabytes(world, Memory::peak());
+                Logger::log(world) << "Finished task: " << name <<
                            " in " << fixed << setprecision(3) << dt << " s" << endl;
-                Logger::log(world) << "Task: " << t.getName() <<
+                Logger::log(world) << "Task: " << name <<
                            " achieved " << fixed << setprecision(3) << gflops << " Gflops/sec" << endl;
 
                 if (!success)
@@ -563,16 +722,52 @@ void TaskDAG::execute(const Arena& world)
                     {
                         if (p.isUsed() && !p.exists())
                             Logger::error(world) << "Product " << p.getName() <<
-                                                    " of task " << t.getName() <<
+                                                    " of task " << name <<
                                                     " was not successfully produced" << endl;
                     }
 
+                    /*
+                     * Copies of a requirement share the fulfilling product,
+                     * so release each one only once
+                     */
+                    set<Product*> inputs;
+                    for (Product& p : t.getProducts())
+                    {
+                        for (Requirement& r : p.getRequirements())
+                        {
+                            inputs.insert(&r.get());
+                        }
+                    }
+
+                    for (Product* p : inputs) p->release();
+
                     i = tasks.perase(i);
                 }
                 else
                 {
                     ++i;
                 }
+
+                double held = megabytes(world, Memory::current());
+                Logger::log(world) << "Task: " << name << " used " << fixed << setprecision(1) <<
+                           peak << " MB of tensor storage at peak, " << held <<
+                           " MB is still held" << endl;
+
+                if (!report_file.empty())
+                {
+                    /*
+                     * The resident set high-water mark can't be reset, so
+                     * a task's own footprint is how much it raised it
+                     */
+                    double rss = peakMemory(world);
+                    report.push_back(str("    {\"name\": %s, \"type\": %s, \"threads\": %d, "
+                                         "\"seconds\": %.6f, \"gflops\": %.6f, "
+                                         "\"process_peak_memory_mb\": %.1f, "
+                                         "\"peak_memory_increase_mb\": %.1f, "
+                                         "\"peak_tensor_mb\": %.1f, \"held_tensor_mb\": %.1f}",
+                                         jsonString(name).c_str(), jsonString(type).c_str(),
+                                         omp_get_max_threads(), dt, gflops, rss, rss-rss_before, peak, held));
+                }
             }
             else
             {
@@ -585,16 +780,42 @@ void TaskDAG::execute(const Arena& world)
             Logger::error(world) << "Some tasks were not executed due to missing dependencies" << endl;
         }
     }
+
+    if (!report_file.empty() && world.rank == 0)
+    {
+        ofstream ofs(report_file);
+        ofs << "{" << endl;
+        ofs << "  \"input\": " << jsonString(input_file) << "," << endl;
+        ofs << "  \"input_hash\": " << jsonString(input_hash) << "," << endl;
+        ofs << "  \"processes\": " << world.size << "," << endl;
+        ofs << "  \"threads\": " << omp_get_max_threads() << "," << endl;
+        ofs << "  \"tasks\":" << endl;
+        ofs << "  [" << endl;
+        for (int i = 0;i < report.size();i++)
+        {
+            ofs << report[i] << (i+1 < report.size() ? "," : "") << endl;
+        }
+        ofs << "  ]" << endl;
+        ofs << "}" << endl;
+
+        if (!ofs)
+            Logger::warn(world) << "Could not write report file " << report_file << endl;
+    }
 }
 
 CompareScalars::CompareScalars(const string& name, Config& config)
-: Task(name, config)
+: Task(name, config), shifted(false)
 {
     tolerance = config.get<double>("tolerance");
+    relation = config.get<string>("relation");
+
+    for (auto& u : config.find<string>("using"))
+        if (u.second == "shift") shifted = true;
 
     vector<Requirement> reqs;
     reqs.push_back(Requirement("double", "val1"));
     reqs.push_back(Requirement("double", "val2"));
+    if (shifted) reqs.push_back(Requirement("double", "shift"));
     addProduct(Product("bool", "match", reqs));
 }
 
@@ -602,8 +823,9 @@ bool CompareScalars::run(TaskDAG& dag, const Arena& arena)
 {
     double val1 = get<double>("val1");
     double val2 = get<double>("val2");
+    if (shifted) val1 += get<double>("shift");
 
-    bool match = aquarius::abs(val1-val2) < tolerance;
+    bool match = (relation == "less" ? val1 < val2 : aquarius::abs(val1-val2) < tolerance);
 
     if (match)
     {
@@ -611,8 +833,9 @@ bool CompareScalars::run(TaskDAG& dag, const Arena& arena)
     }
     else
     {
-        error(arena) << "failed: " << fixed <<
-                setprecision((int)(0.5-log10(tolerance))) << val1 << " vs " << val2 << endl;
+        int prec = (tolerance > 0 ? (int)(0.5-log10(tolerance)) : 12);
+        error(arena) << "failed: " << fixed << setprecision(prec) << val1 <<
+                (relation == "less" ? " >= " : " vs ") << val2 << endl;
     }
 
     put("match", new bool(match));
@@ -620,7 +843,7 @@ bool CompareScalars::run(TaskDAG& dag, const Arena& arena)
     return true;
 }
 
-REGISTER_TASK(CompareScalars,"compare","tolerance double");
+REGISTER_TASK(CompareScalars,"compare","tolerance? double 0.0, relation? enum { equal, less }");
 
 }
 }
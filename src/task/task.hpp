@@ -11,6 +11,12 @@ namespace aquarius
 namespace task
 {
 
+/*
+ * s as a quoted JSON string, with quotes, backslashes and control
+ * characters escaped
+ */
+string jsonString(const string& s);
+
 class Logger
 {
     protected:
@@ -160,7 +166,9 @@ class Product
         string name;
         global_ptr<Destructible> data;
         shared_ptr<vector<Requirement>> requirements;
+        shared_ptr<vector<Product>> retained;
         shared_ptr<bool> used;
+        shared_ptr<int> consumers;
 
     public:
         Product(const string& type, const string& name);
@@ -200,6 +208,19 @@ class Product
         void addRequirements(vector<Requirement>&& reqs);
 
         vector<Requirement>& getRequirements() { return *requirements; }
+
+        /*
+         * Keep the data of other alive for as long as this product exists,
+         * e.g. when this product shares storage with it
+         */
+        void retain(const Product& other);
+
+        /*
+         * Signal that one of the requirements or retaining products which use
+         * this product is finished with it; the data is freed once all of
+         * them are
+         */
+        void release();
 };
 
 class TaskDAG;
@@ -260,6 +281,18 @@ class Task
             throw logic_error("Temporary " + name + " not found on task " + this->name);
         }
 
+        void freetmp(const string& name)
+        {
+            for (vector<Product>::iterator i = temporaries.begin();i != temporaries.end();++i)
+            {
+                if (i->getName() == name)
+                {
+                    temporaries.erase(i);
+                    return;
+                }
+            }
+        }
+
         ostream& log(const Arena& arena);
 
         ostream& warn(const Arena& arena);
@@ -329,6 +362,12 @@ class Task
 
         virtual bool run(TaskDAG& dag, const Arena& arena) = 0;
 
+        /*
+         * Estimate of the tensor storage in bytes per process which run will
+         * allocate, given that the requirements exist; zero if unknown
+         */
+        virtual int64_t getMemoryEstimate(const Arena& arena) { return 0; }
+
         static unique_ptr<Task> createTask(const string& type, const string& name, input::Config& config);
 };
 
@@ -355,13 +394,22 @@ class TaskDAG
     protected:
         unique_list<Task> tasks;
         vector<tuple<string,string,input::Config>> usings;
+        string input_file;
+        string input_hash;
+        string checkpoint_dir;
+        int checkpoint_iterations;
+        double checkpoint_seconds;
+        string report_file;
+        string thread_profile;
+        bool retune_threads;
 
         void parseTasks(const string& context, input::Config& config);
 
         void satisfyExplicitRequirements(const Arena& world);
 
     public:
-        TaskDAG() {}
+        TaskDAG()
+        : checkpoint_iterations(1), checkpoint_seconds(0), retune_threads(false) {}
 
         TaskDAG(const string& file);
 
@@ -370,12 +418,66 @@ class TaskDAG
         Task& addTask(const Arena& arena, unique_ptr<Task>&& task);
 
         void execute(const Arena& world);
+
+        /*
+         * Enable checkpointing of iterative tasks to files in dir
+         */
+        void setCheckpointDirectory(const string& dir) { checkpoint_dir = dir; }
+
+        /*
+         * Write checkpoints only every n iterations (e.g. "10") or every n
+         * seconds of wall time (e.g. "600s") instead of after every
+         * iteration. The last iteration of a task is always written.
+         */
+        void setCheckpointInterval(const string& interval);
+
+        /*
+         * Whether a checkpoint is due after niter iterations taking a total
+         * of seconds since the last one
+         */
+        bool isCheckpointDue(int niter, double seconds) const
+        {
+            if (checkpoint_seconds > 0) return seconds >= checkpoint_seconds;
+            return niter >= checkpoint_iterations;
+        }
+
+        /*
+         * The checkpoint file for the named task, keyed on a (64-bit FNV-1a)
+         * hash of the input so that a changed input never picks up stale
+         * data, or an empty string if checkpointing is disabled
+         */
+        string getCheckpointFile(const string& task) const;
+
+        /*
+         * Write the wall time, flop rate, and peak memory of every task to
+         * file in JSON format when execution finishes
+         */
+        void setReportFile(const string& file) { report_file = file; }
+
+        /*
+         * Choose the number of threads for each task from the profile in
+         * file, which is created by benchmarking if it does not exist yet
+         * or if retune is true
+         */
+        void setThreadProfile(const string& file, bool retune = false)
+        {
+            thread_profile = file;
+            retune_threads = retune;
+        }
 };
 
+/*
+ * Check that val1 equals val2 to within tolerance or, with relation less,
+ * that val1 < val2 (e.g. to compare iteration counts). An optional
+ * "using shift from ..." is added to val1 first, e.g. to check that a
+ * truncated energy plus its correction reproduces the full one
+ */
 class CompareScalars : public Task
 {
     protected:
         double tolerance;
+        string relation;
+        bool shifted;
 
     public:
         CompareScalars(const string& name, input::Config& config);
@@ -0,0 +1,284 @@
+#include "threads.hpp"
+
+#include <sched.h>
+#include <unistd.h>
+
+#include "tensor/ctf_tensor.hpp"
+#include "time/time.hpp"
+
+#include "task.hpp"
+
+using namespace aquarius::tensor;
+using namespace aquarius::time;
+
+namespace aquarius
+{
+namespace task
+{
+
+/*
+ * Parse a Linux CPU list such as "0-7,16-23"
+ */
+static vector<int> parseCPUList(const string& list)
+{
+    vector<int> cpus;
+    istringstream iss(list);
+    string range;
+    while (getline(iss, range, ','))
+    {
+        if (range.empty()) continue;
+        size_t dash = range.find('-');
+        int first = std::stoi(range.substr(0, dash));
+        int last = (dash == string::npos ? first : std::stoi(range.substr(dash+1)));
+        for (int cpu = first;cpu <= last;cpu++) cpus.push_back(cpu);
+    }
+    return cpus;
+}
+
+ThreadProfile::ThreadProfile(const Arena& arena)
+{
+    cpu_set_t mask;
+    CPU_ZERO(&mask);
+    sched_getaffinity(0, sizeof(mask), &mask);
+
+    /*
+     * Order the cores of this process by NUMA domain, so that a contiguous
+     * range of them stays within as few domains as possible
+     */
+    vector<int> ordered;
+    for (int node = 0;;node++)
+    {
+        ifstream ifs("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+        string list;
+        if (!getline(ifs, list)) break;
+
+        for (int cpu : parseCPUList(list))
+            if (CPU_ISSET(cpu, &mask)) ordered.push_back(cpu);
+    }
+    for (int cpu = 0;cpu < CPU_SETSIZE;cpu++)
+    {
+        if (CPU_ISSET(cpu, &mask) && std::find(ordered.begin(), ordered.end(), cpu) == ordered.end())
+            ordered.push_back(cpu);
+    }
+
+    Intracomm node = arena.comm().split_type(MPI_COMM_TYPE_SHARED, arena.rank);
+    int nlocal = node.size;
+    int local = node.rank;
+
+    /*
+     * If the launcher did not bind the processes, each one may use every
+     * core of the node, so split them evenly among the processes instead
+     */
+    if (ordered.size() == (size_t)sysconf(_SC_NPROCESSORS_ONLN) && nlocal > 1)
+    {
+        int per = ordered.size()/nlocal;
+        if (per == 0)
+        {
+            cpus.push_back(ordered[local%ordered.size()]);
+        }
+        else
+        {
+            cpus.assign(ordered.begin()+local*per, ordered.begin()+(local+1)*per);
+        }
+    }
+    else
+    {
+        cpus = ordered;
+    }
+
+    if (cpus.empty()) cpus.push_back(sched_getcpu());
+
+    max_threads = cpus.size();
+    if (getenv("OMP_NUM_THREADS") != NULL)
+    {
+        max_threads = max(1, atoi(getenv("OMP_NUM_THREADS")));
+    }
+    arena.comm().Allreduce(&max_threads, 1, MPI_MIN);
+}
+
+bool ThreadProfile::isLoopTask(const string& type)
+{
+    static const set<string> loop_tasks =
+    {
+        "1eints", "2eints", "libint2eints",
+        "localaoscf", "elementalaoscf",
+        "localcholeskyuhf", "elementalcholeskyuhf"
+    };
+
+    return loop_tasks.count(type);
+}
+
+/*
+ * Stand-in for a batch of integrals: a dynamically scheduled loop over
+ * items of uneven cost, as for shell quartets of mixed angular momenta
+ */
+double ThreadProfile::benchmarkLoop(const Arena& arena)
+{
+    Timer timer;
+    timer.start();
+
+    double total = 0;
+    #pragma omp parallel for schedule(dynamic), reduction(+:total)
+    for (int i = 0;i < 20000;i++)
+    {
+        int len = 64+(i*7919)%1984;
+        for (int j = 0;j < len;j++) total += exp(-1e-3*j)*sqrt((double)(i+j));
+    }
+
+    timer.stop();
+
+    /*
+     * Use the result, so that the loop is not optimized away
+     */
+    if (total < 0) Logger::log(arena) << total << endl;
+
+    return timer.seconds(arena);
+}
+
+/*
+ * Stand-in for a CC task: a distributed four-index contraction of the same
+ * shape as a particle-particle ladder
+ */
+double ThreadProfile::benchmarkContraction(const Arena& arena)
+{
+    const int n = 32;
+
+    CTFTensor<double> A("A", arena, 4, {n,n,n,n}, {NS,NS,NS,NS}, true);
+    CTFTensor<double> B("B", arena, 4, {n,n,n,n}, {NS,NS,NS,NS}, true);
+    CTFTensor<double> C("C", arena, 4, {n,n,n,n}, {NS,NS,NS,NS}, true);
+
+    A.sum(1.0, 0.0);
+    B.sum(1.0, 0.0);
+
+    Timer timer;
+    timer.start();
+    for (int i = 0;i < 3;i++)
+    {
+        C.mult(1.0, false, A, "abef", false, B, "efij", 0.0, "abij");
+    }
+    timer.stop();
+
+    return timer.seconds(arena);
+}
+
+int ThreadProfile::fastest(const Arena& arena, double (*benchmark)(const Arena&))
+{
+    vector<int> counts;
+    for (int n = 1;n < max_threads;n *= 2) counts.push_back(n);
+    counts.push_back(max_threads);
+
+    int best = 1;
+    double best_time = numeric_limits<double>::max();
+
+    for (int n : counts)
+    {
+        apply(n);
+
+        /*
+         * Run once to warm up the thread pool and any CTF mappings
+         */
+        benchmark(arena);
+        double dt = benchmark(arena);
+
+        if (dt < best_time)
+        {
+            best = n;
+            best_time = dt;
+        }
+    }
+
+    return best;
+}
+
+bool ThreadProfile::load(const Arena& arena, const string& file)
+{
+    vector<char> text;
+    int len = -1;
+
+    if (arena.rank == 0)
+    {
+        ifstream ifs(file);
+        if (ifs)
+        {
+            text.assign(istreambuf_iterator<char>(ifs), istreambuf_iterator<char>());
+            len = text.size();
+        }
+    }
+
+    arena.comm().Bcast(&len, 1, 0);
+    if (len < 0) return false;
+
+    text.resize(len);
+    arena.comm().Bcast(text, 0);
+
+    threads.clear();
+    istringstream iss(string(text.begin(), text.end()));
+    string key;
+    int n;
+    while (iss >> key >> n)
+    {
+        if (n < 1) throw runtime_error(file + ": invalid thread count for " + key);
+        threads[key] = n;
+    }
+
+    return !threads.empty();
+}
+
+void ThreadProfile::save(const Arena& arena, const string& file) const
+{
+    if (arena.rank != 0) return;
+
+    ofstream ofs(file);
+    for (auto& t : threads) ofs << t.first << " " << t.second << endl;
+
+    if (!ofs) Logger::warn(arena) << "Could not write thread profile " << file << endl;
+}
+
+void ThreadProfile::tune(const Arena& arena)
+{
+    threads["loop"] = fastest(arena, benchmarkLoop);
+    threads["contraction"] = fastest(arena, benchmarkContraction);
+}
+
+int ThreadProfile::getNumThreads(const string& type) const
+{
+    auto it = threads.find(type);
+    if (it == threads.end()) it = threads.find(isLoopTask(type) ? "loop" : "contraction");
+    if (it == threads.end()) return max_threads;
+    return it->second;
+}
+
+void ThreadProfile::apply(int nthread) const
+{
+    omp_set_num_threads(nthread);
+
+    /*
+     * Every thread of the team is pinned, the master thread to cpus[0], so
+     * that no two threads share a core. Serial code between parallel regions
+     * also runs on cpus[0], which no other thread is using at that point.
+     */
+    #pragma omp parallel
+    {
+        cpu_set_t mask;
+        CPU_ZERO(&mask);
+        CPU_SET(cpus[omp_get_thread_num()%cpus.size()], &mask);
+        sched_setaffinity(0, sizeof(mask), &mask);
+    }
+}
+
+void ThreadProfile::print(ostream& os) const
+{
+    os << "Thread profile: up to " << max_threads << " thread" << (max_threads > 1 ? "s" : "") <<
+          " per process on cores";
+    for (int cpu : cpus) os << " " << cpu;
+    os << endl;
+
+    for (auto& t : threads)
+    {
+        os << "Thread profile: " << t.first << " tasks use " << t.second << " thread" <<
+              (t.second > 1 ? "s" : "") << endl;
+    }
+}
+
+}
+}
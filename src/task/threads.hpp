@@ -0,0 +1,71 @@
+#ifndef _AQUARIUS_TASK_THREADS_HPP_
+#define _AQUARIUS_TASK_THREADS_HPP_
+
+#include "util/global.hpp"
+
+namespace aquarius
+{
+namespace task
+{
+
+/*
+ * Number of OpenMP threads to use for each task.
+ *
+ * Tasks are divided into those dominated by their own threaded loops
+ * (integrals and local SCF) and those dominated by distributed tensor
+ * contractions. The best thread count for each kind is either measured with
+ * a short benchmark of the same kind, or read from a profile saved by an
+ * earlier run. The profile has one "<kind or task type> <threads>" entry per
+ * line, so that a single task type may also be given its own count by hand.
+ *
+ * Threads are pinned to the cores available to each process, where the
+ * cores of a node are split evenly among its processes (unless the launcher
+ * has already bound them) and ordered so that each process fills one NUMA
+ * domain before moving on to the next.
+ */
+class ThreadProfile
+{
+    protected:
+        int max_threads;
+        vector<int> cpus;
+        map<string,int> threads;
+
+        static bool isLoopTask(const string& type);
+
+        static double benchmarkLoop(const Arena& arena);
+
+        static double benchmarkContraction(const Arena& arena);
+
+        int fastest(const Arena& arena, double (*benchmark)(const Arena&));
+
+    public:
+        ThreadProfile(const Arena& arena);
+
+        /*
+         * Read the profile in file, returning false if it cannot be read
+         */
+        bool load(const Arena& arena, const string& file);
+
+        void save(const Arena& arena, const string& file) const;
+
+        /*
+         * Benchmark each kind of task at every thread count from 1 up to
+         * the number of cores of this process
+         */
+        void tune(const Arena& arena);
+
+        int getNumThreads(const string& type) const;
+
+        /*
+         * Set the number of OpenMP threads and pin thread i (including the
+         * master thread) to cpus[i]
+         */
+        void apply(int nthread) const;
+
+        void print(ostream& os) const;
+};
+
+}
+}
+
+#endif
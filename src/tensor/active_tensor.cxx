@@ -0,0 +1,642 @@
+#include "active_tensor.hpp"
+
+using namespace aquarius::op;
+using namespace aquarius::autocc;
+using namespace aquarius::task;
+using namespace aquarius::symmetry;
+
+namespace aquarius
+{
+namespace tensor
+{
+
+static vector<int> count(const vector<vector<bool>>& act, bool isactive)
+{
+    vector<int> n(act.size(), 0);
+    for (int h = 0;h < act.size();h++)
+    {
+        for (int p = 0;p < act[h].size();p++)
+        {
+            if (act[h][p] == isactive) n[h]++;
+        }
+    }
+    return n;
+}
+
+template<class T>
+SpacePartition<T>::SpacePartition(const Arena& arena, const Space& full,
+                                  const vector<vector<bool>>& acta,
+                                  const vector<vector<bool>>& actb)
+: Distributed(arena), full(full),
+  active(full.group, count(acta, true), count(actb, true)),
+  inactive(full.group, count(acta, false), count(actb, false))
+{
+    const PointGroup& group = full.group;
+    int nirrep = group.getNumIrreps();
+
+    for (int isactive = 0;isactive < 2;isactive++)
+    {
+        for (int alpha = 0;alpha < 2;alpha++)
+        {
+            const vector<vector<bool>>& act = (alpha ? acta : actb);
+            const vector<int>& n = (alpha ? full.nalpha : full.nbeta);
+            const Space& sub = (isactive ? active : inactive);
+            const vector<int>& nsub = (alpha ? sub.nalpha : sub.nbeta);
+
+            assert(act.size() == nirrep);
+
+            orbitals[isactive][alpha].resize(nirrep);
+            for (int h = 0;h < nirrep;h++)
+            {
+                assert(act[h].size() == n[h]);
+                for (int p = 0;p < n[h];p++)
+                {
+                    if (act[h][p] == (bool)isactive) orbitals[isactive][alpha][h].push_back(p);
+                }
+            }
+
+            if (aquarius::sum(nsub) == 0) continue;
+
+            P[isactive][alpha].reset(new SymmetryBlockedTensor<T>("P", arena, group, 2, {n, nsub}, {NS,NS}));
+
+            for (int h = 0;h < nirrep;h++)
+            {
+                if (arena.rank == 0)
+                {
+                    vector<tkv_pair<T>> buf;
+                    for (int q = 0;q < nsub[h];q++)
+                    {
+                        buf.emplace_back(orbitals[isactive][alpha][h][q] + n[h]*q, (T)1);
+                    }
+                    P[isactive][alpha]->writeRemoteData({h,h}, buf);
+                }
+                else
+                {
+                    P[isactive][alpha]->writeRemoteData({h,h});
+                }
+            }
+        }
+    }
+}
+
+template<class T>
+const SymmetryBlockedTensor<T>* SpacePartition<T>::selection(bool isactive, bool alpha) const
+{
+    return P[isactive][alpha].get();
+}
+
+template<class T>
+vector<vector<T>> SpacePartition<T>::select(const vector<vector<T>>& d, bool isactive, bool alpha) const
+{
+    const vector<vector<int>>& orbs = orbitals[isactive][alpha];
+
+    vector<vector<T>> sub(orbs.size());
+    for (int h = 0;h < orbs.size();h++)
+    {
+        for (int p : orbs[h]) sub[h].push_back(d[h][p]);
+    }
+
+    return sub;
+}
+
+template<class T>
+map<const tCTF_World<T>*,map<const PointGroup*,pair<int,ActiveSpaceTensor<T>*>>> ActiveSpaceTensor<T>::scalars;
+
+template<class T>
+ActiveSpaceTensor<T>::ActiveSpaceTensor(const string& name, const ActiveSpaceTensor<T>& t, const T val)
+: IndexableCompositeTensor<ActiveSpaceTensor<T>,SpinorbitalTensor<T>,T>(name, 0, 0),
+  Distributed(t.arena), group(t.group)
+{
+    cases.push_back(ActiveCase());
+    cases.back().tensor = new SpinorbitalTensor<T>(name, arena, group, vector<Space>(), vector<int>(), vector<int>());
+    *cases.back().tensor = val;
+    addTensor(cases.back().tensor);
+    register_scalar();
+}
+
+template<class T>
+ActiveSpaceTensor<T>::ActiveSpaceTensor(const ActiveSpaceTensor<T>& other)
+: IndexableCompositeTensor<ActiveSpaceTensor<T>,SpinorbitalTensor<T>,T>(other),
+  Distributed(other.arena), group(other.group), parts(other.parts),
+  nout(other.nout), nin(other.nin), cases(other.cases)
+{
+    assert(tensors.size() == cases.size());
+    for (int i = 0;i < tensors.size();i++)
+    {
+        cases[i].tensor = tensors[i].tensor;
+    }
+    register_scalar();
+}
+
+template<class T>
+ActiveSpaceTensor<T>::ActiveSpaceTensor(const string& name, const ActiveSpaceTensor<T>& other)
+: IndexableCompositeTensor<ActiveSpaceTensor<T>,SpinorbitalTensor<T>,T>(name, other),
+  Distributed(other.arena), group(other.group), parts(other.parts),
+  nout(other.nout), nin(other.nin), cases(other.cases)
+{
+    assert(tensors.size() == cases.size());
+    for (int i = 0;i < tensors.size();i++)
+    {
+        cases[i].tensor = tensors[i].tensor;
+    }
+    register_scalar();
+}
+
+template<class T>
+ActiveSpaceTensor<T>::ActiveSpaceTensor(const string& name, const Arena& arena,
+                                        const PointGroup& group,
+                                        const vector<const SpacePartition<T>*>& parts,
+                                        const vector<int>& nout,
+                                        const vector<int>& nin,
+                                        const vector<int>& minout_,
+                                        const vector<int>& minin_)
+: IndexableCompositeTensor<ActiveSpaceTensor<T>,SpinorbitalTensor<T>,T>(name, aquarius::sum(nout)+aquarius::sum(nin), 0),
+  Distributed(arena), group(group), parts(parts), nout(nout), nin(nin)
+{
+    int nspaces = parts.size();
+    vector<int> minout(minout_), minin(minin_);
+    if (minout.empty()) minout.assign(nspaces, 0);
+    if (minin.empty()) minin.assign(nspaces, 0);
+
+    assert(nout.size() == nspaces && nin.size() == nspaces);
+    assert(minout.size() == nspaces && minin.size() == nspaces);
+
+    vector<Space> leaf_spaces = subspaces();
+    vector<int> active_out(minout), active_in(minin);
+    vector<int> leaf_out(2*nspaces), leaf_in(2*nspaces);
+
+    auto empty = [](const Space& s) { return aquarius::sum(s.nalpha)+aquarius::sum(s.nbeta) == 0; };
+
+    for (bool done = false;!done;)
+    {
+        bool ok = true;
+        for (int s = 0;s < nspaces;s++)
+        {
+            leaf_out[2*s  ] = active_out[s];
+            leaf_out[2*s+1] = nout[s]-active_out[s];
+            leaf_in [2*s  ] = active_in[s];
+            leaf_in [2*s+1] = nin[s]-active_in[s];
+        }
+
+        /*
+         * Blocks with an index in an empty subspace have no elements at all
+         */
+        for (int s = 0;s < 2*nspaces;s++)
+        {
+            if ((leaf_out[s] > 0 || leaf_in[s] > 0) && empty(leaf_spaces[s])) ok = false;
+        }
+
+        if (ok)
+        {
+            cases.push_back(ActiveCase());
+            cases.back().tensor = new SpinorbitalTensor<T>(name, arena, group, leaf_spaces, leaf_out, leaf_in);
+            cases.back().active_out = active_out;
+            cases.back().active_in = active_in;
+            addTensor(cases.back().tensor);
+        }
+
+        done = true;
+        for (int s = 0;s < 2*nspaces;s++)
+        {
+            vector<int>& act = (s < nspaces ? active_out : active_in);
+            const vector<int>& max = (s < nspaces ? nout : nin);
+            const vector<int>& min = (s < nspaces ? minout : minin);
+            int i = s%nspaces;
+
+            if (++act[i] <= max[i])
+            {
+                done = false;
+                break;
+            }
+            act[i] = min[i];
+        }
+    }
+
+    register_scalar();
+}
+
+template<class T>
+ActiveSpaceTensor<T>::~ActiveSpaceTensor()
+{
+    unregister_scalar();
+}
+
+template<class T>
+vector<Space> ActiveSpaceTensor<T>::subspaces() const
+{
+    vector<Space> spaces;
+    for (int s = 0;s < parts.size();s++)
+    {
+        spaces.push_back(parts[s]->active);
+        spaces.push_back(parts[s]->inactive);
+    }
+    return spaces;
+}
+
+template<class T>
+bool ActiveSpaceTensor<T>::exists(const vector<int>& active_out,
+                                  const vector<int>& active_in) const
+{
+    for (typename vector<ActiveCase>::const_iterator ac = cases.begin();ac != cases.end();++ac)
+    {
+        if (ac->active_out == active_out &&
+            ac->active_in  == active_in) return true;
+    }
+
+    return false;
+}
+
+template<class T>
+SpinorbitalTensor<T>& ActiveSpaceTensor<T>::operator()(const vector<int>& active_out,
+                                                       const vector<int>& active_in)
+{
+    return const_cast<SpinorbitalTensor<T>&>(const_cast<const ActiveSpaceTensor<T>&>(*this)(active_out, active_in));
+}
+
+template<class T>
+const SpinorbitalTensor<T>& ActiveSpaceTensor<T>::operator()(const vector<int>& active_out,
+                                                             const vector<int>& active_in) const
+{
+    for (typename vector<ActiveCase>::const_iterator ac = cases.begin();ac != cases.end();++ac)
+    {
+        if (ac->active_out == active_out &&
+            ac->active_in  == active_in) return *(ac->tensor);
+    }
+
+    throw logic_error("active case not found");
+}
+
+template<class T>
+void ActiveSpaceTensor<T>::slice(const SpinorbitalTensor<T>& A)
+{
+    int nspaces = parts.size();
+
+    assert(A.getNumOut() == nout);
+    assert(A.getNumIn() == nin);
+
+    vector<const SymmetryBlockedTensor<T>*> Pa(2*nspaces), Pb(2*nspaces);
+    vector<int> which(2*nspaces);
+
+    for (int s = 0;s < nspaces;s++)
+    {
+        Pa[2*s  ] = parts[s]->selection( true,  true);
+        Pb[2*s  ] = parts[s]->selection( true, false);
+        Pa[2*s+1] = parts[s]->selection(false,  true);
+        Pb[2*s+1] = parts[s]->selection(false, false);
+        which[2*s  ] = s;
+        which[2*s+1] = s;
+    }
+
+    for (typename vector<ActiveCase>::iterator ac = cases.begin();ac != cases.end();++ac)
+    {
+        ac->tensor->slice(A, Pa, Pb, which);
+    }
+}
+
+template<class T>
+void ActiveSpaceTensor<T>::mult(const T alpha, bool conja, const ActiveSpaceTensor<T>& A, const string& idx_A,
+                                               bool conjb, const ActiveSpaceTensor<T>& B, const string& idx_B,
+                                const T beta_,                                            const string& idx_C)
+{
+    assert(group == A.group);
+    assert(group == B.group);
+    assert(idx_A.size() == A.ndim);
+    assert(idx_B.size() == B.ndim);
+    assert(idx_C.size() == this->ndim);
+    assert(parts == A.parts || this->ndim == 0 || A.ndim == 0);
+    assert(parts == B.parts || this->ndim == 0 || B.ndim == 0);
+
+    vector<T> beta(cases.size(), beta_);
+
+    for (int ac = 0;ac < cases.size();ac++)
+    {
+        ActiveCase& acC = cases[ac];
+
+        /*
+         * Expand over active ("alpha") and inactive ("beta") lines exactly
+         * as SpinorbitalTensor does over the spins
+         */
+        Diagram d = expandMult(A.nout, A.nin, idx_A,
+                               B.nout, B.nin, idx_B,
+                                 nout,   nin, idx_C, acC.active_out, acC.active_in);
+
+        for (vector<Term>::const_iterator t = d.getTerms().begin();t != d.getTerms().end();++t)
+        {
+            double diagFactor = t->getFactor();
+
+            vector<Fragment>::const_iterator fA, fB, fC;
+            for (vector<Fragment>::const_iterator f = t->getFragments().begin();f != t->getFragments().end();++f)
+            {
+                if (f->getOp() == "A") fA = f;
+                if (f->getOp() == "B") fB = f;
+                if (f->getOp() == "C") fC = f;
+            }
+
+            vector<Line> out_A = fA->getIndicesOut();
+            vector<Line>  in_A = fA->getIndicesIn();
+            vector<Line> out_B = fB->getIndicesOut();
+            vector<Line>  in_B = fB->getIndicesIn();
+            vector<Line> out_C = fC->getIndicesOut();
+            vector<Line>  in_C = fC->getIndicesIn();
+
+            vector<int> active_out_A(A.nout.size(), 0);
+            vector<int> active_in_A(A.nin.size(), 0);
+            vector<int> active_out_B(B.nout.size(), 0);
+            vector<int> active_in_B(B.nin.size(), 0);
+
+            for (vector<Line>::iterator i = out_A.begin();i != out_A.end();++i)
+                if (i->isAlpha()) active_out_A[i->getType()]++;
+            for (vector<Line>::iterator i =  in_A.begin();i !=  in_A.end();++i)
+                if (i->isAlpha()) active_in_A[i->getType()]++;
+            for (vector<Line>::iterator i = out_B.begin();i != out_B.end();++i)
+                if (i->isAlpha()) active_out_B[i->getType()]++;
+            for (vector<Line>::iterator i =  in_B.begin();i !=  in_B.end();++i)
+                if (i->isAlpha()) active_in_B[i->getType()]++;
+
+            /*
+             * Blocks which are not stored are zero
+             */
+            if (!A.exists(active_out_A, active_in_A) ||
+                !B.exists(active_out_B, active_in_B)) continue;
+
+            vector<int> cidx_A(A.ndim);
+            {
+                int i = 0;
+                for (int j = 0;j < out_A.size();j++,i++)
+                    cidx_A[i] = out_A[j].asInt();
+                for (int j = 0;j < in_A.size();j++,i++)
+                    cidx_A[i] = in_A[j].asInt();
+            }
+
+            vector<int> cidx_B(B.ndim);
+            {
+                int i = 0;
+                for (int j = 0;j < out_B.size();j++,i++)
+                    cidx_B[i] = out_B[j].asInt();
+                for (int j = 0;j < in_B.size();j++,i++)
+                    cidx_B[i] = in_B[j].asInt();
+            }
+
+            vector<int> cidx_C(this->ndim);
+            {
+                int i = 0;
+                for (int j = 0;j < out_C.size();j++,i++)
+                    cidx_C[i] = out_C[j].asInt();
+                for (int j = 0;j < in_C.size();j++,i++)
+                    cidx_C[i] = in_C[j].asInt();
+            }
+
+            string idx_A_, idx_B_, idx_C_;
+            conv_idx(cidx_A, idx_A_,
+                     cidx_B, idx_B_,
+                     cidx_C, idx_C_);
+
+            acC.tensor->mult(alpha*diagFactor, conja, A(active_out_A, active_in_A), idx_A_,
+                                               conjb, B(active_out_B, active_in_B), idx_B_,
+                                      beta[ac],                                     idx_C_);
+
+            beta[ac] = 1.0;
+        }
+
+        /*
+         * Blocks of C which get no contribution are only scaled
+         */
+        if (beta[ac] != (T)1) acC.tensor->scale(beta[ac]);
+    }
+}
+
+template<class T>
+void ActiveSpaceTensor<T>::sum(const T alpha, bool conja, const ActiveSpaceTensor<T>& A, const string& idx_A,
+                               const T beta_,                                            const string& idx_B)
+{
+    assert(group == A.group);
+    assert(idx_A.size() == A.ndim);
+    assert(idx_B.size() == this->ndim);
+    assert(parts == A.parts || this->ndim == 0 || A.ndim == 0);
+
+    vector<T> beta(cases.size(), beta_);
+
+    for (int ac = 0;ac < cases.size();ac++)
+    {
+        ActiveCase& acB = cases[ac];
+
+        Diagram d = expandSum(A.nout, A.nin, idx_A,
+                                nout,   nin, idx_B, acB.active_out, acB.active_in);
+
+        for (vector<Term>::const_iterator t = d.getTerms().begin();t != d.getTerms().end();++t)
+        {
+            double diagFactor = t->getFactor();
+
+            vector<Fragment>::const_iterator fA, fB;
+            for (vector<Fragment>::const_iterator f = t->getFragments().begin();f != t->getFragments().end();++f)
+            {
+                if (f->getOp() == "A") fA = f;
+                if (f->getOp() == "B") fB = f;
+            }
+
+            vector<Line> out_A = fA->getIndicesOut();
+            vector<Line>  in_A = fA->getIndicesIn();
+            vector<Line> out_B = fB->getIndicesOut();
+            vector<Line>  in_B = fB->getIndicesIn();
+
+            vector<int> active_out_A(A.nout.size(), 0);
+            vector<int> active_in_A(A.nin.size(), 0);
+
+            for (vector<Line>::iterator i = out_A.begin();i != out_A.end();++i)
+                if (i->isAlpha()) active_out_A[i->getType()]++;
+            for (vector<Line>::iterator i =  in_A.begin();i !=  in_A.end();++i)
+                if (i->isAlpha()) active_in_A[i->getType()]++;
+
+            if (!A.exists(active_out_A, active_in_A)) continue;
+
+            vector<int> cidx_A(A.ndim);
+            {
+                int i = 0;
+                for (int j = 0;j < out_A.size();j++,i++)
+                    cidx_A[i] = out_A[j].asInt();
+                for (int j = 0;j < in_A.size();j++,i++)
+                    cidx_A[i] = in_A[j].asInt();
+            }
+
+            vector<int> cidx_B(this->ndim);
+            {
+                int i = 0;
+                for (int j = 0;j < out_B.size();j++,i++)
+                    cidx_B[i] = out_B[j].asInt();
+                for (int j = 0;j < in_B.size();j++,i++)
+                    cidx_B[i] = in_B[j].asInt();
+            }
+
+            string idx_A_, idx_B_;
+            conv_idx(cidx_A, idx_A_,
+                     cidx_B, idx_B_);
+
+            acB.tensor->sum(alpha*diagFactor, conja, A(active_out_A, active_in_A), idx_A_,
+                                    beta[ac],                                     idx_B_);
+
+            beta[ac] = 1.0;
+        }
+
+        if (beta[ac] != (T)1) acB.tensor->scale(beta[ac]);
+    }
+}
+
+template<class T>
+void ActiveSpaceTensor<T>::scale(const T alpha, const string& idx_A)
+{
+    for (typename vector<ActiveCase>::const_iterator ac = cases.begin();ac != cases.end();++ac)
+    {
+        ac->tensor->scale(alpha);
+    }
+}
+
+template<class T>
+void ActiveSpaceTensor<T>::weight(const vector<const vector<vector<T>>*>& da,
+                                  const vector<const vector<vector<T>>*>& db,
+                                  double shift)
+{
+    int nspaces = parts.size();
+
+    assert(da.size() == nspaces);
+    assert(db.size() == nspaces);
+
+    vector<vector<vector<T>>> sub_a(2*nspaces), sub_b(2*nspaces);
+    vector<const vector<vector<T>>*> da_(2*nspaces), db_(2*nspaces);
+
+    for (int s = 0;s < nspaces;s++)
+    {
+        sub_a[2*s  ] = parts[s]->select(*da[s],  true,  true);
+        sub_b[2*s  ] = parts[s]->select(*db[s],  true, false);
+        sub_a[2*s+1] = parts[s]->select(*da[s], false,  true);
+        sub_b[2*s+1] = parts[s]->select(*db[s], false, false);
+    }
+
+    for (int s = 0;s < 2*nspaces;s++)
+    {
+        da_[s] = &sub_a[s];
+        db_[s] = &sub_b[s];
+    }
+
+    for (typename vector<ActiveCase>::iterator ac = cases.begin();ac != cases.end();++ac)
+    {
+        ac->tensor->weight(da_, db_, shift);
+    }
+}
+
+template<class T>
+T ActiveSpaceTensor<T>::dot(bool conja, const ActiveSpaceTensor<T>& A, const string& idx_A,
+                            bool conjb,                                const string& idx_B) const
+{
+    ActiveSpaceTensor<T>& asdt = scalar();
+    asdt.mult(1, conja,     A, idx_A,
+                 conjb, *this, idx_B,
+              0,                  "");
+    vector<T> vals;
+    asdt(0)(0)(0).getAllData(vals);
+    assert(vals.size() == 1);
+    return vals[0];
+}
+
+template<class T>
+void ActiveSpaceTensor<T>::localDots(T alpha, bool conja, const vector<const ActiveSpaceTensor<T>*>& A,
+                                     bool conjb, vector<T>& vals) const
+{
+    vector<const SpinorbitalTensor<T>*> A_(A.size());
+
+    for (int i = 0;i < cases.size();i++)
+    {
+        /*
+         * Each block holds one of the binom(n,k) ways to place the k
+         * active indices among the n like indices of each space
+         */
+        T factor = (T)1;
+        for (int s = 0;s < parts.size();s++)
+        {
+            factor *= (T)binom(nout[s], cases[i].active_out[s]);
+            factor *= (T)binom( nin[s],  cases[i].active_in[s]);
+        }
+
+        for (int k = 0;k < A.size();k++) A_[k] = &(*A[k])(i);
+
+        cases[i].tensor->localDots(alpha*factor, conja, A_, conjb, vals);
+    }
+}
+
+template<class T>
+real_type_t<T> ActiveSpaceTensor<T>::norm(int p) const
+{
+    real_type_t<T> nrm = 0;
+
+    for (typename vector<ActiveCase>::const_iterator ac = cases.begin();ac != cases.end();++ac)
+    {
+        double factor = 1;
+        for (int s = 0;s < parts.size();s++)
+        {
+            factor *= binom(nout[s], ac->active_out[s]);
+            factor *= binom( nin[s],  ac->active_in[s]);
+        }
+
+        real_type_t<T> subnrm = ac->tensor->norm(p);
+
+        if (p == 2)
+        {
+            nrm += factor*subnrm*subnrm;
+        }
+        else if (p == 0)
+        {
+            nrm = max(nrm,subnrm);
+        }
+        else if (p == 1)
+        {
+            nrm += factor*subnrm;
+        }
+    }
+
+    if (p == 2) nrm = sqrt(nrm);
+
+    return nrm;
+}
+
+template <typename T>
+void ActiveSpaceTensor<T>::register_scalar()
+{
+    if (scalars.find(&arena.ctf<T>()) == scalars.end() ||
+        scalars[&arena.ctf<T>()].find(&group) == scalars[&arena.ctf<T>()].end())
+    {
+        /*
+         * As in SpinorbitalTensor, the entry must be made FIRST, since the
+         * new scalar will call this constructor too.
+         */
+        scalars[&arena.ctf<T>()][&group].first = -1;
+        scalars[&arena.ctf<T>()][&group].second = new ActiveSpaceTensor<T>("scalar", *this, (T)0);
+    }
+
+    scalars[&arena.ctf<T>()][&group].first++;
+}
+
+template <typename T>
+void ActiveSpaceTensor<T>::unregister_scalar()
+{
+    if (scalars.find(&arena.ctf<T>()) == scalars.end() ||
+        scalars[&arena.ctf<T>()].find(&group) == scalars[&arena.ctf<T>()].end()) return;
+
+    if (--scalars[&arena.ctf<T>()][&group].first == 0)
+    {
+        ActiveSpaceTensor<T>* scalar = scalars[&arena.ctf<T>()][&group].second;
+        scalars[&arena.ctf<T>()].erase(&group);
+        if (scalars[&arena.ctf<T>()].empty()) scalars.erase(&arena.ctf<T>());
+        delete scalar;
+    }
+}
+
+template <typename T>
+ActiveSpaceTensor<T>& ActiveSpaceTensor<T>::scalar() const
+{
+    return *scalars[&arena.ctf<T>()][&group].second;
+}
+
+INSTANTIATE_SPECIALIZATIONS(SpacePartition);
+INSTANTIATE_SPECIALIZATIONS(ActiveSpaceTensor);
+
+}
+}
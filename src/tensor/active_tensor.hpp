@@ -0,0 +1,158 @@
+#ifndef _AQUARIUS_TENSOR_ACTIVE_TENSOR_HPP_
+#define _AQUARIUS_TENSOR_ACTIVE_TENSOR_HPP_
+
+#include "util/global.hpp"
+
+#include "autocc/autocc.hpp"
+#include "operator/space.hpp"
+#include "task/task.hpp"
+
+#include "spinorbital_tensor.hpp"
+#include "composite_tensor.hpp"
+
+namespace aquarius
+{
+namespace tensor
+{
+
+/*
+ * A split of the orbitals of one space into an active and an inactive
+ * subspace, with the selection matrices (full x subspace) that pick out
+ * the orbitals of each
+ */
+template<class T>
+class SpacePartition : public Distributed
+{
+    public:
+        const op::Space full;
+        const op::Space active;
+        const op::Space inactive;
+
+        /*
+         * acta and actb flag the active alpha and beta orbitals of each irrep
+         */
+        SpacePartition(const Arena& arena, const op::Space& full,
+                       const vector<vector<bool>>& acta,
+                       const vector<vector<bool>>& actb);
+
+        /*
+         * The selection matrix of the active or inactive alpha or beta
+         * orbitals, or NULL if there are none
+         */
+        const SymmetryBlockedTensor<T>* selection(bool isactive, bool alpha) const;
+
+        /*
+         * The elements of d, which runs over all alpha or beta orbitals of
+         * each irrep, that belong to the active or inactive subspace
+         */
+        vector<vector<T>> select(const vector<vector<T>>& d, bool isactive, bool alpha) const;
+
+    protected:
+        vector<vector<int>> orbitals[2][2];
+        unique_ptr<SymmetryBlockedTensor<T>> P[2][2];
+};
+
+/*
+ * A spin-orbital tensor over spaces which are each split into an active and
+ * an inactive part. Each combination of the number of active indices of
+ * each space is a separate SpinorbitalTensor over the subspaces (active and
+ * inactive part of the first space, then of the second, ...), and only the
+ * combinations with at least minout[s] active upper and minin[s] active
+ * lower indices of space s are stored. The other blocks are zero and are
+ * skipped in every contraction.
+ */
+template<class T>
+class ActiveSpaceTensor : public IndexableCompositeTensor<ActiveSpaceTensor<T>,SpinorbitalTensor<T>,T>,
+                          public Distributed
+{
+    INHERIT_FROM_INDEXABLE_COMPOSITE_TENSOR(ActiveSpaceTensor<T>,SpinorbitalTensor<T>,T)
+
+    public:
+        ActiveSpaceTensor(const string& name, const ActiveSpaceTensor<T>& t, const T val);
+
+        ActiveSpaceTensor(const ActiveSpaceTensor<T>& other);
+
+        ActiveSpaceTensor(const string& name, const ActiveSpaceTensor<T>& other);
+
+        ActiveSpaceTensor(const string& name, const Arena& arena,
+                          const symmetry::PointGroup& group,
+                          const vector<const SpacePartition<T>*>& parts,
+                          const vector<int>& nout,
+                          const vector<int>& nin,
+                          const vector<int>& minout = vector<int>(),
+                          const vector<int>& minin = vector<int>());
+
+        ~ActiveSpaceTensor();
+
+        const vector<int>& getNumOut() const { return nout; }
+
+        const vector<int>& getNumIn() const { return nin; }
+
+        bool exists(const vector<int>& active_out,
+                    const vector<int>& active_in) const;
+
+        SpinorbitalTensor<T>& operator()(const vector<int>& active_out,
+                                         const vector<int>& active_in);
+
+        const SpinorbitalTensor<T>& operator()(const vector<int>& active_out,
+                                               const vector<int>& active_in) const;
+
+        /*
+         * Copy the stored blocks of A, which is over the full spaces
+         */
+        void slice(const SpinorbitalTensor<T>& A);
+
+        void mult(const T alpha, bool conja, const ActiveSpaceTensor<T>& A_, const string& idx_A,
+                                 bool conjb, const ActiveSpaceTensor<T>& B_, const string& idx_B,
+                  const T beta_,                                             const string& idx_C);
+
+        void sum(const T alpha, bool conja, const ActiveSpaceTensor<T>& A_, const string& idx_A,
+                 const T beta_,                                             const string& idx_B);
+
+        void scale(const T alpha, const string& idx_A);
+
+        /*
+         * da and db hold the alpha and beta denominators over all orbitals
+         * of each space
+         */
+        void weight(const vector<const vector<vector<T>>*>& da,
+                    const vector<const vector<vector<T>>*>& db,
+                    double shift = 0);
+
+        T dot(bool conja, const ActiveSpaceTensor<T>& A, const string& idx_A,
+              bool conjb,                                const string& idx_B) const;
+
+        void localDots(T alpha, bool conja, const vector<const ActiveSpaceTensor<T>*>& A, bool conjb,
+                       vector<T>& vals) const;
+
+        real_type_t<T> norm(int p) const;
+
+    protected:
+        struct ActiveCase
+        {
+            SpinorbitalTensor<T> *tensor;
+            vector<int> active_out, active_in;
+        };
+
+        const symmetry::PointGroup& group;
+        vector<const SpacePartition<T>*> parts;
+        vector<int> nout, nin;
+        vector<ActiveCase> cases;
+        static map<const tCTF_World<T>*,map<const symmetry::PointGroup*,pair<int,ActiveSpaceTensor<T>*>>> scalars;
+
+        /*
+         * The active and inactive subspaces of each space, in order
+         */
+        vector<op::Space> subspaces() const;
+
+        void register_scalar();
+
+        void unregister_scalar();
+
+        ActiveSpaceTensor<T>& scalar() const;
+};
+
+}
+}
+
+#endif
@@ -3,6 +3,8 @@
 
 #include "util/global.hpp"
 
+#include "task/checkpoint.hpp"
+
 #include "indexable_tensor.hpp"
 
 namespace aquarius
@@ -291,6 +293,124 @@ class CompositeTensor : public Tensor<Derived,T>
 
             return s;
         }
+
+        /**********************************************************************
+         *
+         * Multi-vector operations
+         *
+         *********************************************************************/
+
+        /*
+         * Form beta*this + sum_i alpha[i]*A[i], component by component, so
+         * that each constituent tensor of each A[i] is read only once
+         */
+        void lincomb(const vector<T>& alpha, const vector<const Derived*>& A, T beta = (T)0)
+        {
+            assert(alpha.size() == A.size());
+
+            vector<T> alpha_;
+            vector<const Base*> A_;
+
+            for (int i = 0;i < tensors.size();i++)
+            {
+                if (tensors[i] == NULL || tensors[i].ref != -1) continue;
+
+                alpha_.clear();
+                A_.clear();
+                for (int k = 0;k < A.size();k++)
+                {
+                    const CompositeTensor<Derived,Base,T>& Ak = *A[k];
+                    if (!Ak.exists(i)) continue;
+                    alpha_.push_back(alpha[k]);
+                    A_.push_back(&Ak(i));
+                }
+
+                tensors[i].tensor->lincomb(alpha_, A_, beta);
+            }
+        }
+
+        /*
+         * Add alpha times this rank's contribution to dot(conja, *A[i], conjb)
+         * into vals[i]; composites which define dot differently override this
+         */
+        void localDots(T alpha, bool conja, const vector<const Derived*>& A, bool conjb,
+                       vector<T>& vals) const
+        {
+            vector<const Base*> A_(A.size());
+
+            for (int i = 0;i < tensors.size();i++)
+            {
+                if (tensors[i] == NULL || tensors[i].ref != -1) continue;
+
+                for (int k = 0;k < A.size();k++)
+                {
+                    const CompositeTensor<Derived,Base,T>& Ak = *A[k];
+                    A_[k] = &Ak(i);
+                }
+
+                tensors[i].tensor->localDots(alpha, conja, A_, conjb, vals);
+            }
+        }
+
+        /*
+         * Copy A, which may have a different precision, into this tensor
+         * component by component
+         */
+        template <class Derived_, class Base_, class T_>
+        void convert(const CompositeTensor<Derived_,Base_,T_>& A)
+        {
+            assert(tensors.size() == A.getNumTensors());
+
+            for (int i = 0;i < tensors.size();i++)
+            {
+                if (tensors[i] != NULL && tensors[i].ref == -1 && A.exists(i))
+                {
+                    tensors[i].tensor->convert(A(i));
+                }
+            }
+        }
+
+        void write(task::Checkpoint& chk) const
+        {
+            for (int i = 0;i < tensors.size();i++)
+            {
+                if (tensors[i] != NULL && tensors[i].ref == -1)
+                {
+                    tensors[i].tensor->write(chk);
+                }
+            }
+        }
+
+        void read(task::Checkpoint& chk)
+        {
+            for (int i = 0;i < tensors.size();i++)
+            {
+                if (tensors[i] != NULL && tensors[i].ref == -1)
+                {
+                    tensors[i].tensor->read(chk);
+                }
+            }
+        }
+
+        /*
+         * Compute dot(conja, *A[i], conjb) for all i in one sweep over the
+         * data, with a single reduction at the end
+         */
+        vector<T> dots(bool conja, const vector<const Derived*>& A, bool conjb) const
+        {
+            vector<T> vals(A.size(), (T)0);
+
+            static_cast<const Derived&>(*this).localDots((T)1, conja, A, conjb, vals);
+
+            for (int i = 0;i < tensors.size();i++)
+            {
+                if (tensors[i] == NULL) continue;
+                tensors[i].tensor->arena.comm().Allreduce(vals.data(), vals.size(), MPI_SUM);
+                break;
+            }
+
+            return vals;
+        }
 };
 
 template <class Derived, class Base, class T>
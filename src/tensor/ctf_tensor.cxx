@@ -1,5 +1,7 @@
 #include "ctf_tensor.hpp"
 
+#include "util/memory.hpp"
+
 namespace aquarius
 {
 namespace tensor
@@ -83,6 +85,9 @@ CTFTensor<T>::CTFTensor(const string& name, CTFTensor<T>* A)
   len(A->len), sym(A->sym)
 {
     dt = A->dt;
+    nbytes = A->nbytes;
+    A->dt = NULL;
+    A->nbytes = 0;
     delete A;
     register_scalar();
 }
@@ -130,11 +135,17 @@ template <typename T>
 void CTFTensor<T>::allocate()
 {
     dt = new tCTF_Tensor<T>(ndim, len.data(), sym.data(), arena.ctf<T>(), this->name.c_str(), 1);
+
+    long_int size;
+    dt->get_raw_data(&size);
+    nbytes = size*sizeof(T);
+    Memory::allocate(nbytes);
 }
 
 template <typename T>
 void CTFTensor<T>::free()
 {
+    Memory::deallocate(nbytes);
     delete dt;
 }
 
@@ -215,6 +226,31 @@ const T* CTFTensor<T>::getRawData(int64_t& size) const
     return data;
 }
 
+template <typename T>
+bool CTFTensor<T>::alignTo(const CTFTensor<T>& A)
+{
+    long_int size_;
+    const T* before = dt->get_raw_data(&size_);
+    dt->align(*A.dt);
+    int moved = (dt->get_raw_data(&size_) != before);
+    arena.comm().Allreduce(&moved, 1, MPI_MAX);
+    return moved;
+}
+
+template <typename T>
+bool CTFTensor<T>::alignToAll(const vector<const CTFTensor<T>*>& A)
+{
+    if (A.empty()) return true;
+
+    alignTo(*A[0]);
+    for (int k = 1;k < A.size();k++)
+    {
+        if (alignTo(*A[k])) return false;
+    }
+
+    return true;
+}
+
 template <typename T>
 void CTFTensor<T>::slice(T alpha, bool conja, const CTFTensor<T>& A,
                           const vector<int>& start_A, T beta)
@@ -272,9 +308,6 @@ template <typename T>
 void CTFTensor<T>::div(T alpha, bool conja, const CTFTensor<T>& A,
                                  bool conjb, const CTFTensor<T>& B, T beta)
 {
-    const_cast<tCTF_Tensor<T>*>(A.dt)->align(*dt);
-    const_cast<tCTF_Tensor<T>*>(B.dt)->align(*dt);
-
 /*    int i;
     tCTF_fctr<T> fctr;
     if (conja){
@@ -304,8 +337,26 @@ void CTFTensor<T>::div(T alpha, bool conja, const CTFTensor<T>& A,
 */
 
     int64_t size, size_A, size_B;
+    const T* raw_data_A;
+    unique_ptr<tCTF_Tensor<T>> tmp_A;
+    alignTo(A);
+    if (alignTo(B))
+    {
+        /*
+         * A and B are mapped differently, so only here does A have to be
+         * copied into the distribution of B
+         */
+        tmp_A.reset(new tCTF_Tensor<T>(*A.dt));
+        tmp_A->align(*dt);
+        long_int size_;
+        raw_data_A = tmp_A->get_raw_data(&size_);
+        size_A = size_;
+    }
+    else
+    {
+        raw_data_A = A.getRawData(size_A);
+    }
     T* raw_data = getRawData(size);
-    const T* raw_data_A = A.getRawData(size_A);
     const T* raw_data_B = B.getRawData(size_B);
     assert(size == size_A);
     assert(size == size_B);
@@ -513,7 +564,222 @@ void CTFTensor<T>::weight(const vector<const vector<T>*>& d, double shift)
     writeRemoteData(pairs);
 }
 
+/*
+ * Chunk of local data worked on at once in the multi-vector kernels, chosen
+ * so that the output and one input chunk stay in cache
+ */
+static const int64_t LINCOMB_CHUNK = 4096;
+
+template <bool conja, bool conjb, typename T>
+T dot_func(const T* a, const T* b, int64_t n)
+{
+    T s = (T)0;
+    for (int64_t i = 0;i < n;i++)
+    {
+        s += (conja ? conj(a[i]) : a[i])*(conjb ? conj(b[i]) : b[i]);
+    }
+    return s;
+}
+
+template <typename T>
+void CTFTensor<T>::lincomb(const vector<T>& alpha, const vector<const CTFTensor<T>*>& A, T beta)
+{
+    assert(alpha.size() == A.size());
+
+    vector<T> alpha_A;
+    vector<const CTFTensor<T>*> A_;
+    for (int k = 0;k < A.size();k++)
+    {
+        /*
+         * A term which aliases the output just rescales it
+         */
+        if (A[k] == this)
+        {
+            beta += alpha[k];
+        }
+        else
+        {
+            alpha_A.push_back(alpha[k]);
+            A_.push_back(A[k]);
+        }
+    }
+
+    int64_t size, size_A;
+
+    if (!alignToAll(A_))
+    {
+        /*
+         * The terms are mapped differently, so follow each of them in turn
+         */
+        T* raw_data = getRawData(size);
+        if (beta == (T)0)
+        {
+            fill(raw_data, raw_data+size, (T)0);
+        }
+        else if (beta != (T)1)
+        {
+            for (int64_t i = 0;i < size;i++) raw_data[i] *= beta;
+        }
+
+        for (int k = 0;k < A_.size();k++)
+        {
+            alignTo(*A_[k]);
+            raw_data = getRawData(size);
+            const T* data_A = A_[k]->getRawData(size_A);
+            assert(size == size_A);
+            T a = alpha_A[k];
+            for (int64_t i = 0;i < size;i++) raw_data[i] += a*data_A[i];
+        }
+
+        return;
+    }
+
+    T* raw_data = getRawData(size);
+
+    vector<const T*> raw_data_A(A_.size());
+    for (int k = 0;k < A_.size();k++)
+    {
+        raw_data_A[k] = A_[k]->getRawData(size_A);
+        assert(size == size_A);
+    }
+
+    for (int64_t i0 = 0;i0 < size;i0 += LINCOMB_CHUNK)
+    {
+        int64_t i1 = min(size, i0+LINCOMB_CHUNK);
+
+        if (beta == (T)0)
+        {
+            fill(raw_data+i0, raw_data+i1, (T)0);
+        }
+        else if (beta != (T)1)
+        {
+            for (int64_t i = i0;i < i1;i++) raw_data[i] *= beta;
+        }
+
+        for (int k = 0;k < raw_data_A.size();k++)
+        {
+            T a = alpha_A[k];
+            const T* data_A = raw_data_A[k];
+            for (int64_t i = i0;i < i1;i++) raw_data[i] += a*data_A[i];
+        }
+    }
+}
+
+template <typename T>
+void CTFTensor<T>::localDots(T alpha, bool conja, const vector<const CTFTensor<T>*>& A, bool conjb,
+                             vector<T>& vals)
+{
+    assert(vals.size() == A.size());
+
+    bool packed = this->ndim > 0;
+    for (int i = 0;i < this->ndim;i++)
+    {
+        if (sym[i] == SY) packed = false;
+    }
+
+    /*
+     * Scalars may be replicated, and the diagonal of SY tensors does not
+     * carry the same weight as the rest, so use a regular contraction and
+     * count the (already reduced) result once
+     */
+    if (!packed)
+    {
+        for (int k = 0;k < A.size();k++)
+        {
+            T val = dot(conja, *A[k], A[k]->implicit(), conjb, this->implicit());
+            if (arena.rank == 0) vals[k] += alpha*val;
+        }
+        return;
+    }
+
+    /*
+     * If the operands are mapped differently, sweep over each of them
+     * separately, following it with this tensor
+     */
+    vector<vector<const CTFTensor<T>*>> groups;
+    if (alignToAll(A))
+    {
+        groups.push_back(A);
+    }
+    else
+    {
+        for (int k = 0;k < A.size();k++) groups.push_back({A[k]});
+    }
+
+    T factor = alpha*(T)getPackingFactor();
+    int k0 = 0;
+    for (auto& group : groups)
+    {
+        if (groups.size() > 1) alignTo(*group[0]);
+
+        int64_t size, size_A;
+        const T* raw_data = getRawData(size);
+
+        vector<const T*> raw_data_A(group.size());
+        for (int k = 0;k < group.size();k++)
+        {
+            raw_data_A[k] = group[k]->getRawData(size_A);
+            assert(size == size_A);
+        }
+
+        vector<T> s(group.size(), (T)0);
+        for (int64_t i0 = 0;i0 < size;i0 += LINCOMB_CHUNK)
+        {
+            int64_t n = min(size-i0, LINCOMB_CHUNK);
+
+            for (int k = 0;k < group.size();k++)
+            {
+                const T* a = raw_data_A[k]+i0;
+                const T* b = raw_data+i0;
+
+                if (conja)
+                {
+                    s[k] += (conjb ? dot_func<true,  true>(a, b, n) : dot_func<true,  false>(a, b, n));
+                }
+                else
+                {
+                    s[k] += (conjb ? dot_func<false, true>(a, b, n) : dot_func<false, false>(a, b, n));
+                }
+            }
+        }
+
+        for (int k = 0;k < group.size();k++) vals[k0+k] += factor*s[k];
+        k0 += group.size();
+    }
+}
+
+template <typename T>
+vector<T> CTFTensor<T>::dots(bool conja, const vector<const CTFTensor<T>*>& A, bool conjb)
+{
+    vector<T> vals(A.size(), (T)0);
+    localDots((T)1, conja, A, conjb, vals);
+    arena.comm().Allreduce(vals.data(), vals.size(), MPI_SUM);
+    return vals;
+}
+
+template <typename T>
+int CTFTensor<T>::getPackingFactor() const
+{
+    int f = 1;
+
+    for (int i = 0;i < this->ndim;)
+    {
+        int j;
+        for (j = i;j < this->ndim-1 && sym[j] != NS;j++);
+
+        if (sym[i] == AS || sym[i] == SH)
+        {
+            for (int n = 2;n <= j-i+1;n++) f *= n;
+        }
+
+        i = j+1;
+    }
+
+    return f;
+}
+
 INSTANTIATE_SPECIALIZATIONS(CTFTensor);
+INSTANTIATE_SINGLE_PRECISION(CTFTensor);
 
 }
 }
@@ -4,6 +4,7 @@
 #include "util/global.hpp"
 
 #include "task/task.hpp"
+#include "task/checkpoint.hpp"
 
 #include "indexable_tensor.hpp"
 
@@ -19,6 +20,7 @@ class CTFTensor : public IndexableTensor< CTFTensor<T>,T >, public Distributed
 
     protected:
         tCTF_Tensor<T>* dt;
+        int64_t nbytes;
         vector<int> len;
         vector<int> sym;
         static map<const tCTF_World<T>*,pair<int,CTFTensor<T>*>> scalars;
@@ -33,6 +35,19 @@ class CTFTensor : public IndexableTensor< CTFTensor<T>,T >, public Distributed
 
         CTFTensor<T>& scalar() const;
 
+        /*
+         * Redistribute this tensor to the mapping of A, and return whether
+         * any rank had to move data. CTF always redistributes into a fresh
+         * buffer, so the local data stays put only if the mappings matched.
+         */
+        bool alignTo(const CTFTensor<T>& A);
+
+        /*
+         * Align this tensor to each of A in turn, and return whether all of
+         * them (and thus this tensor) now share one mapping
+         */
+        bool alignToAll(const vector<const CTFTensor<T>*>& A);
+
         static void first_packed_indices(int ndim, const int* len, const int* sym, int* idx)
         {
             int i;
@@ -246,6 +261,55 @@ class CTFTensor : public IndexableTensor< CTFTensor<T>,T >, public Distributed
             dt->read(0, NULL);
         }
 
+        /*
+         * Overwrite this tensor with a copy of A converted to precision T;
+         * both tensors must have the same shape and symmetry
+         */
+        template <typename V>
+        void convert(const CTFTensor<V>& A)
+        {
+            assert(A.getLengths() == len && A.getSymmetry() == sym);
+
+            vector<tkv_pair<V>> from;
+            A.getLocalData(from);
+
+            vector<tkv_pair<T>> to;
+            to.reserve(from.size());
+            for (size_t i = 0;i < from.size();i++)
+            {
+                to.push_back(tkv_pair<T>(from[i].k, (T)from[i].d));
+            }
+
+            writeRemoteData(to);
+        }
+
+        /*
+         * Save the local part of this tensor as-is; the shape is written
+         * too so that read() can check that it matches
+         */
+        void write(task::Checkpoint& chk) const
+        {
+            chk.writeAll(len);
+            chk.writeAll(sym);
+
+            vector<tkv_pair<T>> pairs;
+            getLocalData(pairs);
+            chk.write(pairs);
+        }
+
+        void read(task::Checkpoint& chk)
+        {
+            vector<int> len_, sym_;
+            chk.readAll(len_);
+            chk.readAll(sym_);
+            if (len_ != len || sym_ != sym)
+                throw logic_error("Checkpointed tensor " + name + " has the wrong shape");
+
+            vector<tkv_pair<T>> pairs;
+            chk.read(pairs);
+            writeRemoteData(pairs);
+        }
+
         void slice(T alpha, bool conja, const CTFTensor<T>& A,
                    const vector<int>& start_A, T beta);
 
@@ -263,6 +327,34 @@ class CTFTensor : public IndexableTensor< CTFTensor<T>,T >, public Distributed
 
         void weight(const vector<const vector<T>*>& d, double shift = 0);
 
+        /*
+         * Form beta*this + sum_i alpha[i]*A[i] in a single pass over the
+         * local data, reading each A[i] only once. This tensor is
+         * redistributed to match the A[i]; they are never copied. If the
+         * A[i] do not share a mapping, one pass per term is made instead.
+         */
+        void lincomb(const vector<T>& alpha, const vector<const CTFTensor<T>*>& A, T beta = (T)0);
+
+        /*
+         * Add alpha times this rank's contribution to dot(conja, *A[i], conjb)
+         * into vals[i], without reducing over the arena. As in lincomb, this
+         * tensor (and never A[i]) is redistributed to match.
+         */
+        void localDots(T alpha, bool conja, const vector<const CTFTensor<T>*>& A, bool conjb,
+                       vector<T>& vals);
+
+        /*
+         * Compute dot(conja, *A[i], conjb) for all i with one sweep over the
+         * data and a single reduction
+         */
+        vector<T> dots(bool conja, const vector<const CTFTensor<T>*>& A, bool conjb);
+
+        /*
+         * Number of times each stored element is counted in a full contraction,
+         * i.e. the product of n! over each (anti)symmetric group of n indices
+         */
+        int getPackingFactor() const;
+
         void print(FILE* fp, double cutoff = -1.0) const;
 
         void compare(FILE* fp, const CTFTensor<T>& other, double cutoff = 0.0) const;
@@ -10,7 +10,7 @@ namespace aquarius
 namespace tensor
 {
 
-static int conv_idx(const vector<int>& cidx_A, string& iidx_A)
+int conv_idx(const vector<int>& cidx_A, string& iidx_A)
 {
     iidx_A.resize(cidx_A.size());
 
@@ -35,8 +35,8 @@ static int conv_idx(const vector<int>& cidx_A, string& iidx_A)
     return n;
 }
 
-static int conv_idx(const vector<int>& cidx_A, string& iidx_A,
-                    const vector<int>& cidx_B, string& iidx_B)
+int conv_idx(const vector<int>& cidx_A, string& iidx_A,
+             const vector<int>& cidx_B, string& iidx_B)
 {
     iidx_B.resize(cidx_B.size());
 
@@ -73,9 +73,9 @@ static int conv_idx(const vector<int>& cidx_A, string& iidx_A,
     return n;
 }
 
-static int conv_idx(const vector<int>& cidx_A, string& iidx_A,
-                    const vector<int>& cidx_B, string& iidx_B,
-                    const vector<int>& cidx_C, string& iidx_C)
+int conv_idx(const vector<int>& cidx_A, string& iidx_A,
+             const vector<int>& cidx_B, string& iidx_B,
+             const vector<int>& cidx_C, string& iidx_C)
 {
     iidx_C.resize(cidx_C.size());
 
@@ -470,231 +470,9 @@ void SpinorbitalTensor<T>::mult(const T alpha, bool conja, const SpinorbitalTens
     {
         SpinCase& scC = cases[sc];
 
-        int nouttot_C = aquarius::sum(nout);
-
-        string ext;
-        vector<Line> lines_C_out(aquarius::sum(nout));
-        vector<Line> lines_C_in(aquarius::sum(nin));
-        for (int i = 0, s = 0;s < spaces.size();s++)
-        {
-            for (int a = 0;a <         scC.alpha_out[s];a++,i++)
-            {
-                if (!contains(ext, idx_C[i])) ext += idx_C[i];
-                lines_C_out[i] = Line(idx_C[i], s, Line::VIRTUAL, Line::ALPHA);
-            }
-            for (int b = 0;b < nout[s]-scC.alpha_out[s];b++,i++)
-            {
-                if (!contains(ext, idx_C[i])) ext += idx_C[i];
-                lines_C_out[i] = Line(idx_C[i], s, Line::VIRTUAL, Line::BETA);
-            }
-        }
-        for (int i = 0,s = 0;s < spaces.size();s++)
-        {
-            for (int a = 0;a <        scC.alpha_in[s];a++,i++)
-            {
-                if (!contains(ext, idx_C[i+nouttot_C])) ext += idx_C[i+nouttot_C];
-                lines_C_in[i] = Line(idx_C[i+nouttot_C], s, Line::VIRTUAL, Line::ALPHA);
-            }
-            for (int b = 0;b < nin[s]-scC.alpha_in[s];b++,i++)
-            {
-                if (!contains(ext, idx_C[i+nouttot_C])) ext += idx_C[i+nouttot_C];
-                lines_C_in[i] = Line(idx_C[i+nouttot_C], s, Line::VIRTUAL, Line::BETA);
-            }
-        }
-
-        int nouttot_A = aquarius::sum(A.nout);
-
-        string sum;
-        vector<Line> lines_A_out(aquarius::sum(A.nout));
-        vector<Line> lines_A_in(aquarius::sum(A.nin));
-        vector<Line> lines_AandC_out, lines_AandC_in;
-        for (int i = 0, s = 0;s < A.spaces.size();s++)
-        {
-            for (int a = 0;a < A.nout[s];a++,i++)
-            {
-                if (contains(ext, idx_A[i]))
-                {
-                    int j;for (j = 0;idx_C[j] != idx_A[i];j++);
-                    if (j < nouttot_C)
-                    {
-                        lines_A_out[i] = lines_C_out[j];
-                        lines_AandC_out += lines_C_out[j];
-                    }
-                    else
-                    {
-                        lines_A_out[i] = lines_C_in[j-nouttot_C];
-                        lines_AandC_out += lines_C_in[j-nouttot_C];
-                    }
-                }
-                else
-                {
-                    if (!contains(sum, idx_A[i])) sum += idx_A[i];
-                    lines_A_out[i] = Line(idx_A[i], s, Line::VIRTUAL, Line::BETA);
-                }
-            }
-        }
-        for (int i = 0, s = 0;s < A.spaces.size();s++)
-        {
-            for (int a = 0;a < A.nin[s];a++,i++)
-            {
-                if (contains(ext, idx_A[i+nouttot_A]))
-                {
-                    int j; for (j = 0;idx_C[j] != idx_A[i+nouttot_A];j++);
-                    if (j < nouttot_C)
-                    {
-                        lines_A_in[i] = lines_C_out[j];
-                        lines_AandC_in += lines_C_out[j];
-                    }
-                    else
-                    {
-                        lines_A_in[i] = lines_C_in[j-nouttot_C];
-                        lines_AandC_in += lines_C_in[j-nouttot_C];
-                    }
-                }
-                else
-                {
-                    if (!contains(sum, idx_A[i+nouttot_A])) sum += idx_A[i+nouttot_A];
-                    lines_A_in[i] = Line(idx_A[i+nouttot_A], s, Line::VIRTUAL, Line::BETA);
-                }
-            }
-        }
-
-        int nouttot_B = aquarius::sum(B.nout);
-
-        vector<Line> lines_B_out(aquarius::sum(B.nout));
-        vector<Line> lines_B_in(aquarius::sum(B.nin));
-        vector<Line> lines_BandC_out, lines_BandC_in;
-        for (int i = 0, s = 0;s < B.spaces.size();s++)
-        {
-            for (int a = 0;a < B.nout[s];a++,i++)
-            {
-                if (contains(ext, idx_B[i]))
-                {
-                    int j; for (j = 0;idx_C[j] != idx_B[i];j++);
-                    if (j < nouttot_C)
-                    {
-                        lines_B_out[i] = lines_C_out[j];
-                        lines_BandC_out += lines_C_out[j];
-                    }
-                    else
-                    {
-                        lines_B_out[i] = lines_C_in[j-nouttot_C];
-                        lines_BandC_out += lines_C_in[j-nouttot_C];
-                    }
-                }
-                else
-                {
-                    if (!contains(sum, idx_B[i])) sum += idx_B[i];
-                    lines_B_out[i] = Line(idx_B[i], s, Line::VIRTUAL, Line::BETA);
-                }
-            }
-        }
-        for (int i = 0, s = 0;s < B.spaces.size();s++)
-        {
-            for (int a = 0;a < B.nin[s];a++,i++)
-            {
-                if (contains(ext, idx_B[i+nouttot_B]))
-                {
-                    int j; for (j = 0;idx_C[j] != idx_B[i+nouttot_B];j++);
-                    if (j < nouttot_C)
-                    {
-                        lines_B_in[i] = lines_C_out[j];
-                        lines_BandC_in += lines_C_out[j];
-                    }
-                    else
-                    {
-                        lines_B_in[i] = lines_C_in[j-nouttot_C];
-                        lines_BandC_in += lines_C_in[j-nouttot_C];
-                    }
-                }
-                else
-                {
-                    if (!contains(sum, idx_B[i+nouttot_B])) sum += idx_B[i+nouttot_B];
-                    lines_B_in[i] = Line(idx_B[i+nouttot_B], s, Line::VIRTUAL, Line::BETA);
-                }
-            }
-        }
-
-        vector<Line> lines_CnotAB_out = lines_C_out;
-        unique(lines_AandC_out);
-        unique(lines_BandC_out);
-        unique(lines_CnotAB_out);
-        exclude(lines_CnotAB_out, lines_AandC_out);
-        exclude(lines_CnotAB_out, lines_BandC_out);
-
-        vector<Line> lines_CnotAB_in = lines_C_in;
-        unique(lines_AandC_in);
-        unique(lines_BandC_in);
-        unique(lines_CnotAB_in);
-        exclude(lines_CnotAB_in, lines_AandC_in);
-        exclude(lines_CnotAB_in, lines_BandC_in);
-
-        Diagram d = Diagram(Diagram::SPINORBITAL,
-                            {Term(Diagram::SPINORBITAL)*
-                             Fragment("A", lines_A_out, lines_A_in)*
-                             Fragment("B", lines_B_out, lines_B_in)});
-
-        for (int s = 0;s < max(max(A.spaces.size(),B.spaces.size()),spaces.size());s++)
-        {
-            vector<vector<Line>> assym(3);
-
-            for (vector<Line>::iterator i = lines_AandC_out.begin();i != lines_AandC_out.end();++i)
-                if (i->getType() == s) assym[0].push_back(*i);
-            for (vector<Line>::iterator i = lines_BandC_out.begin();i != lines_BandC_out.end();++i)
-                if (i->getType() == s) assym[1].push_back(*i);
-            for (vector<Line>::iterator i = lines_CnotAB_out.begin();i != lines_CnotAB_out.end();++i)
-                if (i->getType() == s) assym[2].push_back(*i);
-
-            if (assym[2].empty()) assym.erase(assym.begin()+2);
-            if (assym[1].empty()) assym.erase(assym.begin()+1);
-            if (assym[0].empty()) assym.erase(assym.begin()+0);
-            if (!assym.empty()) d.antisymmetrize(assym);
-        }
-
-        for (int s = 0;s < max(max(A.spaces.size(),B.spaces.size()),spaces.size());s++)
-        {
-            vector<vector<Line>> assym(3);
-
-            for (vector<Line>::iterator i = lines_AandC_in.begin();i != lines_AandC_in.end();++i)
-                if (i->getType() == s) assym[0].push_back(*i);
-            for (vector<Line>::iterator i = lines_BandC_in.begin();i != lines_BandC_in.end();++i)
-                if (i->getType() == s) assym[1].push_back(*i);
-            for (vector<Line>::iterator i = lines_CnotAB_in.begin();i != lines_CnotAB_in.end();++i)
-                if (i->getType() == s) assym[2].push_back(*i);
-
-            if (assym[2].empty()) assym.erase(assym.begin()+2);
-            if (assym[1].empty()) assym.erase(assym.begin()+1);
-            if (assym[0].empty()) assym.erase(assym.begin()+0);
-            if (!assym.empty()) d.antisymmetrize(assym);
-        }
-
-        d.convert(Diagram::UHF);
-
-        /*
-         * Remove terms which are antisymmetrizations of same-spin groups
-         */
-        for (int s = 0;s < max(max(A.spaces.size(),B.spaces.size()),spaces.size());s++)
-        {
-            for (int spin = 0;spin < 2;spin++)
-            {
-                vector<Term> terms = d.getTerms();
-                for (vector<Term>::iterator t1 = terms.begin();t1 != terms.end();++t1)
-                {
-                    for (vector<Term>::iterator t2 = t1+1;t2 != terms.end();++t2)
-                    {
-                        if (Term(*t1).fixorder(filtered(t1->indices(), and1(isSpin(spin),isType(s)))) ==
-                            Term(*t2).fixorder(filtered(t2->indices(), and1(isSpin(spin),isType(s)))))
-                        {
-                            d -= *t1;
-                            break;
-                        }
-                    }
-                }
-            }
-        }
-
-        d *= Term(Diagram::UHF)*Fragment("C", lines_C_out, lines_C_in);
-        d.fixorder(true);
+        Diagram d = expandMult(A.nout, A.nin, idx_A,
+                               B.nout, B.nin, idx_B,
+                                 nout,   nin, idx_C, scC.alpha_out, scC.alpha_in);
 
         for (vector<Term>::const_iterator t = d.getTerms().begin();t != d.getTerms().end();++t)
         {
@@ -804,160 +582,8 @@ void SpinorbitalTensor<T>::sum(const T alpha, bool conja, const SpinorbitalTenso
     {
         SpinCase& scB = cases[sc];
 
-        int nouttot_B = aquarius::sum(this->nout);
-
-        string ext;
-        vector<Line> lines_B_out(aquarius::sum(nout));
-        vector<Line> lines_B_in(aquarius::sum(nin));
-        for (int i = 0, s = 0;s < spaces.size();s++)
-        {
-            for (int a = 0;a <         scB.alpha_out[s];a++,i++)
-            {
-                if (!contains(ext, idx_B[i])) ext += idx_B[i];
-                lines_B_out[i] = Line(idx_B[i], s, Line::VIRTUAL, Line::ALPHA);
-            }
-            for (int b = 0;b < nout[s]-scB.alpha_out[s];b++,i++)
-            {
-                if (!contains(ext, idx_B[i])) ext += idx_B[i];
-                lines_B_out[i] = Line(idx_B[i], s, Line::VIRTUAL, Line::BETA);
-            }
-        }
-        for (int i = 0,s = 0;s < spaces.size();s++)
-        {
-            for (int a = 0;a <        scB.alpha_in[s];a++,i++)
-            {
-                if (!contains(ext, idx_B[i+nouttot_B])) ext += idx_B[i+nouttot_B];
-                lines_B_in[i] = Line(idx_B[i+nouttot_B], s, Line::VIRTUAL, Line::ALPHA);
-            }
-            for (int b = 0;b < nin[s]-scB.alpha_in[s];b++,i++)
-            {
-                if (!contains(ext, idx_B[i+nouttot_B])) ext += idx_B[i+nouttot_B];
-                lines_B_in[i] = Line(idx_B[i+nouttot_B], s, Line::VIRTUAL, Line::BETA);
-            }
-        }
-
-        int nouttot_A = aquarius::sum(A.nout);
-
-        string sum;
-        vector<Line> lines_A_out(aquarius::sum(A.nout));
-        vector<Line> lines_A_in(aquarius::sum(A.nin));
-        vector<Line> lines_AandB_out, lines_AandB_in;
-        for (int i = 0, s = 0;s < A.spaces.size();s++)
-        {
-            for (int a = 0;a < A.nout[s];a++,i++)
-            {
-                if (contains(ext, idx_A[i]))
-                {
-                    int j; for (j = 0;idx_B[j] != idx_A[i];j++);
-                    if (j < nouttot_B)
-                    {
-                        lines_A_out[i] = lines_B_out[j];
-                        lines_AandB_out += lines_B_out[j];
-                    }
-                    else
-                    {
-                        lines_A_out[i] = lines_B_in[j-nouttot_B];
-                        lines_AandB_out += lines_B_in[j-nouttot_B];
-                    }
-                }
-                else
-                {
-                    if (!contains(sum, idx_A[i])) sum += idx_A[i];
-                    lines_A_out[i] = Line(idx_A[i], s, Line::VIRTUAL, Line::BETA);
-                }
-            }
-        }
-        for (int i = 0, s = 0;s < A.spaces.size();s++)
-        {
-            for (int a = 0;a < A.nin[s];a++,i++)
-            {
-                if (contains(ext, idx_A[i+nouttot_A]))
-                {
-                    int j; for (j = 0;idx_B[j] != idx_A[i+nouttot_A];j++);
-                    if (j < nouttot_B)
-                    {
-                        lines_A_in[i] = lines_B_out[j];
-                        lines_AandB_in += lines_B_out[j];
-                    }
-                    else
-                    {
-                        lines_A_in[i] = lines_B_in[j-nouttot_B];
-                        lines_AandB_in += lines_B_in[j-nouttot_B];
-                    }
-                }
-                else
-                {
-                    if (!contains(sum, idx_A[i+nouttot_A])) sum += idx_A[i+nouttot_A];
-                    lines_A_in[i] = Line(idx_A[i+nouttot_A], s, Line::VIRTUAL, Line::BETA);
-                }
-            }
-        }
-
-        vector<Line> lines_BnotA_out = lines_B_out;
-        unique(lines_AandB_out);
-        unique(lines_BnotA_out);
-        exclude(lines_BnotA_out, lines_AandB_out);
-
-        vector<Line> lines_BnotA_in = lines_B_in;
-        unique(lines_AandB_in);
-        unique(lines_BnotA_in);
-        exclude(lines_BnotA_in, lines_AandB_in);
-
-        Diagram d = Diagram(Diagram::SPINORBITAL,
-                            {Term(Diagram::SPINORBITAL)*
-                             Fragment("A", lines_A_out, lines_A_in)});
-
-        for (int s = 0;s < max(A.spaces.size(),spaces.size());s++)
-        {
-            vector<vector<Line>> assym(2);
-
-            for (vector<Line>::iterator i = lines_AandB_out.begin();i != lines_AandB_out.end();++i)
-                if (i->getType() == s) assym[0].push_back(*i);
-            for (vector<Line>::iterator i = lines_BnotA_out.begin();i != lines_BnotA_out.end();++i)
-                if (i->getType() == s) assym[1].push_back(*i);
-
-            if (!assym[0].empty() && !assym[1].empty()) d.antisymmetrize(assym);
-        }
-
-        for (int s = 0;s < max(A.spaces.size(),spaces.size());s++)
-        {
-            vector<vector<Line>> assym(2);
-
-            for (vector<Line>::iterator i = lines_AandB_in.begin();i != lines_AandB_in.end();++i)
-                if (i->getType() == s) assym[0].push_back(*i);
-            for (vector<Line>::iterator i = lines_BnotA_in.begin();i != lines_BnotA_in.end();++i)
-                if (i->getType() == s) assym[1].push_back(*i);
-
-            if (!assym[0].empty() && !assym[1].empty()) d.antisymmetrize(assym);
-        }
-
-        d.convert(Diagram::UHF);
-
-        /*
-         * Remove terms which are antisymmetrizations of same-spin groups
-         */
-        for (int s = 0;s < max(A.spaces.size(),spaces.size());s++)
-        {
-            for (int spin = 0;spin < 2;spin++)
-            {
-                vector<Term> terms = d.getTerms();
-                for (vector<Term>::iterator t1 = terms.begin();t1 != terms.end();++t1)
-                {
-                    for (vector<Term>::iterator t2 = t1+1;t2 != terms.end();++t2)
-                    {
-                        if (Term(*t1).fixorder(filtered(t1->indices(), and1(isSpin(spin),isType(s)))) ==
-                            Term(*t2).fixorder(filtered(t2->indices(), and1(isSpin(spin),isType(s)))))
-                        {
-                            d -= *t1;
-                            break;
-                        }
-                    }
-                }
-            }
-        }
-
-        d *= Term(Diagram::UHF)*Fragment("B", lines_B_out, lines_B_in);
-        d.fixorder(true);
+        Diagram d = expandSum(A.nout, A.nin, idx_A,
+                                nout,   nin, idx_B, scB.alpha_out, scB.alpha_in);
 
         for (vector<Term>::const_iterator t = d.getTerms().begin();t != d.getTerms().end();++t)
         {
@@ -1059,6 +685,132 @@ void SpinorbitalTensor<T>::weight(const vector<const vector<vector<T>>*>& da,
     }
 }
 
+template<class T>
+void SpinorbitalTensor<T>::slice(const SpinorbitalTensor<T>& A,
+                                 const vector<const SymmetryBlockedTensor<T>*>& Pa,
+                                 const vector<const SymmetryBlockedTensor<T>*>& Pb,
+                                 const vector<int>& which)
+{
+    assert(group == A.group);
+    assert(Pa.size() == spaces.size());
+    assert(Pb.size() == spaces.size());
+    assert(which.size() == spaces.size());
+
+    int nspaces_A = A.spaces.size();
+
+    for (typename vector<SpinCase>::iterator sc = cases.begin();sc != cases.end();++sc)
+    {
+        vector<int> alpha_out_A(nspaces_A, 0);
+        vector<int> alpha_in_A(nspaces_A, 0);
+
+        for (int j = 0;j < spaces.size();j++)
+        {
+            alpha_out_A[which[j]] += sc->alpha_out[j];
+            alpha_in_A[which[j]] += sc->alpha_in[j];
+        }
+
+        const SymmetryBlockedTensor<T>& tensor_A = A(alpha_out_A, alpha_in_A);
+
+        /*
+         * The indices of each spin case of A run over its spaces in order,
+         * alpha before beta, first the upper and then the lower indices, so
+         * hand out the dimensions of A from the start of each of these groups
+         */
+        vector<int> next_alpha(2*nspaces_A), next_beta(2*nspaces_A);
+        for (int s = 0, i = 0;s < nspaces_A;s++)
+        {
+            next_alpha[s] = i;
+            i += alpha_out_A[s];
+            next_beta[s] = i;
+            i += A.nout[s]-alpha_out_A[s];
+        }
+        for (int s = 0, i = aquarius::sum(A.nout);s < nspaces_A;s++)
+        {
+            next_alpha[nspaces_A+s] = i;
+            i += alpha_in_A[s];
+            next_beta[nspaces_A+s] = i;
+            i += A.nin[s]-alpha_in_A[s];
+        }
+
+        vector<const SymmetryBlockedTensor<T>*> P(A.ndim);
+        string idx(this->ndim, ' ');
+        bool empty = false;
+
+        for (int j = 0, i = 0;j < spaces.size();j++)
+        {
+            for (int a = 0;a <         sc->alpha_out[j];a++,i++)
+            {
+                int k = next_alpha[which[j]]++;
+                P[k] = Pa[j];
+                idx[i] = (char)('A'+k);
+            }
+            for (int b = 0;b < nout[j]-sc->alpha_out[j];b++,i++)
+            {
+                int k = next_beta[which[j]]++;
+                P[k] = Pb[j];
+                idx[i] = (char)('A'+k);
+            }
+        }
+        for (int j = 0, i = aquarius::sum(nout);j < spaces.size();j++)
+        {
+            for (int a = 0;a <        sc->alpha_in[j];a++,i++)
+            {
+                int k = next_alpha[nspaces_A+which[j]]++;
+                P[k] = Pa[j];
+                idx[i] = (char)('A'+k);
+            }
+            for (int b = 0;b < nin[j]-sc->alpha_in[j];b++,i++)
+            {
+                int k = next_beta[nspaces_A+which[j]]++;
+                P[k] = Pb[j];
+                idx[i] = (char)('A'+k);
+            }
+        }
+
+        for (int k = 0;k < A.ndim;k++) if (!P[k]) empty = true;
+        if (empty) continue;
+
+        /*
+         * Select one index at a time through non-symmetric intermediates
+         */
+        string idx_A(A.ndim, ' ');
+        for (int k = 0;k < A.ndim;k++) idx_A[k] = (char)('a'+k);
+        vector<vector<int>> len = tensor_A.getLengths();
+
+        unique_ptr<SymmetryBlockedTensor<T>> tmp;
+        const SymmetryBlockedTensor<T>* src = &tensor_A;
+
+        for (int k = 0;k < A.ndim;k++)
+        {
+            string next = idx_A;
+            next[k] = (char)('A'+k);
+            len[k] = P[k]->getLengths()[1];
+
+            auto dst = new SymmetryBlockedTensor<T>("tmp", arena, group, A.ndim, len,
+                                                    vector<int>(A.ndim, NS));
+            (*dst)[next] = (*src)[idx_A]*(*P[k])[string{idx_A[k], next[k]}];
+
+            tmp.reset(dst);
+            src = tmp.get();
+            idx_A = next;
+        }
+
+        /*
+         * Writing into the antisymmetric indices of this tensor antisymmetrizes
+         * the already antisymmetric block again, so divide by the number of terms
+         */
+        double factor = 1;
+        const vector<int>& sym = sc->tensor->getSymmetry();
+        for (int i = 0, nas = 1;i < this->ndim;i++)
+        {
+            if (sym[i] == AS) factor /= ++nas;
+            else nas = 1;
+        }
+
+        (*sc->tensor)[idx] = factor*(*src)[idx_A];
+    }
+}
+
 template<class T>
 T SpinorbitalTensor<T>::dot(bool conja, const SpinorbitalTensor<T>& A, const string& idx_A,
                             bool conjb,                                const string& idx_B) const
@@ -1073,6 +825,25 @@ T SpinorbitalTensor<T>::dot(bool conja, const SpinorbitalTensor<T>& A, const str
     return vals[0];
 }
 
+template<class T>
+void SpinorbitalTensor<T>::localDots(T alpha, bool conja, const vector<const SpinorbitalTensor<T>*>& A,
+                                     bool conjb, vector<T>& vals) const
+{
+    /*
+     * Each spin case stores every unique element once, while the full
+     * contraction visits it once per permutation within each group of
+     * like upper and lower indices
+     */
+    T factor = (T)1;
+    for (int s = 0;s < spaces.size();s++)
+    {
+        factor *= (T)factorial(nout[s]);
+        factor *= (T)factorial( nin[s]);
+    }
+
+    IndexableCompositeTensor<SpinorbitalTensor<T>,SymmetryBlockedTensor<T>,T>::localDots(alpha*factor, conja, A, conjb, vals);
+}
+
 template<class T>
 real_type_t<T> SpinorbitalTensor<T>::norm(int p) const
 {
@@ -1158,6 +929,7 @@ SpinorbitalTensor<T>& SpinorbitalTensor<T>::scalar() const
 }
 
 INSTANTIATE_SPECIALIZATIONS(SpinorbitalTensor);
+INSTANTIATE_SINGLE_PRECISION(SpinorbitalTensor);
 
 }
 }
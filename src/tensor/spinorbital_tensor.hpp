@@ -15,6 +15,19 @@ namespace aquarius
 namespace tensor
 {
 
+/*
+ * Turn the line numbers of an expanded diagram into index strings, where
+ * lines shared between the tensors get the same letter
+ */
+int conv_idx(const vector<int>& cidx_A, string& iidx_A);
+
+int conv_idx(const vector<int>& cidx_A, string& iidx_A,
+             const vector<int>& cidx_B, string& iidx_B);
+
+int conv_idx(const vector<int>& cidx_A, string& iidx_A,
+             const vector<int>& cidx_B, string& iidx_B,
+             const vector<int>& cidx_C, string& iidx_C);
+
 template<class T>
 class SpinorbitalTensor : public IndexableCompositeTensor<SpinorbitalTensor<T>,SymmetryBlockedTensor<T>,T>,
                           public Distributed
@@ -70,9 +83,24 @@ class SpinorbitalTensor : public IndexableCompositeTensor<SpinorbitalTensor<T>,S
                     const vector<const vector<vector<T>>*>& db,
                     double shift = 0);
 
+        /*
+         * Copy the part of A where each index lies in a subspace of the
+         * corresponding space of A: space j of this tensor is the subset of
+         * space which[j] of A picked out by the selection matrices (full x
+         * subset) Pa[j] and Pb[j] of the alpha and beta orbitals. A NULL
+         * selection matrix marks an empty subset.
+         */
+        void slice(const SpinorbitalTensor<T>& A,
+                   const vector<const SymmetryBlockedTensor<T>*>& Pa,
+                   const vector<const SymmetryBlockedTensor<T>*>& Pb,
+                   const vector<int>& which);
+
         T dot(bool conja, const SpinorbitalTensor<T>& A, const string& idx_A,
               bool conjb,                                const string& idx_B) const;
 
+        void localDots(T alpha, bool conja, const vector<const SpinorbitalTensor<T>*>& A, bool conjb,
+                       vector<T>& vals) const;
+
         real_type_t<T> norm(int p) const;
 
     protected:
@@ -1276,6 +1276,33 @@ T SymmetryBlockedTensor<T>::dot(bool conja, const SymmetryBlockedTensor<T>& A, c
     return vals[0];
 }
 
+template <class T>
+void SymmetryBlockedTensor<T>::localDots(T alpha, bool conja, const vector<const SymmetryBlockedTensor<T>*>& A,
+                                         bool conjb, vector<T>& vals) const
+{
+    vector<const CTFTensor<T>*> A_(A.size());
+
+    for (int i = 0;i < tensors.size();i++)
+    {
+        if (tensors[i] == NULL || !tensors[i].isAlloced) continue;
+
+        for (int k = 0;k < A.size();k++)
+        {
+            assert(group == A[k]->group);
+            assert(A[k]->tensors[i] != NULL && A[k]->tensors[i].isAlloced);
+            A_[k] = A[k]->tensors[i].tensor;
+        }
+
+        /*
+         * Only canonically-ordered blocks are stored and dot() counts each of
+         * their unique elements once (see overcounting_factor), so undo the
+         * permutational factor included by the block-level dot product
+         */
+        tensors[i].tensor->localDots(alpha/(T)tensors[i].tensor->getPackingFactor(),
+                                     conja, A_, conjb, vals);
+    }
+}
+
 template <class T>
 void SymmetryBlockedTensor<T>::weight(const vector<const vector<vector<T>>*>& d,
                                       double shift)
@@ -1446,6 +1473,7 @@ SymmetryBlockedTensor<T>& SymmetryBlockedTensor<T>::scalar() const
 }
 
 INSTANTIATE_SPECIALIZATIONS(SymmetryBlockedTensor);
+INSTANTIATE_SINGLE_PRECISION(SymmetryBlockedTensor);
 
 }
 }
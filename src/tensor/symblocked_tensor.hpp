@@ -166,6 +166,9 @@ class SymmetryBlockedTensor : public IndexableCompositeTensor<SymmetryBlockedTen
         virtual T dot(bool conja, const SymmetryBlockedTensor<T>& A, const string& idx_A,
                       bool conjb,                                    const string& idx_B) const;
 
+        void localDots(T alpha, bool conja, const vector<const SymmetryBlockedTensor<T>*>& A, bool conjb,
+                       vector<T>& vals) const;
+
         void weight(const vector<const vector<vector<T>>*>& d,
                     double shift = 0);
 
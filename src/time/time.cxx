@@ -2,7 +2,16 @@
 #include <mach/mach_time.h>
 #endif
 
+#ifdef TRACE
+#include <thread>
+#endif
+
+#if defined(TRACE) || defined(PROFILE)
+#include <mutex>
+#endif
+
 #include "task/task.hpp"
+#include "util/memory.hpp"
 
 #include "time.hpp"
 
@@ -27,6 +36,9 @@ namespace time
 
 static vector<Interval> *tics[128];
 
+Interval::Interval(double start, int64_t flops)
+: dt(start), flops(flops), bytes(Memory::current()) {}
+
 #ifdef AQ_USE_MPI_WTIME
 #include "mpi.h"
 Interval Interval::time()
@@ -87,6 +99,7 @@ Interval& Interval::operator+=(const Interval& other)
 {
     dt += other.dt;
     flops += other.flops;
+    bytes += other.bytes;
     return *this;
 }
 
@@ -94,6 +107,7 @@ Interval& Interval::operator-=(const Interval& other)
 {
     dt -= other.dt;
     flops -= other.flops;
+    bytes -= other.bytes;
     return *this;
 }
 
@@ -204,6 +218,505 @@ void Timer::clearTimers(const Arena& arena)
     }
 }
 
+#ifdef PROFILE
+
+namespace
+{
+
+struct ProfileNode
+{
+    const Profiler::Section* section;
+    double dt;
+    int64_t count;
+    int64_t flops;
+    vector<ProfileNode*> children;
+
+    ProfileNode(const Profiler::Section* section)
+    : section(section), dt(0), count(0), flops(0) {}
+};
+
+struct ProfileFrame
+{
+    ProfileNode* node;
+    double start;
+    int64_t flops;
+};
+
+struct ProfileThread
+{
+    ProfileNode root;
+    vector<ProfileFrame> stack;
+    int64_t flops;
+
+    ProfileThread() : root(NULL), flops(0) {}
+};
+
+/*
+ * Each thread gets its own call tree the first time it starts a section,
+ * however many threads there are; the trees are owned by profile_threads so
+ * that they survive until print() even if their thread exits
+ */
+vector<unique_ptr<ProfileThread>> profile_threads;
+thread_local ProfileThread* profile_thread = NULL;
+std::mutex profile_mutex;
+CTF_Flop_Counter profile_ctfflops;
+
+inline ProfileThread& profileThread(int& tid)
+{
+    #ifdef _OPENMP
+    tid = omp_get_thread_num();
+    #else
+    tid = 0;
+    #endif
+    if (profile_thread == NULL)
+    {
+        std::lock_guard<std::mutex> lock(profile_mutex);
+        profile_threads.emplace_back(new ProfileThread());
+        profile_thread = profile_threads.back().get();
+    }
+    return *profile_thread;
+}
+
+/*
+ * CTF only counts flops done by the master thread
+ */
+inline int64_t profileFlops(ProfileThread& thread, int tid)
+{
+    return thread.flops + (tid == 0 ? profile_ctfflops.count() : 0);
+}
+
+struct ProfileStats
+{
+    double incl;
+    double excl;
+    int64_t count;
+    int64_t flops;
+
+    ProfileStats() : incl(0), excl(0), count(0), flops(0) {}
+};
+
+void profileCollect(const ProfileNode& node, const string& path, map<string,ProfileStats>& stats)
+{
+    for (const ProfileNode* child : node.children)
+    {
+        string cpath = (path.empty() ? "" : path + "/") + child->section->name;
+
+        ProfileStats& s = stats[cpath];
+        s.incl += child->dt;
+        s.excl += child->dt;
+        s.count += child->count;
+        s.flops += child->flops;
+
+        for (const ProfileNode* grandchild : child->children)
+        {
+            s.excl -= grandchild->dt;
+        }
+
+        profileCollect(*child, cpath, stats);
+    }
+}
+
+}
+
+Profiler::Section& Profiler::section(const string& name)
+{
+    return *new Section(name);
+}
+
+void Profiler::start(Section& section)
+{
+    int tid;
+    ProfileThread& thread = profileThread(tid);
+
+    ProfileNode* parent = (thread.stack.empty() ? &thread.root : thread.stack.back().node);
+
+    ProfileNode* node = NULL;
+    for (ProfileNode* child : parent->children)
+    {
+        if (child->section == &section)
+        {
+            node = child;
+            break;
+        }
+    }
+
+    if (node == NULL)
+    {
+        node = new ProfileNode(&section);
+        parent->children.push_back(node);
+    }
+
+    thread.stack.push_back({node, Interval::time().seconds(), profileFlops(thread, tid)});
+}
+
+void Profiler::stop(Section& section)
+{
+    int tid;
+    ProfileThread& thread = profileThread(tid);
+
+    assert(!thread.stack.empty() && thread.stack.back().node->section == &section);
+
+    ProfileFrame& frame = thread.stack.back();
+    Interval dt(Interval::time().seconds()-frame.start, profileFlops(thread, tid)-frame.flops);
+    frame.node->dt += dt.dt;
+    frame.node->flops += dt.flops;
+    frame.node->count++;
+
+    TRACE_EVENT(section.name, dt);
+
+    thread.stack.pop_back();
+}
+
+void Profiler::flops(int64_t flops)
+{
+    int tid;
+    profileThread(tid).flops += flops;
+}
+
+void Profiler::print(const Arena& arena)
+{
+    const auto& comm = arena.comm();
+
+    map<string,ProfileStats> stats;
+    for (auto& thread : profile_threads)
+    {
+        profileCollect(thread->root, "", stats);
+    }
+
+    /*
+     * Different ranks may have seen different call paths, so first form
+     * the union of all paths on rank 0
+     */
+    string mypaths;
+    for (auto& s : stats) mypaths += s.first + '\n';
+
+    int mylen = mypaths.size();
+    vector<int> lens(arena.size), offs(arena.size+1, 0);
+    vector<char> allpaths;
+    if (arena.rank == 0)
+    {
+        comm.Gather(&mylen, lens.data(), 1);
+        for (int i = 0;i < arena.size;i++) offs[i+1] = offs[i]+lens[i];
+
+        allpaths.resize(offs[arena.size]);
+        comm.Gatherv(mypaths.data(), mylen, allpaths.data(), lens.data(), offs.data());
+    }
+    else
+    {
+        comm.Gather(&mylen, 1, 0);
+        comm.Gatherv(mypaths.data(), mylen, 0);
+    }
+
+    set<string> union_paths;
+    if (arena.rank == 0)
+    {
+        istringstream iss(string(allpaths.begin(), allpaths.end()));
+        string path;
+        while (getline(iss, path)) union_paths.insert(path);
+    }
+
+    string paths;
+    for (auto& path : union_paths) paths += path + '\n';
+
+    int len = paths.size();
+    comm.Bcast(&len, 1, 0);
+    paths.resize(len);
+    comm.Bcast(&paths[0], len, 0);
+
+    vector<string> names;
+    {
+        istringstream iss(paths);
+        string path;
+        while (getline(iss, path)) names.push_back(path);
+    }
+
+    int n = names.size();
+    vector<double> incl(n), excl(n);
+    vector<int64_t> count(n), flops(n);
+    for (int i = 0;i < n;i++)
+    {
+        auto it = stats.find(names[i]);
+        if (it == stats.end()) continue;
+        incl[i] = it->second.incl;
+        excl[i] = it->second.excl;
+        count[i] = it->second.count;
+        flops[i] = it->second.flops;
+    }
+
+    vector<double> incl_min(incl), incl_max(incl), incl_sum(incl), excl_sum(excl), excl_max(excl);
+    if (arena.rank == 0)
+    {
+        comm.Reduce(incl_min.data(), n, MPI_MIN);
+        comm.Reduce(incl_max.data(), n, MPI_MAX);
+        comm.Reduce(incl_sum.data(), n, MPI_SUM);
+        comm.Reduce(excl_sum.data(), n, MPI_SUM);
+        comm.Reduce(excl_max.data(), n, MPI_MAX);
+    }
+    else
+    {
+        comm.Reduce(incl_min.data(), n, MPI_MIN, 0);
+        comm.Reduce(incl_max.data(), n, MPI_MAX, 0);
+        comm.Reduce(incl_sum.data(), n, MPI_SUM, 0);
+        comm.Reduce(excl_sum.data(), n, MPI_SUM, 0);
+        comm.Reduce(excl_max.data(), n, MPI_MAX, 0);
+    }
+    comm.Allreduce(count.data(), n, MPI_SUM);
+    comm.Allreduce(flops.data(), n, MPI_SUM);
+
+    if (arena.rank != 0) return;
+
+    int max_len = 0;
+    for (int i = 0;i < n;i++)
+    {
+        size_t sep = names[i].find_last_of('/');
+        int depth = std::count(names[i].begin(), names[i].end(), '/');
+        int width = 2*depth + names[i].size() - (sep == string::npos ? 0 : sep+1);
+        max_len = max(max_len, width);
+    }
+
+    Logger::log(arena) << printos("%-*s %10s %12s %12s %12s %12s %12s %10s\n", max_len, "Section",
+                                  "calls", "incl min", "incl avg", "incl max", "excl avg", "excl max",
+                                  "gflops/s") << endl;
+
+    for (int i = 0;i < n;i++)
+    {
+        size_t sep = names[i].find_last_of('/');
+        int depth = std::count(names[i].begin(), names[i].end(), '/');
+        string label = string(2*depth, ' ') + names[i].substr(sep == string::npos ? 0 : sep+1);
+
+        double gflops = (incl_max[i] > 0 ? (double)flops[i]/1e9/incl_max[i] : 0);
+
+        Logger::log(arena) << printos("%-*s %10ld %12.6f %12.6f %12.6f %12.6f %12.6f %10.3f\n",
+                                      max_len, label.c_str(), (long)count[i], incl_min[i],
+                                      incl_sum[i]/arena.size, incl_max[i], excl_sum[i]/arena.size,
+                                      excl_max[i], gflops) << endl;
+    }
+}
+
+#endif
+
+#ifdef TRACE
+
+namespace
+{
+
+struct TraceEvent
+{
+    const string* name;
+    const string* task;
+    int tid;
+    double start;
+    double dt;
+    int64_t flops;
+    int64_t bytes;
+};
+
+/*
+ * Each thread records into its own buffer, so that timers stopped inside
+ * OpenMP regions never contend for a lock. Names are interned per thread so
+ * that events only hold a pointer; set nodes never move, so the writer
+ * thread can read them while new names are added. Buffers are owned by
+ * trace_buffers and live until the end of the run, even if their thread
+ * exits.
+ */
+struct TraceBuffer
+{
+    set<string> names;
+    vector<TraceEvent> events;
+    int64_t count = 0;
+};
+
+vector<unique_ptr<TraceBuffer>> trace_buffers;
+thread_local TraceBuffer* trace_buffer = NULL;
+
+set<string> trace_tasks;
+const string* trace_task = NULL;
+string trace_file;
+int trace_rank = -1;
+double trace_t0 = 0;
+double trace_cost = 0;
+std::thread trace_writer;
+std::mutex trace_mutex;
+
+const size_t trace_buffer_size = 1<<16;
+
+void traceWrite(vector<TraceEvent> events)
+{
+    ofstream ofs(str("%s.%d", trace_file.c_str(), trace_rank).c_str(), fstream::app);
+
+    for (const TraceEvent& e : events)
+    {
+        ofs << printos("{\"name\":%s,\"cat\":%s,\"ph\":\"X\","
+                       "\"ts\":%.3f,\"dur\":%.3f,\"pid\":%d,\"tid\":%d,"
+                       "\"args\":{\"task\":%s,\"flops\":%ld,\"bytes\":%ld}},\n",
+                       jsonString(*e.name).c_str(), jsonString(*e.task).c_str(),
+                       (e.start-trace_t0)*1e6, e.dt*1e6, trace_rank, e.tid,
+                       jsonString(*e.task).c_str(), (long)e.flops, (long)e.bytes);
+    }
+}
+
+/*
+ * Hand the given events to the writer thread. Only one write is in flight
+ * at a time, so the previous one is waited for first. Must be called with
+ * trace_mutex held.
+ */
+void traceFlush(vector<TraceEvent>& events)
+{
+    if (trace_writer.joinable()) trace_writer.join();
+
+    vector<TraceEvent> full;
+    full.swap(events);
+    events.reserve(trace_buffer_size);
+
+    trace_writer = std::thread(traceWrite, move(full));
+}
+
+}
+
+void Tracer::init(const Arena& arena, const string& file)
+{
+    trace_file = file;
+    trace_rank = arena.rank;
+    trace_task = &*trace_tasks.insert("").first;
+
+    std::remove(str("%s.%d", trace_file.c_str(), trace_rank).c_str());
+
+    /*
+     * Time the recording of a batch of events into a scratch buffer, so that
+     * the overhead of tracing can be reported at the end
+     */
+    {
+        const int n = 10000;
+        TraceBuffer scratch;
+        scratch.events.reserve(n);
+        double start = Interval::time().seconds();
+        for (int i = 0;i < n;i++)
+        {
+            double now = Interval::time().seconds();
+            scratch.events.push_back({&*scratch.names.insert("calibrate").first, trace_task,
+                                      0, now, 0.0, 0, 0});
+        }
+        trace_cost = (Interval::time().seconds()-start)/n;
+    }
+
+    /*
+     * Roughly align the clocks on different nodes
+     */
+    arena.comm().Barrier();
+    trace_t0 = Interval::time().seconds();
+}
+
+void Tracer::setTask(const string& task)
+{
+    if (trace_rank < 0) return;
+
+    /*
+     * Only called between tasks, outside of any parallel region
+     */
+    trace_task = &*trace_tasks.insert(task).first;
+}
+
+void Tracer::record(const string& name, const Interval& interval)
+{
+    if (trace_rank < 0) return;
+
+    double now = Interval::time().seconds();
+
+    #ifdef _OPENMP
+    int tid = omp_get_thread_num();
+    #else
+    int tid = 0;
+    #endif
+
+    /*
+     * The lock is only taken the first time a thread records an event and
+     * whenever its buffer fills up
+     */
+    if (!trace_buffer)
+    {
+        std::lock_guard<std::mutex> lock(trace_mutex);
+        trace_buffers.emplace_back(new TraceBuffer);
+        trace_buffer = trace_buffers.back().get();
+        trace_buffer->events.reserve(trace_buffer_size);
+    }
+
+    /*
+     * Unnamed timers (e.g. the one around each task in TaskDAG::execute)
+     * are labelled with the current task
+     */
+    const string* label = (name.empty() ? trace_task : &*trace_buffer->names.insert(name).first);
+
+    trace_buffer->events.push_back({label, trace_task, tid, now-interval.dt,
+                                    interval.dt, interval.flops, interval.bytes});
+    trace_buffer->count++;
+
+    if (trace_buffer->events.size() >= trace_buffer_size)
+    {
+        std::lock_guard<std::mutex> lock(trace_mutex);
+        traceFlush(trace_buffer->events);
+    }
+}
+
+void Tracer::finish(const Arena& arena)
+{
+    if (trace_rank < 0) return;
+
+    /*
+     * Merge the remaining events of all threads
+     */
+    {
+        std::lock_guard<std::mutex> lock(trace_mutex);
+
+        vector<TraceEvent> events;
+        for (auto& buffer : trace_buffers)
+        {
+            events.insert(events.end(), buffer->events.begin(), buffer->events.end());
+            buffer->events.clear();
+        }
+        sort(events.begin(), events.end(),
+             [](const TraceEvent& a, const TraceEvent& b) { return a.start < b.start; });
+
+        traceFlush(events);
+    }
+    trace_writer.join();
+
+    int64_t count = 0;
+    for (auto& buffer : trace_buffers) count += buffer->count;
+    arena.comm().Allreduce(&count, 1, MPI_MAX);
+
+    double elapsed = Interval::time().seconds()-trace_t0;
+    Logger::log(arena) << "Traced up to " << count << " events per process, " <<
+                          "estimated overhead " << fixed << setprecision(3) <<
+                          100*count*trace_cost/elapsed << "% of the run time" << endl;
+
+    arena.comm().Barrier();
+
+    if (arena.rank == 0)
+    {
+        ofstream ofs(trace_file.c_str());
+        ofs << "{\"traceEvents\":[\n";
+
+        for (int i = 0;i < arena.size;i++)
+        {
+            string file = str("%s.%d", trace_file.c_str(), i);
+            ifstream ifs(file.c_str());
+            if (ifs.peek() != ifstream::traits_type::eof()) ofs << ifs.rdbuf();
+            ifs.close();
+            std::remove(file.c_str());
+
+            ofs << printos("{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%d,"
+                           "\"args\":{\"name\":\"rank %d\"}}", i, i);
+            ofs << (i == arena.size-1 ? "\n" : ",\n");
+        }
+
+        ofs << "]}" << endl;
+    }
+
+    trace_rank = -1;
+}
+
+#endif
+
 void tic()
 {
     #ifdef _OPENMP
@@ -285,7 +798,11 @@ void do_flops(int64_t flops)
     #else
     int tid = 0;
     #endif
-    tics[tid]->back().flops -= flops;
+    if (tics[tid] != NULL && !tics[tid]->empty()) tics[tid]->back().flops -= flops;
+
+    #ifdef PROFILE
+    Profiler::flops(flops);
+    #endif
 }
 
 }
@@ -5,19 +5,25 @@
 
 #ifdef PROFILE
 
-#define PROFILE_SECTION(name) \
+/*
+ * Each call site gets its own static section handle, so entering a
+ * section does not involve any string lookups or locks
+ */
+#define PROFILE_NAMED_SECTION(name) \
 { \
-static time::Timer __timer = time::Timer::(name); \
-__timer.start();
+static time::Profiler::Section& __section = time::Profiler::section(name); \
+time::Profiler::start(__section);
 
-#define PROFILE_FUNCTION PROFILE_SECTION(__func__)
+#define PROFILE_SECTION(name) PROFILE_NAMED_SECTION(#name)
+
+#define PROFILE_FUNCTION PROFILE_NAMED_SECTION(__func__)
 
 #define PROFILE_STOP \
-__timer.stop(); \
+time::Profiler::stop(__section); \
 }
 
 #define PROFILE_RETURN \
-__timer.stop(); \
+time::Profiler::stop(__section); \
 return;
 
 #define PROFILE_FLOPS(n) time::do_flops(n)
@@ -26,6 +32,8 @@ return;
 
 #define PROFILE_FUNCTION
 
+#define PROFILE_NAMED_SECTION(name)
+
 #define PROFILE_SECTION(name)
 
 #define PROFILE_STOP
@@ -36,16 +44,36 @@ return;
 
 #endif
 
+/*
+ * Event tracing (see Tracer below) is only compiled in with -DTRACE
+ */
+#ifdef TRACE
+
+#define TRACE_TASK(name) time::Tracer::setTask(name)
+
+#define TRACE_EVENT(name,interval) time::Tracer::record(name, interval)
+
+#else
+
+#define TRACE_TASK(name)
+
+#define TRACE_EVENT(name,interval)
+
+#endif
+
 namespace aquarius
 {
 namespace time
 {
 
 class Timer;
+class Tracer;
 
 class Interval
 {
     friend class Timer;
+    friend class Tracer;
+    friend class Profiler;
     friend void do_flops(int64_t flops);
     friend Interval toc();
     friend Interval cputoc();
@@ -53,11 +81,16 @@ class Interval
     protected:
         double dt;
         int64_t flops;
+        /*
+         * Tensor memory in use (see Memory) for a point in time, or the net
+         * change over an interval
+         */
+        int64_t bytes;
 
-        Interval(double start, int64_t flops) : dt(start), flops(flops) {}
+        Interval(double start, int64_t flops);
 
     public:
-        Interval() : dt(0), flops(0) {}
+        Interval() : dt(0), flops(0), bytes(0) {}
 
         static Interval time();
 
@@ -124,20 +157,23 @@ class Timer : public Interval
 
         void stop()
         {
+            Interval dt = toc();
+            dt.flops += ctfflops.count();
+
+            TRACE_EVENT(name, dt);
+
             #ifdef _OPENMP
             if (!omp_in_parallel())
             {
-                *this += toc();//*omp_get_max_threads();
+                *this += dt;//*omp_get_max_threads();
                 count++;
-                flops += ctfflops.count();
             }
             else
             #pragma omp critical
             #endif
             {
-                *this += toc();
+                *this += dt;
                 count++;
-                flops += ctfflops.count();
             }
         }
 
@@ -146,6 +182,62 @@ class Timer : public Interval
         static void clearTimers(const Arena& arena);
 };
 
+#ifdef PROFILE
+
+/*
+ * Hierarchical profiler behind the PROFILE_* macros. Every thread keeps its
+ * own stack of open sections and its own call tree, so starting and
+ * stopping a section only touches thread-local data. print() merges the
+ * trees of all threads and ranks by call path and reports inclusive and
+ * exclusive times (min/avg/max over ranks), call counts and flops.
+ */
+class Profiler
+{
+    public:
+        struct Section
+        {
+            const string name;
+
+            Section(const string& name) : name(name) {}
+        };
+
+        static Section& section(const string& name);
+
+        static void start(Section& section);
+
+        static void stop(Section& section);
+
+        static void flops(int64_t flops);
+
+        static void print(const Arena& arena);
+};
+
+#endif
+
+#ifdef TRACE
+
+/*
+ * Records a begin/end event for every timer (and task) on each rank. Events
+ * are buffered in memory and written out to a per-rank file by a background
+ * thread whenever the buffer fills up. finish() merges the per-rank files
+ * into a single Chrome trace (JSON) file, which can be opened in
+ * chrome://tracing or Perfetto. Each event carries its flop count and the
+ * net change of the tensor memory in use on its process over the event.
+ */
+class Tracer
+{
+    public:
+        static void init(const Arena& arena, const string& file);
+
+        static void setTask(const string& task);
+
+        static void record(const string& name, const Interval& interval);
+
+        static void finish(const Arena& arena);
+};
+
+#endif
+
 }
 }
 
@@ -28,7 +28,9 @@ template <typename T> class SpinorbitalTensor;
 class Arena
 {
     protected:
-        //global_ptr<tCTF_World<float>> ctfs;
+#ifdef ENABLE_SINGLE_PRECISION
+        global_ptr<tCTF_World<float>> ctfs;
+#endif
         global_ptr<tCTF_World<double>> ctfd;
         //global_ptr<tCTF_World<complex<float>>> ctfc;
         //global_ptr<tCTF_World<complex<double>>> ctfz;
@@ -57,14 +59,14 @@ class Arena
         }
 };
 
-/*
+#ifdef ENABLE_SINGLE_PRECISION
 template <>
 inline tCTF_World<float>& Arena::ctf<float>()
 {
-    if (!ctfs) ctfs = new tCTF_World<float>(*comm_);
+    if (!ctfs) ctfs.set(new tCTF_World<float>(*comm_));
     return *ctfs;
 }
-*/
+#endif
 
 template <>
 inline tCTF_World<double>& Arena::ctf<double>()
@@ -3,6 +3,7 @@
 
 #include "time/time.hpp"
 #include "task/task.hpp"
+#include "task/checkpoint.hpp"
 
 #include "distributed.hpp"
 #include "tensor/ctf_tensor.hpp"
@@ -108,6 +109,17 @@ class Iterative : public task::Task
 
         virtual void iterate(const Arena& arena) = 0;
 
+        /*
+         * Subclasses which can be restarted return true from isRestartable
+         * and save (and restore) whatever they need to continue iterating,
+         * e.g. the amplitudes and the DIIS history
+         */
+        virtual bool isRestartable() const { return false; }
+
+        virtual void writeCheckpoint(task::Checkpoint& chk) {}
+
+        virtual void readCheckpoint(const Arena& arena, task::Checkpoint& chk) {}
+
     public:
         Iterative(const string& name, input::Config& config)
         : Task(name, config),
@@ -118,6 +130,29 @@ class Iterative : public task::Task
 
         virtual ~Iterative() {}
 
+        /*
+         * Read the header written by run() and return the type of the task
+         * which wrote the checkpoint; the task-specific data follows
+         */
+        static string readCheckpointHeader(task::Checkpoint& chk, int& iter,
+                                           vector<U>& energy, vector<double>& conv)
+        {
+            vector<char> type;
+            chk.readAll(type);
+            chk.readAll(iter);
+            chk.readAll(energy);
+            chk.readAll(conv);
+            return string(type.begin(), type.end());
+        }
+
+        static string readCheckpointHeader(task::Checkpoint& chk)
+        {
+            int iter;
+            vector<U> energy;
+            vector<double> conv;
+            return readCheckpointHeader(chk, iter, energy, conv);
+        }
+
         bool run(task::TaskDAG& dag, const Arena& arena)
         {
             return run(dag, arena, 1);
@@ -129,7 +164,24 @@ class Iterative : public task::Task
             energy_.resize(nsolution);
             conv_.assign(nsolution, numeric_limits<double>::max());
 
-            for (iter_ = 1;iter_ <= maxiter && !isConverged();iter_++)
+            string chkfile = (isRestartable() ? dag.getCheckpointFile(this->name) : "");
+
+            iter_ = 1;
+            if (!chkfile.empty() && task::Checkpoint::exists(arena, chkfile))
+            {
+                task::Checkpoint chk(arena, chkfile, task::Checkpoint::READ);
+                if (readCheckpointHeader(chk, iter_, energy_, conv_) != this->type)
+                    throw task::CheckpointError(chkfile, "written by a different type of task");
+                readCheckpoint(arena, chk);
+
+                log(arena) << "Restarting from iteration " << iter_ << endl;
+                iter_++;
+            }
+
+            int chk_iter = 0;
+            double chk_seconds = 0;
+
+            for (;iter_ <= maxiter && !isConverged();iter_++)
             {
                 time::Timer timer;
                 timer.start();
@@ -155,6 +207,23 @@ class Iterative : public task::Task
                                       ", convergence = " << scientific << setprecision(3) << conv_[i] << endl;
                     }
                 }
+
+                chk_iter++;
+                chk_seconds += dt;
+
+                if (!chkfile.empty() && (isConverged() || iter_ == maxiter ||
+                                         dag.isCheckpointDue(chk_iter, chk_seconds)))
+                {
+                    chk_iter = 0;
+                    chk_seconds = 0;
+
+                    task::Checkpoint chk(arena, chkfile, task::Checkpoint::WRITE);
+                    chk.writeAll(vector<char>(this->type.begin(), this->type.end()));
+                    chk.writeAll(iter_);
+                    chk.writeAll(energy_);
+                    chk.writeAll(conv_);
+                    writeCheckpoint(chk);
+                }
             }
 
             if (!isConverged())
@@ -0,0 +1,50 @@
+#include "memory.hpp"
+
+namespace aquarius
+{
+
+std::atomic<int64_t> Memory::current_(0);
+std::atomic<int64_t> Memory::peak_(0);
+
+void Memory::allocate(int64_t bytes)
+{
+    int64_t now = (current_ += bytes);
+    int64_t peak = peak_;
+    while (now > peak && !peak_.compare_exchange_weak(peak, now));
+}
+
+void Memory::deallocate(int64_t bytes)
+{
+    current_ -= bytes;
+}
+
+int64_t Memory::available(const Arena& arena)
+{
+    /*
+     * MemAvailable accounts for reclaimable page cache, which MemFree does not
+     */
+    int64_t bytes = numeric_limits<int64_t>::max();
+    ifstream ifs("/proc/meminfo");
+    string key;
+    int64_t kb;
+    while (ifs >> key >> kb)
+    {
+        if (key == "MemAvailable:")
+        {
+            bytes = kb*1024;
+            break;
+        }
+        ifs.ignore(numeric_limits<streamsize>::max(), '\n');
+    }
+
+    /*
+     * The ranks sharing this node also share its memory
+     */
+    Intracomm node = arena.comm().split_type(MPI_COMM_TYPE_SHARED, arena.rank);
+
+    if (bytes != numeric_limits<int64_t>::max()) bytes /= node.size;
+    arena.comm().Allreduce(&bytes, 1, MPI_MIN);
+    return bytes;
+}
+
+}
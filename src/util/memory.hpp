@@ -0,0 +1,45 @@
+#ifndef _AQUARIUS_UTIL_MEMORY_HPP_
+#define _AQUARIUS_UTIL_MEMORY_HPP_
+
+#include "util/global.hpp"
+
+#include <atomic>
+
+namespace aquarius
+{
+
+/*
+ * Accounting of the memory held by distributed tensors on this process.
+ *
+ * Tensors report their local storage when it is allocated and freed, which
+ * gives the number of bytes currently in use and the high-water mark since
+ * the last call to resetPeak.
+ */
+class Memory
+{
+    protected:
+        static std::atomic<int64_t> current_;
+        static std::atomic<int64_t> peak_;
+
+    public:
+        static void allocate(int64_t bytes);
+
+        static void deallocate(int64_t bytes);
+
+        static int64_t current() { return current_; }
+
+        static int64_t peak() { return peak_; }
+
+        static void resetPeak() { peak_ = current_.load(); }
+
+        /*
+         * Bytes of physical memory available to each process, i.e. the
+         * available memory of each node divided among the processes on it,
+         * minimized over all nodes
+         */
+        static int64_t available(const Arena& arena);
+};
+
+}
+
+#endif
@@ -49,6 +49,18 @@
 #define INSTANTIATE_SPECIALIZATIONS(name) \
 template class name<double>;
 
+/*
+ * Single-precision instantiations of the tensor layer, used for the
+ * mixed-precision iterations of CCSD. They are only built with
+ * --enable-single-precision, since they need a CTF with float support.
+ */
+#ifdef ENABLE_SINGLE_PRECISION
+#define INSTANTIATE_SINGLE_PRECISION(name) \
+template class name<float>;
+#else
+#define INSTANTIATE_SINGLE_PRECISION(name)
+#endif
+
 #define INSTANTIATE_SPECIALIZATIONS_2(name,extra1) \
 template class name<double,extra1>;
 
@@ -0,0 +1,92 @@
+#!/usr/bin/python
+
+#
+# Compare the JSON reports written by run.sh against stored baselines and
+# flag any task which became slower, achieved a lower flop rate, or used
+# more memory than allowed by the tolerance.
+#
+# Usage: compare.py [--tolerance <fraction>] [--update] <baselines> <results>
+#
+# With --update, the results are copied over the baselines instead. A
+# report without a baseline is an error, so that a missing or misplaced
+# baselines directory cannot make the comparison pass trivially.
+#
+
+from __future__ import print_function
+
+import sys
+import os
+import json
+import shutil
+import argparse
+
+parser = argparse.ArgumentParser()
+parser.add_argument('--tolerance', type=float, default=0.1,
+                    help='allowed relative change before a regression is flagged')
+parser.add_argument('--update', action='store_true',
+                    help='replace the baselines with the current results')
+parser.add_argument('baselines')
+parser.add_argument('results')
+args = parser.parse_args()
+
+reports = sorted(f for f in os.listdir(args.results) if f.endswith('.json'))
+
+if args.update:
+    if not os.path.isdir(args.baselines):
+        os.makedirs(args.baselines)
+    for f in reports:
+        shutil.copy(os.path.join(args.results, f), args.baselines)
+        print('Updated baseline', f)
+    sys.exit()
+
+def load(path):
+    with open(path) as f:
+        return json.load(f)
+
+def regressed(metric, old, new):
+    # Time and memory regress upwards, flop rate downwards
+    if old <= 0:
+        return False
+    if metric == 'gflops':
+        return new < old/(1+args.tolerance)
+    else:
+        return new > old*(1+args.tolerance)
+
+nregress = 0
+if not reports:
+    print('No reports found in %s' % args.results)
+    nregress += 1
+
+for f in reports:
+    path = os.path.join(args.baselines, f)
+    if not os.path.exists(path):
+        print('%s: no baseline (create one with --update)' % f)
+        nregress += 1
+        continue
+
+    old = load(path)
+    new = load(os.path.join(args.results, f))
+
+    if (old['processes'], old['threads']) != (new['processes'], new['threads']):
+        print('%s: baseline used %d processes x %d threads, results used %d x %d' %
+              (f, old['processes'], old['threads'], new['processes'], new['threads']))
+        nregress += 1
+        continue
+
+    oldtasks = dict((t['name'], t) for t in old['tasks'])
+    for task in new['tasks']:
+        if task['name'] not in oldtasks:
+            continue
+        base = oldtasks[task['name']]
+        for metric in ('seconds', 'gflops', 'peak_memory_increase_mb'):
+            if regressed(metric, base[metric], task[metric]):
+                print('%s: %s: %s %.3f -> %.3f' %
+                      (f, task['name'], metric, base[metric], task[metric]))
+                nregress += 1
+
+if nregress > 0:
+    print('%d regression%s or missing baseline%s found' %
+          (nregress, 's' if nregress > 1 else '', 's' if nregress > 1 else ''))
+    sys.exit(1)
+else:
+    print('No regressions found')
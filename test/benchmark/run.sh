@@ -0,0 +1,35 @@
+#!/bin/sh
+#
+# Run the benchmark inputs with a fixed number of processes and threads and
+# collect a JSON report for each one in $RESULTS.
+#
+# Usage: run.sh [<aquarius binary>]
+#
+# NPROCS, NTHREADS, MPIRUN, and RESULTS may be set in the environment.
+#
+
+SRCDIR=$(cd $(dirname $0) && pwd)
+AQUARIUS=${1:-$SRCDIR/../../bin/aquarius}
+NPROCS=${NPROCS:-4}
+NTHREADS=${NTHREADS:-1}
+MPIRUN=${MPIRUN:-mpirun -np}
+RESULTS=${RESULTS:-benchmark}
+
+mkdir -p $RESULTS || exit 1
+RESULTS=$(cd $RESULTS && pwd)
+
+export OMP_NUM_THREADS=$NTHREADS
+
+# Water clusters are generated with the existing input generator
+(cd $RESULTS && python2 $SRCDIR/../water_clusters/make_input.py w4 cc-pVDZ ccsd > /dev/null) || exit 1
+
+status=0
+for input in $SRCDIR/*.aq $RESULTS/w4_cc-pVDZ_ccsd.aq
+do
+    name=$(basename $input .aq)
+    echo "Running $name on $NPROCS processes with $NTHREADS threads each"
+    AQUARIUS_REPORT_FILE=$RESULTS/$name.json \
+        $MPIRUN $NPROCS $AQUARIUS $input > $RESULTS/$name.out 2>&1 || status=1
+done
+
+exit $status
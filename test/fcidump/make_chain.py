@@ -0,0 +1,167 @@
+#!/usr/bin/env python
+#
+# Write FCIDUMP files for a closed-shell model chain with a mirror plane, for
+# testing the choice of occupied orbitals when reading FCIDUMP files.
+#
+# The chain has NSITE sites with nearest-neighbour hopping, symmetric site
+# energies, and Ohno-like density-density interactions. RHF is solved in the
+# symmetry-adapted basis, so that each orbital is exactly even (A') or odd
+# (A'') under the mirror, and the same integrals are written twice:
+#
+#  chain_energy.fcidump: orbitals in order of energy, so the first NELEC/2
+#                        are the occupied ones
+#  chain_irrep.fcidump:  orbitals sorted by irrep and then by energy, as
+#                        written by MOLPRO or PySCF, so that the lowest
+#                        orbitals in the file are not the occupied ones
+#
+# The SCF and MP2 energies are printed for reference.
+#
+# Usage: make_chain.py
+#
+
+from __future__ import print_function
+
+import math
+
+NSITE = 8
+NELEC = 8
+HOP = -1.0
+SITE = [0.3, -0.2, 0.1, 0.0]
+U = 2.0
+
+n = NSITE
+no = NELEC//2
+
+def jacobi(a):
+    """Eigenvalues and eigenvectors (as columns) of a symmetric matrix."""
+    m = len(a)
+    a = [row[:] for row in a]
+    v = [[float(i == j) for j in range(m)] for i in range(m)]
+    for sweep in range(100):
+        off = sum(a[i][j]**2 for i in range(m) for j in range(m) if i != j)
+        if off < 1e-30:
+            break
+        for p in range(m):
+            for q in range(p+1, m):
+                if abs(a[p][q]) < 1e-18:
+                    continue
+                theta = (a[q][q]-a[p][p])/(2*a[p][q])
+                t = math.copysign(1.0, theta)/(abs(theta)+math.sqrt(theta**2+1))
+                c = 1/math.sqrt(t**2+1)
+                s = t*c
+                for k in range(m):
+                    akp, akq = a[k][p], a[k][q]
+                    a[k][p], a[k][q] = c*akp-s*akq, s*akp+c*akq
+                for k in range(m):
+                    apk, aqk = a[p][k], a[q][k]
+                    a[p][k], a[q][k] = c*apk-s*aqk, s*apk+c*aqk
+                for k in range(m):
+                    vkp, vkq = v[k][p], v[k][q]
+                    v[k][p], v[k][q] = c*vkp-s*vkq, s*vkp+c*vkq
+    return [a[i][i] for i in range(m)], v
+
+site = SITE+SITE[::-1]
+h = [[0.0]*n for i in range(n)]
+for i in range(n):
+    h[i][i] = site[i]
+    if i+1 < n:
+        h[i][i+1] = h[i+1][i] = HOP
+V = [[U/(1+abs(i-j)) for j in range(n)] for i in range(n)]
+
+# Symmetry-adapted basis: even and odd combinations of mirror-image sites
+half = n//2
+basis = []
+for parity in (1, -1):
+    for i in range(half):
+        b = [0.0]*n
+        b[i] = 1/math.sqrt(2)
+        b[n-1-i] = parity/math.sqrt(2)
+        basis.append(b)
+irrep_of_basis = [1]*half+[2]*half
+
+def solve(F):
+    """Orbital energies, coefficients, and irreps, sorted by energy."""
+    orbs = []
+    for irrep in (1, 2):
+        B = [b for b, s in zip(basis, irrep_of_basis) if s == irrep]
+        Fb = [[sum(x[p]*F[p][q]*y[q] for p in range(n) for q in range(n))
+               for y in B] for x in B]
+        e, c = jacobi(Fb)
+        for k in range(len(B)):
+            orbs.append((e[k], [sum(c[j][k]*B[j][p] for j in range(len(B)))
+                                for p in range(n)], irrep))
+    orbs.sort(key=lambda o: o[0])
+    return orbs
+
+def fock(D):
+    F = [[h[p][q]-0.5*V[p][q]*D[p][q] for q in range(n)] for p in range(n)]
+    for p in range(n):
+        F[p][p] += sum(V[p][j]*D[j][j] for j in range(n))
+    return F
+
+orbs = solve(h)
+E = 0.0
+for it in range(500):
+    D = [[2*sum(orbs[i][1][p]*orbs[i][1][q] for i in range(no))
+          for q in range(n)] for p in range(n)]
+    F = fock(D)
+    Enew = 0.5*sum(D[p][q]*(h[p][q]+F[p][q]) for p in range(n) for q in range(n))
+    orbs = solve(F)
+    if abs(Enew-E) < 1e-14 and it > 0:
+        break
+    E = Enew
+escf = Enew
+
+eps = [o[0] for o in orbs]
+C = [o[1] for o in orbs]
+sym = [o[2] for o in orbs]
+
+A = [[[C[p][i]*C[q][i] for i in range(n)] for q in range(n)] for p in range(n)]
+AV = [[[sum(A[p][q][i]*V[i][j] for i in range(n)) for j in range(n)]
+       for q in range(n)] for p in range(n)]
+
+def eri(p, q, r, s):
+    return sum(AV[p][q][j]*A[r][s][j] for j in range(n))
+
+def hmo(p, q):
+    return sum(C[p][i]*h[i][j]*C[q][j] for i in range(n) for j in range(n))
+
+emp2 = 0.0
+for i in range(no):
+    for j in range(no):
+        for a in range(no, n):
+            for b in range(no, n):
+                iajb = eri(i, a, j, b)
+                ibja = eri(i, b, j, a)
+                emp2 += iajb*(2*iajb-ibja)/(eps[i]+eps[j]-eps[a]-eps[b])
+
+def write(path, order):
+    pos = dict((p, k+1) for k, p in enumerate(order))
+    with open(path, 'w') as f:
+        f.write(' &FCI NORB=%d,NELEC=%d,MS2=0,\n' % (n, NELEC))
+        f.write('  ORBSYM=%s,\n' % ','.join(str(sym[p]) for p in order))
+        f.write('  ISYM=1,\n')
+        f.write(' &END\n')
+        for p in range(n):
+            for q in range(p+1):
+                for r in range(n):
+                    for s in range(r+1):
+                        if p*(p+1)//2+q < r*(r+1)//2+s:
+                            continue
+                        v = eri(p, q, r, s)
+                        if abs(v) > 1e-12:
+                            f.write('%23.16E %3d %3d %3d %3d\n' %
+                                    (v, pos[p], pos[q], pos[r], pos[s]))
+        for p in range(n):
+            for q in range(p+1):
+                v = hmo(p, q)
+                if abs(v) > 1e-12:
+                    f.write('%23.16E %3d %3d %3d %3d\n' % (v, pos[p], pos[q], 0, 0))
+        f.write('%23.16E %3d %3d %3d %3d\n' % (0.0, 0, 0, 0, 0))
+
+write('chain_energy.fcidump', list(range(n)))
+write('chain_irrep.fcidump', sorted(range(n), key=lambda p: (sym[p], p)))
+
+print('Occupied irreps:', sym[:no])
+print('E(SCF) = %.12f' % escf)
+print('E(MP2) = %.12f' % emp2)
@@ -0,0 +1,65 @@
+#!/bin/sh
+#
+# Stop a CCSD calculation after a few iterations, then restart it from the
+# checkpoint and check that it converges to the reference energy.
+#
+# The checkpoint files of the first run are keyed on the hash of a modified
+# input, so they are renamed to the (FNV-1a) hash of the unmodified input,
+# which is what the second run looks for.
+#
+# Usage: run.sh [<aquarius binary>]
+#
+# NPROCS, MPIRUN, and RESULTS may be set in the environment.
+#
+
+SRCDIR=$(cd $(dirname $0) && pwd)
+AQUARIUS=${1:-$SRCDIR/../../bin/aquarius}
+NPROCS=${NPROCS:-2}
+MPIRUN=${MPIRUN:-mpirun -np}
+RESULTS=${RESULTS:-restart}
+
+rm -rf $RESULTS && mkdir -p $RESULTS/chk || exit 1
+RESULTS=$(cd $RESULTS && pwd)
+
+INPUT=$RESULTS/h2o-pvdz.aq
+STOPPED=$RESULTS/h2o-pvdz-stopped.aq
+cp $SRCDIR/h2o-pvdz.aq $INPUT || exit 1
+sed 's/^ccsd,$/ccsd { max_iterations 5 },/' $INPUT > $STOPPED || exit 1
+
+fnv1a()
+{
+    python3 -c '
+import sys
+h = 0xcbf29ce484222325
+for c in open(sys.argv[1], "rb").read():
+    h = ((h ^ c)*0x100000001b3) & 0xffffffffffffffff
+print("%016x" % h)' $1
+}
+
+export AQUARIUS_CHECKPOINT_DIR=$RESULTS/chk
+export AQUARIUS_CHECKPOINT_INTERVAL=2
+
+$MPIRUN $NPROCS $AQUARIUS $STOPPED > $RESULTS/stopped.out 2>&1 || exit 1
+
+from=$(fnv1a $STOPPED)
+to=$(fnv1a $INPUT)
+for chk in $RESULTS/chk/$from.*.chk
+do
+    mv $chk $RESULTS/chk/$to.${chk#$RESULTS/chk/$from.} || exit 1
+done
+
+$MPIRUN $NPROCS $AQUARIUS $INPUT > $RESULTS/restarted.out 2>&1 || exit 1
+
+if ! grep -q "Restarting from iteration 5" $RESULTS/restarted.out
+then
+    echo "CCSD was not restarted from iteration 5"
+    exit 1
+fi
+
+if grep -q "failed" $RESULTS/restarted.out
+then
+    grep "failed" $RESULTS/restarted.out
+    exit 1
+fi
+
+echo "Restart test passed"